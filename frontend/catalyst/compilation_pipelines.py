@@ -835,6 +835,8 @@ def qjit(
     logfile=None,
     pipelines=None,
     abstracted_axes=None,
+    select_backend=True,
+    shot_batches=1,
 ):  # pylint: disable=too-many-arguments
     """A just-in-time decorator for PennyLane and JAX programs using Catalyst.
 
@@ -875,6 +877,13 @@ def qjit(
             Function arguments with ``abstracted_axes`` specified will be compiled to ranked tensors
             with dynamic shapes. For more details, please see the Dynamically-shaped Arrays section
             below.
+        select_backend (bool): If ``True`` (the default), the Lightning device of a QNode may be
+            replaced by the Lightning backend best suited to the number of qubits of its circuit,
+            e.g. ``lightning.kokkos`` for large circuits when it is installed. The requested
+            device remains the fallback when none of the selected backends is available.
+        shot_batches (int): Number of batches the shots of QNodes with mid-circuit measurements
+            are split in. The batches run concurrently, each on its own instance of the device
+            with its own random number stream, and their samples and counts are merged.
 
     Returns:
         QJIT object.
@@ -1068,6 +1077,8 @@ def qjit(
                 autograph,
                 async_qnodes,
                 abstracted_axes=axes,
+                select_backend=select_backend,
+                shot_batches=shot_batches,
             ),
         )
 
@@ -1083,6 +1094,8 @@ def qjit(
                 autograph,
                 async_qnodes,
                 abstracted_axes=axes,
+                select_backend=select_backend,
+                shot_batches=shot_batches,
             ),
         )
 
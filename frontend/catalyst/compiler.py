@@ -61,6 +61,17 @@ class CompileOptions:
         lower_to_llvm (Optional[bool]): flag indicating whether to attempt the LLVM lowering after
             the main compilation pipeline is complete. Default is ``True``.
         abstracted_axes (Optional[Any]): store the abstracted_axes value. Defaults to ``None``.
+        compilation_cache_dir (Optional[str]): directory in which the compiler driver caches
+            whole optimized modules, keyed by the structural hashes of their functions, the
+            versions of Catalyst and LLVM, and the target. Unchanged programs are then not lowered
+            and optimized again, while any change to a program compiles it in full. Default is
+            ``None`` (no caching).
+        select_backend (Optional[bool]): flag indicating whether the Lightning device of a QNode
+            may be replaced by the Lightning backend best suited to the number of qubits of its
+            circuit. Default is ``True``.
+        shot_batches (Optional[int]): number of batches the shots of QNodes with mid-circuit
+            measurements are split in. The batches run concurrently on distinct device instances.
+            Default is ``1`` (no splitting).
     """
 
     verbose: Optional[bool] = False
@@ -72,6 +83,9 @@ class CompileOptions:
     async_qnodes: Optional[bool] = False
     lower_to_llvm: Optional[bool] = True
     abstracted_axes: Optional[Union[Iterable[Iterable[str]], Dict[int, str]]] = None
+    compilation_cache_dir: Optional[str] = None
+    select_backend: Optional[bool] = True
+    shot_batches: Optional[int] = 1
 
     def __deepcopy__(self, memo):
         """Make a deep copy of all fields of a CompileOptions object except the logfile, which is
@@ -88,9 +102,19 @@ class CompileOptions:
         """Get effective pipelines"""
         if self.pipelines:
             return self.pipelines
-        elif self.async_qnodes:
-            return DEFAULT_ASYNC_PIPELINES
-        return DEFAULT_PIPELINES
+        # The shot batches run concurrently as asynchronous QNode calls
+        use_async = self.async_qnodes or self.shot_batches > 1
+        pipelines = DEFAULT_ASYNC_PIPELINES if use_async else DEFAULT_PIPELINES
+
+        def configure(passes):
+            if not self.select_backend:
+                passes = [p for p in passes if p != "select-backend"]
+            return [
+                f"split-shots{{num-batches={self.shot_batches}}}" if p == "split-shots" else p
+                for p in passes
+            ]
+
+        return [(name, configure(passes)) for name, passes in pipelines]
 
 
 def run_writing_command(command: List[str], compile_options: Optional[CompileOptions]) -> None:
@@ -127,9 +151,17 @@ HLO_LOWERING_PASS = (
 QUANTUM_COMPILATION_PASS = (
     "QuantumCompilationPass",
     [
+        "estimate-resources",
+        "specialize-qnode-constants",
+        "split-shots",
+        "cancel-commuting-gates",
         "lower-mitigation",
         "lower-gradients",
         "adjoint-lowering",
+        "recognize-subcircuits",
+        "record-gate-templates",
+        "select-backend",
+        "prefetch-devices",
     ],
 )
 
@@ -432,6 +464,7 @@ class Compiler:
                 verbose=self.options.verbose,
                 pipelines=self.options.get_pipelines(),
                 lower_to_llvm=lower_to_llvm,
+                cache_dir=self.options.compilation_cache_dir or "",
             )
         except RuntimeError as e:
             raise CompileError(*e.args) from e
@@ -494,6 +527,33 @@ class Compiler:
 
         return self.last_compiler_output.get_pipeline_output(pipeline)
 
+    def get_resource_estimates(self) -> Optional[Dict[str, dict]]:
+        """Get the static resource estimates of the functions of the last compiled program.
+
+        The estimates include the gate counts by name (``gates``) and by number of qubits
+        (``gate_widths``), the numbers of gates, gate parameters, measurements, state-vector
+        sweeps, circuit evaluations, and the peak number of qubits. Counts depending on loop trip
+        counts or sizes unknown at compile time are strings holding polynomials in these
+        unknowns, e.g. ``"2 + 3*n0"``. No estimates are available for programs loaded from the
+        compilation cache.
+
+        Returns
+            (Optional[Dict[str, dict]]): resource estimates keyed by function name
+        """
+        if not self.last_compiler_output:
+            return None
+
+        estimates = {}
+        for func_name, counts in self.last_compiler_output.get_resource_estimates().items():
+            func_estimates = estimates.setdefault(func_name, {})
+            for key, value in counts.items():
+                *groups, name = key.split(".")
+                group = func_estimates
+                for group_name in groups:
+                    group = group.setdefault(group_name, {})
+                group[name] = int(value) if value.isdigit() else value
+        return estimates
+
     def print(self, pipeline):
         """Print the output IR of pass.
         Args:
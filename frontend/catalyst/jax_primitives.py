@@ -17,7 +17,7 @@ of quantum operations, measurements, and observables to JAXPR.
 
 from dataclasses import astuple, dataclass
 from itertools import chain
-from typing import Dict, Iterable, List
+from typing import Dict, Iterable, List, Optional
 
 import jax
 import numpy as np
@@ -314,6 +314,7 @@ class GradParams:
     scalar_out: bool
     h: float
     argnum: List[int]
+    checkpoints: Optional[int] = None
 
     def __iter__(self):
         return iter(astuple(self))
@@ -345,6 +346,7 @@ def _grad_lowering(ctx, *args, jaxpr, fn, grad_params):
         h: the difference for finite difference. May be None when fn is not finite difference.
         argnum: argument indices which define over which arguments to
             differentiate.
+        checkpoints: the number of checkpoints of the backpropagation through loops. May be None.
     """
     method, h, argnum = grad_params.method, grad_params.h, grad_params.argnum
     mlir_ctx = ctx.module_context.context
@@ -352,6 +354,10 @@ def _grad_lowering(ctx, *args, jaxpr, fn, grad_params):
     if h:
         f64 = ir.F64Type.get(mlir_ctx)
         finiteDiffParam = ir.FloatAttr.get(f64, h)
+    checkpoints = None
+    if grad_params.checkpoints:
+        i64 = ir.IntegerType.get_signless(64, mlir_ctx)
+        checkpoints = ir.IntegerAttr.get(i64, grad_params.checkpoints)
     offset = len(jaxpr.consts)
     new_argnum = [num + offset for num in argnum]
     argnum_numpy = np.array(new_argnum)
@@ -377,6 +383,7 @@ def _grad_lowering(ctx, *args, jaxpr, fn, grad_params):
         mlir.flatten_lowering_ir_args(args_and_consts),
         diffArgIndices=diffArgIndices,
         finiteDiffParam=finiteDiffParam,
+        checkpoints=checkpoints,
     ).results
 
 
@@ -492,7 +492,11 @@ def _check_qnode_against_grad_method(f: QNode, method: str, jaxpr: Jaxpr):
 
 
 def _check_grad_params(
-    method: str, scalar_out: bool, h: Optional[float], argnum: Optional[Union[int, List[int]]]
+    method: str,
+    scalar_out: bool,
+    h: Optional[float],
+    argnum: Optional[Union[int, List[int]]],
+    checkpoints: Optional[int] = None,
 ) -> GradParams:
     """Check common gradient parameters and produce a class``GradParams`` object"""
     methods = {"fd", "auto"}
@@ -517,7 +521,13 @@ def _check_grad_params(
         pass
     else:
         raise ValueError(f"argnum should be integer or a list of integers, not {argnum}")
-    return GradParams(method, scalar_out, h, argnum)
+    if not (checkpoints is None or (isinstance(checkpoints, int) and checkpoints > 0)):
+        raise ValueError(
+            f"Invalid checkpoints value ({checkpoints}). None or a positive integer was expected."
+        )
+    if checkpoints is not None and method != "auto":
+        raise ValueError(f"Checkpoints are only supported by the 'auto' method, not by '{method}'.")
+    return GradParams(method, scalar_out, h, argnum, checkpoints)
 
 
 class Grad:
@@ -566,7 +576,7 @@ class Grad:
         return results
 
 
-def grad(f: DifferentiableLike, *, method=None, h=None, argnum=None):
+def grad(f: DifferentiableLike, *, method=None, h=None, argnum=None, checkpoints=None):
     """A :func:`~.qjit` compatible gradient transformation for PennyLane/Catalyst.
 
     This function allows the gradient of a hybrid quantum-classical function to be computed within
@@ -594,6 +604,11 @@ def grad(f: DifferentiableLike, *, method=None, h=None, argnum=None):
 
         h (float): the step-size value for the finite-difference (``"fd"``) method
         argnum (Tuple[int, List[int]]): the argument indices to differentiate
+        checkpoints (int): the number of segments of the first loop of the function whose
+                           loop-carried values are checkpointed with the ``"auto"`` method. The
+                           iterations of a segment are recomputed during the backward pass, which
+                           bounds the memory of long loops. By default, the values of all the
+                           iterations are recorded.
 
     Returns:
         Callable: A callable object that computes the gradient of the wrapped function for the given
@@ -693,10 +708,10 @@ def grad(f: DifferentiableLike, *, method=None, h=None, argnum=None):
     array(4.6)
     """
     scalar_out = True
-    return Grad(f, GradParams(method, scalar_out, h, argnum))
+    return Grad(f, GradParams(method, scalar_out, h, argnum, checkpoints))
 
 
-def jacobian(f: DifferentiableLike, *, method=None, h=None, argnum=None):
+def jacobian(f: DifferentiableLike, *, method=None, h=None, argnum=None, checkpoints=None):
     """A :func:`~.qjit` compatible Jacobian transformation for PennyLane/Catalyst.
 
     This function allows the Jacobian of a hybrid quantum-classical function to be computed within
@@ -719,6 +734,9 @@ def jacobian(f: DifferentiableLike, *, method=None, h=None, argnum=None):
 
         h (float): the step-size value for the finite-difference (``"fd"``) method
         argnum (Tuple[int, List[int]]): the argument indices to differentiate
+        checkpoints (int): the number of segments of the first loop of the function whose
+                           loop-carried values are checkpointed with the ``"auto"`` method. See
+                           :func:`~.grad`.
 
     Returns:
         Callable: A callable object that computes the Jacobian of the wrapped function for the given
@@ -758,7 +776,7 @@ def jacobian(f: DifferentiableLike, *, method=None, h=None, argnum=None):
            [-4.20735506e-01,  4.20735506e-01]])
     """
     scalar_out = False
-    return Grad(f, GradParams(method, scalar_out, h, argnum))
+    return Grad(f, GradParams(method, scalar_out, h, argnum, checkpoints))
 
 
 # pylint: disable=too-many-arguments
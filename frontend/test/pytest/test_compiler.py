@@ -25,10 +25,12 @@ import tempfile
 import warnings
 from os.path import isfile
 
+import numpy as np
 import pennylane as qml
 import pytest
+from mlir_quantum.compiler_driver import run_compiler_driver
 
-from catalyst import qjit
+from catalyst import grad, measure, qjit
 from catalyst.compilation_pipelines import WorkspaceManager
 from catalyst.compiler import DEFAULT_PIPELINES, CompileOptions, Compiler, LinkerDriver
 from catalyst.jax_tracer import trace_to_mlir
@@ -79,6 +81,22 @@ class TestCompilerOptions:
         assert ("Dumping" in capture) if (verbose and keep_intermediate) else True
         workflow.workspace.cleanup()
 
+    def test_shot_batches(self, backend):
+        """Test that the shots of a circuit with mid-circuit measurements are split in batches
+        run on the asynchronous pipeline"""
+
+        @qjit(shot_batches=4)
+        @qml.qnode(qml.device(backend, wires=1, shots=10))
+        def workflow():
+            qml.PauliX(wires=0)
+            measure(wires=0)
+            return qml.sample()
+
+        pipelines = dict(workflow.compile_options.get_pipelines())
+        assert "split-shots{num-batches=4}" in pipelines["QuantumCompilationPass"]
+        assert "qnode-to-async-lowering" in pipelines["MLIRToLLVMDialect"]
+        assert (workflow() == 1).all()
+
 
 class TestCompilerWarnings:
     """Test compiler's warning messages."""
@@ -202,10 +220,86 @@ class TestCompilerState:
         assert compiler.get_output_of("MLIRToLLVMDialect")
         assert compiler.get_output_of("EmptyPipeline2") is None
         assert compiler.get_output_of("PreEnzymeOpt")
-        assert compiler.get_output_of("Enzyme")
+        # Without derivatives to compute, the Enzyme pipeline is skipped.
+        assert compiler.get_output_of("Enzyme") is None
         assert compiler.get_output_of("None-existing-pipeline") is None
         workflow.workspace.cleanup()
 
+    def test_print_enzyme_stage(self, backend):
+        """Test that the Enzyme stage is run for programs with derivatives."""
+
+        @qjit(keep_intermediate=True)
+        def workflow(x: float):
+            @qml.qnode(qml.device(backend, wires=1))
+            def circuit(x):
+                qml.RX(x, wires=0)
+                return qml.expval(qml.PauliZ(0))
+
+            return grad(circuit)(x)
+
+        compiler = workflow.compiler
+        assert compiler.get_output_of("PreEnzymeOpt")
+        assert compiler.get_output_of("Enzyme")
+        workflow.workspace.cleanup()
+
+    def test_device_prefetch(self, backend):
+        """Test that the devices of the program are prefetched when the runtime is set up."""
+
+        @qjit(keep_intermediate=True)
+        @qml.qnode(qml.device(backend, wires=1))
+        def workflow():
+            qml.PauliX(wires=0)
+            return qml.state()
+
+        ir = workflow.compiler.get_output_of("QuantumCompilationPass")
+        assert "quantum.device_prefetch" in ir
+        assert np.allclose(workflow(), [0, 1])
+        workflow.workspace.cleanup()
+
+    def test_gate_templates(self, backend):
+        """Test that the gates of a qnode are recorded once and replayed with new parameters."""
+
+        def circuit(x):
+            for i in range(4):
+                qml.RX(x * (i + 1), wires=i % 2)
+                qml.CNOT(wires=[i % 2, (i + 1) % 2])
+            qml.RY(x, wires=0)
+            return qml.expval(qml.PauliZ(0) @ qml.PauliZ(1))
+
+        workflow = qjit(keep_intermediate=True)(qml.qnode(qml.device(backend, wires=2))(circuit))
+        reference = qml.qnode(qml.device("default.qubit", wires=2))(circuit)
+
+        ir = workflow.compiler.get_output_of("QuantumCompilationPass")
+        assert "quantum.replay" in ir
+        assert "quantum.toggle_template" in ir
+        for x in [0.1, 0.7, -1.3]:
+            assert np.allclose(workflow(x), reference(x))
+        workflow.workspace.cleanup()
+
+    def test_resource_estimates(self, backend):
+        """Test that the compiler reports static resource estimates of the compiled functions."""
+
+        @qjit
+        def workflow(x: float):
+            @qml.qnode(qml.device(backend, wires=2), diff_method="parameter-shift")
+            def circuit(x):
+                qml.Hadamard(wires=0)
+                qml.CNOT(wires=[0, 1])
+                qml.RX(x, wires=1)
+                return qml.expval(qml.PauliZ(1))
+
+            return grad(circuit)(x)
+
+        estimates = workflow.compiler.get_resource_estimates()
+        circuit = next(e for e in estimates.values() if e["circuit_evaluations"] == 1)
+        assert circuit["gates"] == {"Hadamard": 1, "CNOT": 1, "RX": 1}
+        assert circuit["gate_widths"] == {"1": 2, "2": 1}
+        assert circuit["num_qubits"] == 2
+        assert circuit["measurements"] == 1
+
+        # The parameter-shift gradient evaluates the circuit twice per gate parameter.
+        assert max(e["circuit_evaluations"] for e in estimates.values()) == 3
+
     def test_print_nonexistent_stages(self, backend):
         """What happens if we attempt to print something that doesn't exist?"""
 
@@ -357,6 +451,80 @@ module @workflow {
 
         assert "Trace" in e.value.args[0]
 
+    def test_compilation_cache(self):
+        """Test that an unchanged module is served from the compilation cache."""
+
+        ir = r"""
+module @workflow {
+  func.func public @catalyst.entry_point(%arg0: tensor<f64>) -> tensor<f64> attributes {llvm.emit_c_interface} {
+    %0 = call @workflow(%arg0) : (tensor<f64>) -> tensor<f64>
+    return %0 : tensor<f64>
+  }
+  func.func private @workflow(%arg0: tensor<f64>) -> tensor<f64> {
+    %0 = stablehlo.add %arg0, %arg0 : tensor<f64>
+    return %0 : tensor<f64>
+  }
+}
+"""
+        with tempfile.TemporaryDirectory() as workspace, tempfile.TemporaryDirectory() as cache:
+
+            def compile_ir(source):
+                return run_compiler_driver(
+                    source,
+                    workspace,
+                    "workflow",
+                    verbose=True,
+                    pipelines=DEFAULT_PIPELINES,
+                    cache_dir=cache,
+                )
+
+            def entries():
+                return [f for f in os.listdir(cache) if f.endswith(".bc")]
+
+            first = compile_ir(ir)
+            assert "Compilation cache miss" in first.get_diagnostic_messages()
+            assert len(entries()) == 1
+
+            second = compile_ir(ir)
+            assert "Compilation cache hit" in second.get_diagnostic_messages()
+            assert second.get_function_attributes().get_function_name() == "catalyst.entry_point"
+
+            # Changing a callee of the entry point invalidates the entry.
+            third = compile_ir(ir.replace("stablehlo.add", "stablehlo.multiply"))
+            assert "Compilation cache miss" in third.get_diagnostic_messages()
+            assert len(entries()) == 2
+
+    def test_compilation_cache_resource_estimates(self):
+        """Test that the resource estimates of a cached module are restored on a cache hit."""
+
+        @qjit(target="mlir")
+        @qml.qnode(qml.device("lightning.qubit", wires=2))
+        def workflow(x: float):
+            qml.Hadamard(wires=0)
+            qml.CNOT(wires=[0, 1])
+            qml.RX(x, wires=1)
+            return qml.expval(qml.PauliZ(1))
+
+        with tempfile.TemporaryDirectory() as workspace, tempfile.TemporaryDirectory() as cache:
+
+            def compile_ir():
+                return run_compiler_driver(
+                    workflow.mlir,
+                    workspace,
+                    "workflow",
+                    verbose=True,
+                    pipelines=DEFAULT_PIPELINES,
+                    cache_dir=cache,
+                )
+
+            first = compile_ir()
+            assert "Compilation cache miss" in first.get_diagnostic_messages()
+            assert first.get_resource_estimates()
+
+            second = compile_ir()
+            assert "Compilation cache hit" in second.get_diagnostic_messages()
+            assert second.get_resource_estimates() == first.get_resource_estimates()
+
 
 if __name__ == "__main__":
     pytest.main(["-x", __file__])
@@ -304,6 +304,36 @@ def test_adj_mult(inp, backend):
     assert np.allclose(compiled(inp), interpreted(inp))
 
 
+@pytest.mark.parametrize("inp", [(1.0, 0.5), (2.0, -1.0), (3.0, 4.0)])
+def test_adj_merged_rotations(inp, backend):
+    """Test the adjoint method on consecutive rotations, which the compiler merges, against the
+    parameter-shift method."""
+
+    def f(x, y):
+        qml.RX(x, wires=0)
+        qml.RX(y, wires=0)
+        return qml.expval(qml.PauliY(0))
+
+    def compiled(method):
+        @qjit()
+        def workflow(x: float, y: float):
+            g = qml.qnode(qml.device(backend, wires=1), diff_method=method)(f)
+            h = grad(g, argnum=[0, 1])
+            return h(x, y)
+
+        return workflow(*inp)
+
+    def interpreted(x, y):
+        device = qml.device("default.qubit", wires=1)
+        g = qml.QNode(f, device, diff_method="backprop")
+        h = qml.grad(g, argnum=[0, 1])
+        return h(x, y)
+
+    adjoint = compiled("adjoint")
+    assert np.allclose(adjoint, compiled("parameter-shift"))
+    assert np.allclose(adjoint, interpreted(*inp))
+
+
 @pytest.mark.parametrize("inp", [(1.0), (2.0), (3.0), (4.0)])
 def test_adj_in_loop(inp, backend):
     """Test the adjoint method in loop."""
@@ -759,6 +789,61 @@ def test_assert_invalid_h_type():
             return h(x)
 
 
+def test_assert_invalid_checkpoints():
+    """Test invalid number of checkpoints detection"""
+
+    def f(x):
+        qml.RX(x, wires=0)
+        return qml.expval(qml.PauliY(0))
+
+    with pytest.raises(ValueError, match="Invalid checkpoints value"):
+
+        @qjit()
+        def workflow(x: float):
+            g = qml.qnode(qml.device("lightning.qubit", wires=1))(f)
+            h = grad(g, checkpoints=0)
+            return h(x)
+
+
+def test_checkpointed_classical_loop():
+    """Test the gradient of a long classical loop backpropagated through checkpointed segments"""
+
+    def f(x):
+        @for_loop(0, 100, 1)
+        def body(_, y):
+            return jnp.sin(y) * x
+
+        return body(x)
+
+    @qjit(keep_intermediate=True)
+    def checkpointed(x: float):
+        return grad(f, checkpoints=10)(x)
+
+    @qjit
+    def recorded(x: float):
+        return grad(f)(x)
+
+    assert np.allclose(checkpointed(0.5), recorded(0.5))
+
+    # The loop is backpropagated through a segment function, once per checkpoint
+    ir = checkpointed.compiler.get_output_of("QuantumCompilationPass")
+    assert ".segment" in ir
+    checkpointed.workspace.cleanup()
+
+
+def test_checkpoints_finite_diff():
+    """Test that checkpoints are rejected by the finite-difference method"""
+
+    def f(x):
+        return jnp.sin(x)
+
+    with pytest.raises(ValueError, match="Checkpoints are only supported by the 'auto' method"):
+
+        @qjit()
+        def workflow(x: float):
+            return grad(f, method="fd", checkpoints=2)(x)
+
+
 def test_assert_non_differentiable():
     """Test non-differentiable parameter detection"""
     with pytest.raises(DifferentiableCompileError, match="Non-differentiable object passed"):
@@ -26,6 +26,7 @@ std::unique_ptr<mlir::Pass> createCatalystConversionPass();
 std::unique_ptr<mlir::Pass> createScatterLoweringPass();
 std::unique_ptr<mlir::Pass> createHloCustomCallLoweringPass();
 std::unique_ptr<mlir::Pass> createQnodeToAsyncLoweringPass();
+std::unique_ptr<mlir::Pass> createQnodeSpecializationPass();
 
 void registerAllCatalystPasses();
 
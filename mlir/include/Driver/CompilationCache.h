@@ -0,0 +1,57 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "mlir/IR/BuiltinOps.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+
+#include "CompilerDriver.h"
+
+namespace catalyst {
+namespace driver {
+
+/// Compute a structural hash for every `func.func` of the module. The hash of a function covers
+/// its own body (without locations), the hashes of all the functions it references, directly or
+/// transitively, and the pipeline configuration it is going to be lowered with. The hashes are
+/// reported in debug output only: the cache stores whole modules, not individual functions.
+llvm::StringMap<uint64_t> hashFunctions(mlir::ModuleOp moduleOp, const CompilerOptions &options);
+
+/// Build the key under which the compiled module is stored in the cache. Only the functions
+/// reachable from the public functions of the module, and the non-function top-level operations,
+/// contribute to the key, along with the versions of Catalyst and LLVM and the target triple and
+/// host CPU.
+std::string getCacheKey(mlir::ModuleOp moduleOp, const CompilerOptions &options);
+
+/// Load the optimized LLVM module stored under the given key, along with the resource estimates of
+/// the module it was compiled from, or return nullptr if there is no such entry in the cache.
+std::unique_ptr<llvm::Module>
+loadCachedModule(const CompilerOptions &options, llvm::StringRef key, llvm::LLVMContext &context,
+                 std::map<std::string, ResourceEstimates> &resourceEstimates);
+
+/// Store the optimized LLVM module and the resource estimates of the module it was compiled from
+/// under the given key. Failures are reported but otherwise ignored, the cache is only an
+/// optimization.
+void storeCachedModule(const CompilerOptions &options, llvm::StringRef key,
+                       const llvm::Module &llvmModule,
+                       const std::map<std::string, ResourceEstimates> &resourceEstimates);
+
+} // namespace driver
+} // namespace catalyst
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <filesystem>
+#include <map>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -38,6 +39,11 @@ struct FunctionAttributes {
     std::string returnType;
 };
 
+/// Static resource estimates of a function, computed by the `estimate-resources` pass. Nested
+/// counts are flattened into dotted keys, e.g. `gates.CNOT`. Values are integers, or polynomials
+/// in the loop trip counts and sizes unknown at compile time, e.g. `2 + 3*n0`.
+using ResourceEstimates = std::map<std::string, std::string>;
+
 /// Verbosity level
 // TODO: Adjust the number of levels according to our needs. MLIR seems to print few really
 // low-level messages, we might want to hide these.
@@ -78,6 +84,10 @@ struct CompilerOptions {
     std::vector<Pipeline> pipelinesCfg;
     /// Whether to assume that the pipelines output is a valid LLVM dialect and lower it to LLVM IR
     bool lowerToLLVM;
+    /// The directory in which whole optimized LLVM modules are cached, keyed by the structural
+    /// hashes of their functions, the compiler versions and the target. Caching is disabled when
+    /// empty.
+    mlir::StringRef cacheDir = "";
 
     /// Get the destination of the object file at the end of compilation.
     std::string getObjectFile() const
@@ -94,6 +104,8 @@ struct CompilerOutput {
     std::string diagnosticMessages;
     FunctionAttributes inferredAttributes;
     PipelineOutputs pipelineOutputs;
+    /// Resource estimates of each function, if the pipelines include the estimation pass.
+    std::map<std::string, ResourceEstimates> resourceEstimates;
     size_t pipelineCounter = 0;
 
     // Gets the next pipeline dump file name, prefixed with number.
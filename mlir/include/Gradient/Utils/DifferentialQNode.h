@@ -34,8 +34,10 @@ void setRequiresCustomGradient(mlir::func::FuncOp funcOp, mlir::FlatSymbolRefAtt
 /// Check if this `funcOp` requires the generation and registration of a custom gradient.
 bool requiresCustomGradient(mlir::func::FuncOp funcOp);
 
-/// Register a custom quantum gradient for the given QNode.
-void registerCustomGradient(mlir::func::FuncOp qnode, mlir::FlatSymbolRefAttr qgradFn);
+/// Register a custom quantum gradient for the given QNode. The optional `fusedQGradFn` computes
+/// both the results of the QNode and its quantum gradient from a single execution.
+void registerCustomGradient(mlir::func::FuncOp qnode, mlir::FlatSymbolRefAttr qgradFn,
+                            mlir::FlatSymbolRefAttr fusedQGradFn = nullptr);
 
 } // namespace gradient
 } // namespace catalyst
@@ -25,5 +25,12 @@ std::unique_ptr<mlir::Pass> createQuantumConversionPass();
 std::unique_ptr<mlir::Pass> createEmitCatalystPyInterfacePass();
 std::unique_ptr<mlir::Pass> createCopyGlobalMemRefPass();
 std::unique_ptr<mlir::Pass> createAdjointLoweringPass();
+std::unique_ptr<mlir::Pass> createSubcircuitRecognitionPass();
+std::unique_ptr<mlir::Pass> createGateCancellationPass();
+std::unique_ptr<mlir::Pass> createResourceEstimationPass();
+std::unique_ptr<mlir::Pass> createBackendSelectionPass();
+std::unique_ptr<mlir::Pass> createShotBatchingPass();
+std::unique_ptr<mlir::Pass> createDevicePrefetchPass();
+std::unique_ptr<mlir::Pass> createGateTemplatePass();
 
 } // namespace catalyst
@@ -25,6 +25,9 @@ void populateBufferizationLegality(mlir::TypeConverter &, mlir::ConversionTarget
 void populateBufferizationPatterns(mlir::TypeConverter &, mlir::RewritePatternSet &);
 void populateQIRConversionPatterns(mlir::TypeConverter &, mlir::RewritePatternSet &);
 void populateAdjointPatterns(mlir::RewritePatternSet &);
+void populateSubcircuitRecognitionPatterns(mlir::RewritePatternSet &);
+void populateCommutationPatterns(mlir::RewritePatternSet &);
+void populateShotBatchingPatterns(mlir::RewritePatternSet &, unsigned numBatches);
 
 } // namespace quantum
 } // namespace catalyst
@@ -0,0 +1,142 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define DEBUG_TYPE "specialization"
+
+#include <string>
+
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Debug.h"
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/IR/SymbolTable.h"
+
+using namespace llvm;
+using namespace mlir;
+
+namespace catalyst {
+
+// The qnode a function was specialized from, and the constant value of each of
+// its arguments, or a unit attribute for the arguments left as runtime values.
+static constexpr StringLiteral specializationOfAttrName = "specialization_of";
+static constexpr StringLiteral specializedArgsAttrName = "specialized_args";
+
+/// Clone a qnode for each distinct pattern of constant arguments at its call
+/// sites. The constants are materialized in the entry block of the clone,
+/// which no longer takes them as arguments, so that they can be folded into
+/// gate parameters and observable coefficients.
+struct QnodeSpecializationPattern : public OpRewritePattern<func::CallOp> {
+    using OpRewritePattern<func::CallOp>::OpRewritePattern;
+
+    static func::FuncOp lookupSpecialization(ModuleOp mod, func::FuncOp callee,
+                                             ArrayAttr specializedArgs)
+    {
+        for (auto func : mod.getOps<func::FuncOp>()) {
+            auto origin = func->getAttrOfType<FlatSymbolRefAttr>(specializationOfAttrName);
+            if (origin && origin.getValue() == callee.getSymName() &&
+                func->getAttr(specializedArgsAttrName) == specializedArgs) {
+                return func;
+            }
+        }
+        return nullptr;
+    }
+
+    static func::FuncOp createSpecialization(PatternRewriter &rewriter, func::FuncOp callee,
+                                             ArrayRef<Operation *> constantOps,
+                                             ArrayAttr specializedArgs)
+    {
+        func::FuncOp specialized = callee.clone();
+
+        // The symbols of other specializations of the callee are suffixed by a counter.
+        std::string name = (callee.getSymName() + ".specialized").str();
+        for (unsigned idx = 1; SymbolTable::lookupNearestSymbolFrom(
+                 callee, StringAttr::get(callee.getContext(), name));
+             idx++) {
+            name = (callee.getSymName() + ".specialized." + Twine(idx)).str();
+        }
+        specialized.setSymName(name);
+        specialized->setAttr(specializationOfAttrName, FlatSymbolRefAttr::get(callee));
+        specialized->setAttr(specializedArgsAttrName, specializedArgs);
+
+        Block &entry = specialized.getBody().front();
+        OpBuilder builder(specialized.getContext());
+        builder.setInsertionPointToStart(&entry);
+        BitVector constantArgs(entry.getNumArguments());
+        for (auto [idx, constantOp] : llvm::enumerate(constantOps)) {
+            if (!constantOp) {
+                continue;
+            }
+            Operation *constant = builder.clone(*constantOp);
+            entry.getArgument(idx).replaceAllUsesWith(constant->getResult(0));
+            constantArgs.set(idx);
+        }
+        specialized.eraseArguments(constantArgs);
+
+        PatternRewriter::InsertionGuard insertGuard(rewriter);
+        rewriter.setInsertionPointAfter(callee);
+        rewriter.insert(specialized);
+        return specialized;
+    }
+
+    LogicalResult matchAndRewrite(func::CallOp op, PatternRewriter &rewriter) const override
+    {
+        auto mod = op->getParentOfType<ModuleOp>();
+        func::FuncOp callee =
+            SymbolTable::lookupNearestSymbolFrom<func::FuncOp>(op, op.getCalleeAttr());
+        if (!mod || !callee || callee.isExternal() || !callee->hasAttrOfType<UnitAttr>("qnode")) {
+            return failure();
+        }
+
+        SmallVector<Attribute> argValues;
+        SmallVector<Operation *> constantOps;
+        SmallVector<Value> runtimeOperands;
+        for (Value operand : op.getOperands()) {
+            Attribute value;
+            if (matchPattern(operand, m_Constant(&value))) {
+                argValues.push_back(value);
+                constantOps.push_back(operand.getDefiningOp());
+            }
+            else {
+                argValues.push_back(rewriter.getUnitAttr());
+                constantOps.push_back(nullptr);
+                runtimeOperands.push_back(operand);
+            }
+        }
+        if (runtimeOperands.size() == op.getNumOperands()) {
+            return failure();
+        }
+
+        LLVM_DEBUG(dbgs() << "specializing call to " << callee.getSymName() << "\n");
+
+        ArrayAttr specializedArgs = rewriter.getArrayAttr(argValues);
+        func::FuncOp specialized = lookupSpecialization(mod, callee, specializedArgs);
+        if (!specialized) {
+            specialized = createSpecialization(rewriter, callee, constantOps, specializedArgs);
+        }
+
+        rewriter.replaceOpWithNewOp<func::CallOp>(op, specialized, runtimeOperands);
+        return success();
+    }
+};
+
+void populateQnodeSpecializationPatterns(RewritePatternSet &patterns)
+{
+    patterns.add<catalyst::QnodeSpecializationPattern>(patterns.getContext());
+}
+
+} // namespace catalyst
@@ -27,6 +27,13 @@ void catalyst::registerAllCatalystPasses()
     mlir::registerPass(catalyst::createGradientConversionPass);
     mlir::registerPass(catalyst::createScatterLoweringPass);
     mlir::registerPass(catalyst::createAdjointLoweringPass);
+    mlir::registerPass(catalyst::createSubcircuitRecognitionPass);
+    mlir::registerPass(catalyst::createGateCancellationPass);
+    mlir::registerPass(catalyst::createResourceEstimationPass);
+    mlir::registerPass(catalyst::createBackendSelectionPass);
+    mlir::registerPass(catalyst::createShotBatchingPass);
+    mlir::registerPass(catalyst::createDevicePrefetchPass);
+    mlir::registerPass(catalyst::createGateTemplatePass);
     mlir::registerPass(catalyst::createQuantumBufferizationPass);
     mlir::registerPass(catalyst::createQuantumConversionPass);
     mlir::registerPass(catalyst::createMitigationLoweringPass);
@@ -34,6 +41,7 @@ void catalyst::registerAllCatalystPasses()
     mlir::registerPass(catalyst::createCopyGlobalMemRefPass);
     mlir::registerPass(catalyst::createCatalystConversionPass);
     mlir::registerPass(catalyst::createQnodeToAsyncLoweringPass);
+    mlir::registerPass(catalyst::createQnodeSpecializationPass);
     mlir::registerPass(catalyst::createTestPass);
     mlir::registerPass(catalyst::createHloCustomCallLoweringPass);
 }
@@ -0,0 +1,62 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define DEBUG_TYPE "specialization"
+
+#include <memory>
+
+#include "llvm/Support/Debug.h"
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+#include "Catalyst/Transforms/Patterns.h"
+
+using namespace llvm;
+using namespace mlir;
+using namespace catalyst;
+
+namespace catalyst {
+#define GEN_PASS_DEF_QNODESPECIALIZATIONPASS
+#include "Catalyst/Transforms/Passes.h.inc"
+
+struct QnodeSpecializationPass : impl::QnodeSpecializationPassBase<QnodeSpecializationPass> {
+    using QnodeSpecializationPassBase::QnodeSpecializationPassBase;
+
+    void runOnOperation() final
+    {
+        LLVM_DEBUG(dbgs() << "qnode specialization pass"
+                          << "\n");
+
+        RewritePatternSet patterns(&getContext());
+        populateQnodeSpecializationPatterns(patterns);
+        if (failed(applyPatternsAndFoldGreedily(getOperation(), std::move(patterns)))) {
+            return signalPassFailure();
+        }
+
+        // Fold the constants materialized in the bodies of the new specializations.
+        RewritePatternSet foldPatterns(&getContext());
+        if (failed(applyPatternsAndFoldGreedily(getOperation(), std::move(foldPatterns)))) {
+            return signalPassFailure();
+        }
+    }
+};
+
+std::unique_ptr<Pass> createQnodeSpecializationPass()
+{
+    return std::make_unique<QnodeSpecializationPass>();
+}
+
+} // namespace catalyst
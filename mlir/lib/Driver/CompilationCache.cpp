@@ -0,0 +1,308 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/SymbolTable.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/xxhash.h"
+#include "llvm/TargetParser/Host.h"
+
+#include "Driver/CompilationCache.h"
+
+#ifndef CATALYST_VERSION
+#define CATALYST_VERSION "unknown"
+#endif
+#ifndef CATALYST_REVISION
+#define CATALYST_REVISION "unknown"
+#endif
+
+using namespace mlir;
+using namespace catalyst::driver;
+
+namespace {
+
+/// Describe the compiler and the target the cached modules are produced by and for, so that
+/// entries of another build of Catalyst or LLVM, or of another machine sharing the cache
+/// directory, are never reused.
+std::string getCompilerIdentity()
+{
+    std::string text;
+    llvm::raw_string_ostream stream{text};
+    stream << "catalyst=" << CATALYST_VERSION << "@" << CATALYST_REVISION
+           << ";llvm=" << LLVM_VERSION_STRING << ";triple=" << llvm::sys::getDefaultTargetTriple()
+           << ";cpu=" << llvm::sys::getHostCPUName();
+    return stream.str();
+}
+
+/// Print the operation in generic form and without locations, so that the textual form only
+/// depends on the structure of the operation.
+std::string printStructure(Operation *op)
+{
+    std::string text;
+    llvm::raw_string_ostream stream{text};
+    op->print(stream, OpPrintingFlags().printGenericOpForm().useLocalScope());
+    return stream.str();
+}
+
+uint64_t hashPipelines(const CompilerOptions &options)
+{
+    std::string text;
+    llvm::raw_string_ostream stream{text};
+    for (const auto &pipeline : options.pipelinesCfg) {
+        stream << pipeline << ";";
+    }
+    stream << "lowerToLLVM=" << options.lowerToLLVM;
+    return llvm::xxHash64(stream.str());
+}
+
+struct FunctionHasher {
+    SymbolTable symbolTable;
+    uint64_t pipelinesHash;
+    llvm::StringMap<uint64_t> hashes;
+    llvm::DenseSet<Operation *> inProgress;
+
+    FunctionHasher(ModuleOp moduleOp, const CompilerOptions &options)
+        : symbolTable(moduleOp), pipelinesHash(hashPipelines(options))
+    {
+    }
+
+    uint64_t hash(func::FuncOp funcOp)
+    {
+        auto cached = hashes.find(funcOp.getSymName());
+        if (cached != hashes.end()) {
+            return cached->second;
+        }
+
+        std::string text = printStructure(funcOp);
+        llvm::raw_string_ostream stream{text};
+        stream << "pipelines=" << pipelinesHash;
+
+        // Mix in the hashes of all referenced functions, in a deterministic order. Recursive
+        // references only contribute their name, which is already part of the printed body.
+        inProgress.insert(funcOp);
+        std::vector<std::pair<std::string, uint64_t>> callees;
+        if (auto uses = SymbolTable::getSymbolUses(funcOp.getOperation())) {
+            for (const SymbolTable::SymbolUse &use : *uses) {
+                auto callee =
+                    symbolTable.lookup<func::FuncOp>(use.getSymbolRef().getRootReference());
+                if (!callee || inProgress.contains(callee)) {
+                    continue;
+                }
+                callees.emplace_back(callee.getSymName().str(), hash(callee));
+            }
+        }
+        inProgress.erase(funcOp);
+
+        std::sort(callees.begin(), callees.end());
+        for (const auto &[name, calleeHash] : callees) {
+            stream << ";" << name << "=" << calleeHash;
+        }
+
+        uint64_t result = llvm::xxHash64(stream.str());
+        hashes[funcOp.getSymName()] = result;
+        return result;
+    }
+};
+
+std::string getCacheFile(const CompilerOptions &options, StringRef key)
+{
+    using std::filesystem::path;
+    return path(options.cacheDir.str()) / path(key.str() + ".bc");
+}
+
+std::string getResourcesFile(const CompilerOptions &options, StringRef key)
+{
+    using std::filesystem::path;
+    return path(options.cacheDir.str()) / path(key.str() + ".resources.json");
+}
+
+/// Read the resource estimates of a cache entry, stored as a JSON object of the estimates of each
+/// function.
+bool loadResourceEstimates(const std::string &file,
+                           std::map<std::string, ResourceEstimates> &resourceEstimates)
+{
+    auto buffer = llvm::MemoryBuffer::getFile(file);
+    if (!buffer) {
+        return false;
+    }
+    llvm::Expected<llvm::json::Value> json = llvm::json::parse((*buffer)->getBuffer());
+    if (!json) {
+        llvm::consumeError(json.takeError());
+        return false;
+    }
+    const llvm::json::Object *functions = json->getAsObject();
+    if (!functions) {
+        return false;
+    }
+
+    std::map<std::string, ResourceEstimates> loaded;
+    for (const auto &[function, counts] : *functions) {
+        const llvm::json::Object *countsObject = counts.getAsObject();
+        if (!countsObject) {
+            return false;
+        }
+        ResourceEstimates &estimates = loaded[function.str()];
+        for (const auto &[name, value] : *countsObject) {
+            std::optional<StringRef> text = value.getAsString();
+            if (!text) {
+                return false;
+            }
+            estimates[name.str()] = text->str();
+        }
+    }
+    resourceEstimates = std::move(loaded);
+    return true;
+}
+
+/// Write a cache file into a unique temporary file first and rename it, so that concurrent
+/// compilations never observe a partially written entry.
+bool writeCacheFile(const CompilerOptions &options, const std::string &file,
+                    llvm::function_ref<void(llvm::raw_ostream &)> write)
+{
+    int fd;
+    llvm::SmallString<128> tmpFile;
+    std::error_code errCode = llvm::sys::fs::createUniqueFile(file + ".%%%%%%.tmp", fd, tmpFile);
+    if (errCode) {
+        CO_MSG(options, Verbosity::Urgent,
+               "Unable to create cache entry: " << errCode.message() << "\n");
+        return false;
+    }
+    {
+        llvm::raw_fd_ostream outfile{fd, /*shouldClose=*/true};
+        write(outfile);
+    }
+
+    if ((errCode = llvm::sys::fs::rename(tmpFile, file))) {
+        CO_MSG(options, Verbosity::Urgent,
+               "Unable to store cache entry: " << errCode.message() << "\n");
+        llvm::sys::fs::remove(tmpFile);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+namespace catalyst {
+namespace driver {
+
+llvm::StringMap<uint64_t> hashFunctions(ModuleOp moduleOp, const CompilerOptions &options)
+{
+    FunctionHasher hasher(moduleOp, options);
+    moduleOp.walk([&](func::FuncOp funcOp) { hasher.hash(funcOp); });
+    return std::move(hasher.hashes);
+}
+
+std::string getCacheKey(ModuleOp moduleOp, const CompilerOptions &options)
+{
+    FunctionHasher hasher(moduleOp, options);
+
+    std::string text;
+    llvm::raw_string_ostream stream{text};
+    stream << getCompilerIdentity() << ";" << moduleOp->getAttrDictionary()
+           << "pipelines=" << hasher.pipelinesHash;
+
+    for (Operation &op : moduleOp.getBody()->getOperations()) {
+        auto funcOp = dyn_cast<func::FuncOp>(op);
+        if (!funcOp) {
+            stream << ";" << printStructure(&op);
+        }
+        else if (funcOp.isPublic()) {
+            stream << ";" << funcOp.getSymName() << "=" << hasher.hash(funcOp);
+        }
+    }
+
+    return llvm::utohexstr(llvm::xxHash64(stream.str()), /*LowerCase=*/true);
+}
+
+std::unique_ptr<llvm::Module>
+loadCachedModule(const CompilerOptions &options, StringRef key, llvm::LLVMContext &context,
+                 std::map<std::string, ResourceEstimates> &resourceEstimates)
+{
+    std::string cacheFile = getCacheFile(options, key);
+    if (!llvm::sys::fs::exists(cacheFile)) {
+        CO_MSG(options, Verbosity::Debug, "Compilation cache miss: '" << cacheFile << "'\n");
+        return nullptr;
+    }
+
+    // The estimates are stored before the module, an entry without them is incomplete.
+    std::map<std::string, ResourceEstimates> estimates;
+    if (!loadResourceEstimates(getResourcesFile(options, key), estimates)) {
+        CO_MSG(options, Verbosity::Urgent,
+               "Ignoring cache entry without resource estimates '" << cacheFile << "'\n");
+        return nullptr;
+    }
+
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> llvmModule = llvm::parseIRFile(cacheFile, err, context);
+    if (!llvmModule) {
+        CO_MSG(options, Verbosity::Urgent,
+               "Ignoring unreadable cache entry '" << cacheFile << "'\n");
+        return nullptr;
+    }
+
+    CO_MSG(options, Verbosity::Debug, "Compilation cache hit: '" << cacheFile << "'\n");
+    resourceEstimates = std::move(estimates);
+    return llvmModule;
+}
+
+void storeCachedModule(const CompilerOptions &options, StringRef key,
+                       const llvm::Module &llvmModule,
+                       const std::map<std::string, ResourceEstimates> &resourceEstimates)
+{
+    std::error_code errCode = llvm::sys::fs::create_directories(options.cacheDir);
+    if (errCode) {
+        CO_MSG(options, Verbosity::Urgent,
+               "Unable to create cache directory: " << errCode.message() << "\n");
+        return;
+    }
+
+    llvm::json::Object functions;
+    for (const auto &[function, estimates] : resourceEstimates) {
+        llvm::json::Object counts;
+        for (const auto &[name, value] : estimates) {
+            counts[name] = value;
+        }
+        functions[function] = std::move(counts);
+    }
+    auto writeResources = [&](llvm::raw_ostream &os) {
+        os << llvm::json::Value(std::move(functions));
+    };
+    auto writeModule = [&](llvm::raw_ostream &os) { llvm::WriteBitcodeToFile(llvmModule, os); };
+
+    // The module is stored last, such that an entry is only found once it is complete.
+    std::string cacheFile = getCacheFile(options, key);
+    if (writeCacheFile(options, getResourcesFile(options, key), writeResources) &&
+        writeCacheFile(options, cacheFile, writeModule)) {
+        CO_MSG(options, Verbosity::Debug, "Stored compilation cache entry '" << cacheFile << "'\n");
+    }
+}
+
+} // namespace driver
+} // namespace catalyst
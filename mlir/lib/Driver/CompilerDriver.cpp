@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <filesystem>
+#include <functional>
 #include <list>
 #include <memory>
 #include <string>
@@ -21,6 +22,7 @@
 #include "gml_st/transforms/passes.h"
 #include "mhlo/IR/register.h"
 #include "mhlo/transforms/passes.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/IR/DialectRegistry.h"
 #include "mlir/InitAllDialects.h"
 #include "mlir/InitAllExtensions.h"
@@ -38,6 +40,7 @@
 #include "Catalyst/IR/CatalystDialect.h"
 #include "Catalyst/Transforms/Passes.h"
 #include "Driver/CatalystLLVMTarget.h"
+#include "Driver/CompilationCache.h"
 #include "Driver/CompilerDriver.h"
 #include "Driver/Support.h"
 #include "Gradient/IR/GradientDialect.h"
@@ -101,6 +104,33 @@ struct CatalystPassInstrumentation : public PassInstrumentation {
     }
 };
 
+/// Gather the resource estimates attached to the functions of a module by the resource estimation
+/// pass, flattening the nested counts into dotted keys.
+void collectResourceEstimates(Operation *op, CompilerOutput &output)
+{
+    std::function<void(ResourceEstimates &, StringRef, DictionaryAttr)> flatten =
+        [&](ResourceEstimates &estimates, StringRef prefix, DictionaryAttr counts) {
+            for (NamedAttribute count : counts) {
+                std::string key = (prefix + count.getName().strref()).str();
+                if (auto nested = dyn_cast<DictionaryAttr>(count.getValue())) {
+                    flatten(estimates, key + ".", nested);
+                }
+                else if (auto value = dyn_cast<IntegerAttr>(count.getValue())) {
+                    estimates[key] = std::to_string(value.getInt());
+                }
+                else if (auto value = dyn_cast<StringAttr>(count.getValue())) {
+                    estimates[key] = value.str();
+                }
+            }
+        };
+
+    op->walk([&](func::FuncOp func) {
+        if (auto resources = func->getAttrOfType<DictionaryAttr>("quantum.resources")) {
+            flatten(output.resourceEstimates[func.getSymName().str()], "", resources);
+        }
+    });
+}
+
 // Run the callback with stack printing disabled
 void withoutStackTrace(MLIRContext *ctx, std::function<void()> callback)
 {
@@ -225,12 +255,31 @@ LogicalResult inferMLIRReturnTypes(MLIRContext *ctx, llvm::Type *returnType,
     return failure();
 }
 
+/// Returns true if the module calls into Enzyme, i.e. if it contains functions that remain to be
+/// differentiated.
+bool requiresDifferentiation(const llvm::Module &llvmModule)
+{
+    for (const llvm::Function &function : llvmModule.functions()) {
+        StringRef name = function.getName();
+        if ((name.starts_with("__enzyme_autodiff") || name.starts_with("__enzyme_fwddiff")) &&
+            !function.use_empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 LogicalResult runLLVMPasses(const CompilerOptions &options,
-                            std::shared_ptr<llvm::Module> llvmModule, CompilerOutput &output)
+                            std::shared_ptr<llvm::Module> llvmModule, CompilerOutput &output,
+                            bool differentiate)
 {
     // opt -O2
     // As seen here:
     // https://llvm.org/docs/NewPassManager.html#just-tell-me-how-to-run-the-default-optimization-pipeline-with-the-new-pass-manager
+    //
+    // When the module is going to be differentiated, only the simplification half of the O2
+    // pipeline is run here. The optimization half runs once, after Enzyme, on both the primal and
+    // the derivative functions.
 
     auto &outputs = output.pipelineOutputs;
     // Create the analysis managers.
@@ -251,8 +300,11 @@ LogicalResult runLLVMPasses(const CompilerOptions &options,
     PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
 
     // Create the pass manager.
-    // This one corresponds to a typical -O2 optimization pipeline.
-    llvm::ModulePassManager MPM = PB.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O2);
+    // This one corresponds to a typical -O2 optimization pipeline, or to its pre-AD cleanup part.
+    llvm::ModulePassManager MPM =
+        differentiate ? PB.buildModuleSimplificationPipeline(llvm::OptimizationLevel::O2,
+                                                             llvm::ThinOrFullLTOPhase::None)
+                      : PB.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O2);
 
     // Optimize the IR!
     MPM.run(*llvmModule.get(), MAM);
@@ -350,7 +402,11 @@ LogicalResult runLowering(const CompilerOptions &options, MLIRContext *ctx, Modu
 
     // For each pipeline-terminating pass, print the IR into the corresponding dump file and
     // into a diagnostic output buffer. Note that one pass can terminate multiple pipelines.
+    // The resource estimates are collected right after the estimation pass.
     auto afterPassCallback = [&](Pass *pass, Operation *op) {
+        if (pass->getArgument() == "estimate-resources") {
+            collectResourceEstimates(op, output);
+        }
         if (!options.keepIntermediate)
             return;
         auto res = pipelineTailMarkers.find(pass);
@@ -422,9 +478,29 @@ LogicalResult QuantumDriverMain(const CompilerOptions &options, CompilerOutput &
     sourceMgr->AddNewSourceBuffer(std::move(moduleBuffer), SMLoc());
     SourceMgrDiagnosticHandler sourceMgrHandler(*sourceMgr, &ctx, options.diagnosticStream);
 
+    // Key of the compilation cache entry for this module, if caching applies. Intermediate results
+    // are never cached, so the cache is bypassed whenever they are requested.
+    std::string cacheKey;
+    bool cacheHit = false;
+
     // First attempt to parse the input as an MLIR module.
     OwningOpRef<ModuleOp> op = parseMLIRSource(&ctx, *sourceMgr);
-    if (op) {
+    if (op && !options.cacheDir.empty() && options.lowerToLLVM && !options.keepIntermediate) {
+        if (options.verbosity >= Verbosity::Debug) {
+            for (const auto &entry : hashFunctions(*op, options)) {
+                CO_MSG(options, Verbosity::Debug,
+                       "Function '" << entry.getKey() << "' hash: " << entry.getValue() << "\n");
+            }
+        }
+        cacheKey = getCacheKey(*op, options);
+        llvmModule = loadCachedModule(options, cacheKey, llvmContext, output.resourceEstimates);
+        cacheHit = llvmModule != nullptr;
+    }
+
+    if (cacheHit) {
+        CO_MSG(options, Verbosity::Debug, "Reusing cached module '" << cacheKey << "'\n");
+    }
+    else if (op) {
         if (failed(runLowering(options, &ctx, *op, output))) {
             CO_MSG(options, Verbosity::Urgent, "Failed to lower MLIR module\n");
             return failure();
@@ -459,12 +535,24 @@ LogicalResult QuantumDriverMain(const CompilerOptions &options, CompilerOutput &
     }
 
     if (llvmModule) {
-        if (failed(runLLVMPasses(options, llvmModule, output))) {
-            return failure();
-        }
+        if (!cacheHit) {
+            // Non-differentiated programs are fully optimized by a single O2 pipeline, the Enzyme
+            // pipeline is only needed if there are derivatives to generate.
+            bool differentiate = requiresDifferentiation(*llvmModule);
+            CO_MSG(options, Verbosity::Debug,
+                   (differentiate ? "Running" : "Skipping") << " the Enzyme pipeline\n");
 
-        if (failed(runEnzymePasses(options, llvmModule, output))) {
-            return failure();
+            if (failed(runLLVMPasses(options, llvmModule, output, differentiate))) {
+                return failure();
+            }
+
+            if (differentiate && failed(runEnzymePasses(options, llvmModule, output))) {
+                return failure();
+            }
+
+            if (!cacheKey.empty()) {
+                storeCachedModule(options, cacheKey, *llvmModule, output.resourceEstimates);
+            }
         }
 
         output.outIR.clear();
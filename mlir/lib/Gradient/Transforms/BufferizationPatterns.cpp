@@ -15,6 +15,7 @@
 #include "iostream"
 #include "llvm/Support/raw_ostream.h"
 
+#include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Dialect/Index/IR/IndexOps.h"
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
 #include "mlir/Dialect/Tensor/IR/Tensor.h"
@@ -71,18 +72,30 @@ class BufferizeAdjointOp : public OpConversionPattern<AdjointOp> {
         if (failed(getTypeConverter()->convertTypes(op.getResultTypes(), resTypes)))
             return failure();
 
+        // The results of the recorded execution, if any, precede the derivatives. They are
+        // returned by the callee together with the quantum register.
+        size_t numValues = 0;
+        auto callee = SymbolTable::lookupNearestSymbolFrom<func::FuncOp>(op, op.getCalleeAttr());
+        if (callee && callee.getNumResults() > 1) {
+            numValues = callee.getNumResults() - 1;
+        }
+        ArrayRef<Type> valueTypes = ArrayRef<Type>(resTypes).take_front(numValues);
+
         Location loc = op.getLoc();
         Value gradSize = op.getGradSize();
         SmallVector<Value> memrefValues;
-        for (Type resType : resTypes) {
+        for (Type resType : ArrayRef<Type>(resTypes).drop_front(numValues)) {
             MemRefType memrefType = resType.cast<MemRefType>();
             Value memrefValue = rewriter.create<memref::AllocOp>(loc, memrefType, gradSize);
             memrefValues.push_back(memrefValue);
         }
 
-        rewriter.create<AdjointOp>(loc, TypeRange{}, op.getCalleeAttr(), adaptor.getGradSize(),
-                                   adaptor.getArgs(), memrefValues);
-        rewriter.replaceOp(op, memrefValues);
+        auto bufferizedOp =
+            rewriter.create<AdjointOp>(loc, valueTypes, op.getCalleeAttr(), adaptor.getGradSize(),
+                                       adaptor.getArgs(), memrefValues);
+        SmallVector<Value> results{bufferizedOp.getResults()};
+        results.append(memrefValues);
+        rewriter.replaceOp(op, results);
         return success();
     }
 };
@@ -141,7 +154,7 @@ class BufferizeBackpropOp : public OpConversionPattern<BackpropOp> {
         DenseIntElementsAttr diffArgIndicesAttr = adaptor.getDiffArgIndices().value_or(nullptr);
         auto bufferizedBackpropOp = rewriter.create<BackpropOp>(
             loc, scalarReturnTypes, op.getCalleeAttr(), adaptor.getArgs(), argShadows,
-            calleeResults, resShadows, diffArgIndicesAttr);
+            calleeResults, resShadows, diffArgIndicesAttr, op.getCheckpointsAttr());
 
         // Fill in the null placeholders.
         for (const auto &[idx, scalarResult] : llvm::enumerate(bufferizedBackpropOp.getResults())) {
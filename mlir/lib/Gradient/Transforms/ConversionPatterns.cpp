@@ -79,21 +79,18 @@ struct AdjointOpPattern : public ConvertOpToLLVMPattern<AdjointOp> {
 
         Type vectorType = conv->convertType(MemRefType::get({UNKNOWN}, Float64Type::get(ctx)));
 
+        // The callee of the adjoint op must return the quantum register as its last result,
+        // preceded by the results of the execution returned by the adjoint op, if any.
+        func::FuncOp callee =
+            SymbolTable::lookupNearestSymbolFrom<func::FuncOp>(op, op.getCalleeAttr());
+        assert(callee && callee.getNumResults() == op.getNumResults() + 1 &&
+               "invalid qfunc symbol in adjoint op");
+
         for (Type type : op.getResultTypes()) {
-            if (!type.isa<MemRefType>())
+            if (isa<TensorType>(type))
                 return op.emitOpError("must be bufferized before lowering");
-
-            // Currently only expval gradients are supported by the runtime,
-            // leading to tensor<?xf64> return values.
-            if (type.dyn_cast<MemRefType>() != MemRefType::get({UNKNOWN}, Float64Type::get(ctx)))
-                return op.emitOpError("adjoint can only return MemRef<?xf64> or tuple thereof");
         }
 
-        // The callee of the adjoint op must return as a single result the quantum register.
-        func::FuncOp callee =
-            SymbolTable::lookupNearestSymbolFrom<func::FuncOp>(op, op.getCalleeAttr());
-        assert(callee && callee.getNumResults() == 1 && "invalid qfunc symbol in adjoint op");
-
         StringRef cacheFnName = "__quantum__rt__toggle_recorder";
         StringRef gradFnName = "__quantum__qis__Gradient";
         Type cacheFnSignature =
@@ -112,7 +109,8 @@ struct AdjointOpPattern : public ConvertOpToLLVMPattern<AdjointOp> {
         Value c_false = rewriter.create<LLVM::ConstantOp>(
             loc, rewriter.getIntegerAttr(IntegerType::get(ctx, 1), 0));
         rewriter.create<LLVM::CallOp>(loc, cacheFnDecl, c_true);
-        Value qreg = rewriter.create<func::CallOp>(loc, callee, op.getArgs()).getResult(0);
+        auto forward = rewriter.create<func::CallOp>(loc, callee, op.getArgs());
+        Value qreg = forward.getResults().back();
         if (!qreg.getType().isa<catalyst::quantum::QuregType>())
             return callee.emitOpError("qfunc must return quantum register");
         rewriter.create<LLVM::CallOp>(loc, cacheFnDecl, c_false);
@@ -135,7 +133,9 @@ struct AdjointOpPattern : public ConvertOpToLLVMPattern<AdjointOp> {
         rewriter.create<catalyst::quantum::DeallocOp>(loc, qreg);
         rewriter.create<catalyst::quantum::DeviceReleaseOp>(loc);
 
-        rewriter.eraseOp(op);
+        // The results of the recorded execution are computed from the same final state as the
+        // derivatives.
+        rewriter.replaceOp(op, forward.getResults().drop_back());
 
         return success();
     }
@@ -282,9 +282,21 @@ struct BackpropOpPattern : public ConvertOpToLLVMPattern<BackpropOp> {
 
                 wrapMemRefArgs(func, *getTypeConverter(), rewriter, loc, /*volatileArgs=*/true);
 
-                func::FuncOp augFwd = genAugmentedForward(func, rewriter);
-                func::FuncOp customQGrad =
-                    genCustomQGradient(func, func.getLoc(), qgradFn, rewriter);
+                func::FuncOp augFwd;
+                func::FuncOp customQGrad;
+                if (func->hasAttrOfType<FlatSymbolRefAttr>("gradient.fused_qgrad")) {
+                    // The quantum gradient is computed along with the results of the forward pass,
+                    // from the same execution, and passed to the reverse pass through the tape.
+                    auto fusedQGradFn = SymbolTable::lookupNearestSymbolFrom<func::FuncOp>(
+                        func, func->getAttrOfType<FlatSymbolRefAttr>("gradient.fused_qgrad"));
+                    augFwd = genFusedAugmentedForward(func, fusedQGradFn, rewriter);
+                    customQGrad =
+                        genFusedCustomQGradient(func, func.getLoc(), fusedQGradFn, rewriter);
+                }
+                else {
+                    augFwd = genAugmentedForward(func, rewriter);
+                    customQGrad = genCustomQGradient(func, func.getLoc(), qgradFn, rewriter);
+                }
                 insertEnzymeCustomGradient(rewriter, func->getParentOfType<ModuleOp>(),
                                            func.getLoc(), func, augFwd, customQGrad);
             }
@@ -593,26 +605,8 @@ struct BackpropOpPattern : public ConvertOpToLLVMPattern<BackpropOp> {
 
         SmallVector<Value> unwrappedInputs;
         SmallVector<Value> unwrappedShadows;
-
-        auto unwrapMemRef = [&](Value wrapped, Type unwrappedType) {
-            auto structType = getTypeConverter()->convertType(unwrappedType);
-            Value unwrapped = builder.create<LLVM::LoadOp>(loc, structType, wrapped);
-            unwrapped = builder.create<UnrealizedConversionCastOp>(loc, unwrappedType, unwrapped)
-                            .getResult(0);
-            return unwrapped;
-        };
-
-        for (const auto &[unwrappedType, arg, shadow] :
-             llvm::zip(qnodeType.getInputs(), primalArgs, shadowArgs)) {
-            if (isa<MemRefType>(unwrappedType)) {
-                unwrappedInputs.push_back(unwrapMemRef(arg, unwrappedType));
-                unwrappedShadows.push_back(unwrapMemRef(shadow, unwrappedType));
-            }
-            else {
-                assert(false && "non memref inputs not yet supported");
-                unwrappedInputs.push_back(arg);
-            }
-        }
+        unwrapInputs(builder, loc, qnodeType, primalArgs, unwrappedInputs);
+        unwrapInputs(builder, loc, qnodeType, shadowArgs, unwrappedShadows);
 
         SmallVector<Value> primalInputs{
             ValueRange{unwrappedInputs}.take_front(qgradFn.getNumArguments() - 1)};
@@ -623,7 +617,41 @@ struct BackpropOpPattern : public ConvertOpToLLVMPattern<BackpropOp> {
         primalInputs.push_back(pcount);
 
         auto qgrad = builder.create<func::CallOp>(loc, qgradFn, primalInputs);
+        applyQGradChainRule(builder, loc, qnodeType, block, qgrad.getResults(), gateParamShadow);
+        builder.create<func::ReturnOp>(loc);
+
+        return customQGrad;
+    }
+
+    /// Load the MemRef inputs of a QNode in destination passing style from their wrapped pointers.
+    void unwrapInputs(OpBuilder &builder, Location loc, FunctionType qnodeType,
+                      ValueRange wrappedArgs, SmallVectorImpl<Value> &unwrappedArgs) const
+    {
+        for (const auto &[unwrappedType, arg] : llvm::zip(qnodeType.getInputs(), wrappedArgs)) {
+            if (isa<MemRefType>(unwrappedType)) {
+                unwrappedArgs.push_back(unwrapMemRef(builder, loc, arg, unwrappedType));
+            }
+            else {
+                assert(false && "non memref inputs not yet supported");
+                unwrappedArgs.push_back(arg);
+            }
+        }
+    }
+
+    Value unwrapMemRef(OpBuilder &builder, Location loc, Value wrapped, Type unwrappedType) const
+    {
+        auto structType = getTypeConverter()->convertType(unwrappedType);
+        Value unwrapped = builder.create<LLVM::LoadOp>(loc, structType, wrapped);
+        unwrapped =
+            builder.create<UnrealizedConversionCastOp>(loc, unwrappedType, unwrapped).getResult(0);
+        return unwrapped;
+    }
 
+    /// Accumulate into the `gateParamShadow` the product of the quantum gradient `qgrads` of the
+    /// QNode with the shadows of its results, which are arguments of the custom gradient `block`.
+    void applyQGradChainRule(OpBuilder &builder, Location loc, FunctionType qnodeType,
+                             Block *block, ValueRange qgrads, Value gateParamShadow) const
+    {
         for (unsigned i = 0; i < qnodeType.getNumResults(); i++) {
             // The QNode has n inputs and m outputs (in destination-passing style).
             // The customQGrad arguments are: [
@@ -635,8 +663,8 @@ struct BackpropOpPattern : public ConvertOpToLLVMPattern<BackpropOp> {
             //   outprimal_m, outshadow_m
             // ]
             // This indexing extracts [outshadow_0, ..., outshadow_m]
-            Value resultShadow = unwrapMemRef(
-                block->getArgument((i + qnodeType.getNumInputs()) * 2 + 1), qnodeType.getResult(i));
+            Value wrappedShadow = block->getArgument((i + qnodeType.getNumInputs()) * 2 + 1);
+            Value resultShadow = unwrapMemRef(builder, loc, wrappedShadow, qnodeType.getResult(i));
 
             // If G is the number of gate params and [...result] is the shape of the result with
             // rank R:
@@ -647,7 +675,7 @@ struct BackpropOpPattern : public ConvertOpToLLVMPattern<BackpropOp> {
             // einsum to propagate the chain rule should thus be:
             //   [1,...,R], [0,1,...,R] -> [0]
             SmallVector<int64_t> qgradDims;
-            int64_t qgradRank = cast<ShapedType>(qgrad.getType(i)).getRank();
+            int64_t qgradRank = cast<ShapedType>(qgrads[i].getType()).getRank();
             for (int64_t i = 0; i < qgradRank; i++) {
                 qgradDims.push_back(i);
             }
@@ -657,8 +685,174 @@ struct BackpropOpPattern : public ConvertOpToLLVMPattern<BackpropOp> {
             // all results (this is due to the multivariate chain rule; derivatives combine
             // additively).
             catalyst::einsumLinalgGeneric(builder, loc, resultDims, qgradDims, {0}, resultShadow,
-                                          qgrad.getResult(i), gateParamShadow);
+                                          qgrads[i], gateParamShadow);
+        }
+    }
+
+    /// The tape of the fused custom gradient is a heap-allocated struct holding the descriptors of
+    /// the quantum gradient of each result of the QNode.
+    LLVM::LLVMStructType getFusedTapeStructType(func::FuncOp qnode,
+                                                func::FuncOp fusedQGradFn) const
+    {
+        auto qnodeType =
+            cast<FunctionType>(qnode->getAttrOfType<TypeAttr>("unwrapped_type").getValue());
+        SmallVector<Type> fieldTypes;
+        for (Type qgradType :
+             fusedQGradFn.getResultTypes().drop_front(qnodeType.getNumResults())) {
+            fieldTypes.push_back(getTypeConverter()->convertType(qgradType));
+        }
+        return LLVM::LLVMStructType::getLiteral(qnode.getContext(), fieldTypes);
+    }
+
+    /// Generate an augmented forward pass that executes the QNode once through `fusedQGradFn`,
+    /// which records the execution and computes the quantum gradient from the same final state.
+    /// The results are written to the output arguments of the QNode, and the quantum gradient is
+    /// passed to the reverse pass through the tape. This saves the forward execution of the
+    /// circuit in the reverse pass.
+    func::FuncOp genFusedAugmentedForward(func::FuncOp qnode, func::FuncOp fusedQGradFn,
+                                          OpBuilder &builder) const
+    {
+        std::string augmentedName = (qnode.getName() + ".augfwd").str();
+        auto augmentedForward = SymbolTable::lookupNearestSymbolFrom<func::FuncOp>(
+            qnode, builder.getStringAttr(augmentedName));
+        if (augmentedForward) {
+            return augmentedForward;
+        }
+        assert(qnode.getNumResults() == 0 && "Expected QNode to be in destination-passing style");
+        MLIRContext *ctx = builder.getContext();
+        ModuleOp moduleOp = qnode->getParentOfType<ModuleOp>();
+        OpBuilder::InsertionGuard insertionGuard(builder);
+        builder.setInsertionPointAfter(qnode);
+        auto tapeType = LLVM::LLVMPointerType::get(ctx);
+        auto qnodeType =
+            cast<FunctionType>(qnode->getAttrOfType<TypeAttr>("unwrapped_type").getValue());
+        SmallVector<Type> argTypes;
+        convertCustomGradArgumentTypes(qnode.getArgumentTypes(), argTypes);
+        augmentedForward = builder.create<func::FuncOp>(
+            qnode.getLoc(), augmentedName, FunctionType::get(ctx, argTypes, {tapeType}));
+        augmentedForward.setPrivate();
+        Location loc = qnode.getLoc();
+
+        Block *entry = augmentedForward.addEntryBlock();
+        builder.setInsertionPointToStart(entry);
+
+        // Every other argument is a shadow
+        SmallVector<Value> primalArgs;
+        for (unsigned i = 0; i < qnodeType.getNumInputs(); i++) {
+            primalArgs.push_back(entry->getArgument(i * 2));
+        }
+
+        SmallVector<Value> unwrappedInputs;
+        unwrapInputs(builder, loc, qnodeType, primalArgs, unwrappedInputs);
+
+        SmallVector<Value> fusedInputs{
+            ValueRange{unwrappedInputs}.take_front(fusedQGradFn.getNumArguments() - 1)};
+        Value gateParams = unwrappedInputs.back();
+        assert(cast<MemRefType>(gateParams.getType()).getRank() == 1 &&
+               "Expected gate parameter list to be a rank-1 memref");
+        fusedInputs.push_back(builder.create<memref::DimOp>(loc, gateParams, 0));
+
+        auto fused = builder.create<func::CallOp>(loc, fusedQGradFn, fusedInputs);
+        ValueRange results = fused.getResults().take_front(qnodeType.getNumResults());
+        ValueRange qgrads = fused.getResults().drop_front(qnodeType.getNumResults());
+
+        for (const auto &[i, result] : llvm::enumerate(results)) {
+            // The output arguments follow the input arguments, see genCustomQGradient.
+            Value output =
+                unwrapMemRef(builder, loc, entry->getArgument((i + qnodeType.getNumInputs()) * 2),
+                             qnodeType.getResult(i));
+            if (isa<MemRefType>(result.getType())) {
+                // The result buffers are allocated by the fused adjoint, and no longer needed
+                // once copied into the output arguments.
+                builder.create<memref::CopyOp>(loc, result, output);
+                builder.create<memref::DeallocOp>(loc, result);
+            }
+            else {
+                builder.create<memref::StoreOp>(loc, result, output);
+            }
+        }
+
+        // Store the descriptors of the quantum gradient in the tape.
+        LLVM::LLVMStructType tapeStructType = getFusedTapeStructType(qnode, fusedQGradFn);
+        Type indexType = getTypeConverter()->getIndexType();
+        LLVM::LLVMFuncOp mallocFn = LLVM::lookupOrCreateMallocFn(
+            moduleOp, indexType, getTypeConverter()->getOptions().useOpaquePointers);
+        Value nullPtr = builder.create<LLVM::NullOp>(loc, tapeType);
+        Value tapeEnd = builder.create<LLVM::GEPOp>(loc, tapeType, tapeStructType, nullPtr,
+                                                    ArrayRef<LLVM::GEPArg>{1});
+        Value tapeSize = builder.create<LLVM::PtrToIntOp>(loc, indexType, tapeEnd);
+        Value tape = builder.create<LLVM::CallOp>(loc, mallocFn, tapeSize).getResult();
+
+        Value tapeStruct = builder.create<LLVM::UndefOp>(loc, tapeStructType);
+        for (const auto &[i, qgrad] : llvm::enumerate(qgrads)) {
+            Value qgradStruct = castToConvertedType(qgrad, builder, loc);
+            tapeStruct = builder.create<LLVM::InsertValueOp>(loc, tapeStruct, qgradStruct, i);
+        }
+        builder.create<LLVM::StoreOp>(loc, tapeStruct, tape);
+        builder.create<func::ReturnOp>(loc, tape);
+        return augmentedForward;
+    }
+
+    /// Generate the custom gradient matching `genFusedAugmentedForward`. The quantum gradient is
+    /// read from the tape instead of executing the circuit again, and freed once the chain rule is
+    /// applied.
+    func::FuncOp genFusedCustomQGradient(func::FuncOp qnode, Location loc,
+                                         func::FuncOp fusedQGradFn, OpBuilder &builder) const
+    {
+        std::string customQGradName = (qnode.getName() + ".customqgrad").str();
+        auto customQGrad = SymbolTable::lookupNearestSymbolFrom<func::FuncOp>(
+            qnode, builder.getStringAttr(customQGradName));
+        if (customQGrad) {
+            return customQGrad;
+        }
+
+        MLIRContext *ctx = builder.getContext();
+        ModuleOp moduleOp = qnode->getParentOfType<ModuleOp>();
+        auto tapeType = LLVM::LLVMPointerType::get(ctx);
+        SmallVector<Type> argTypes;
+        convertCustomGradArgumentTypes(qnode.getArgumentTypes(), argTypes);
+        argTypes.push_back(tapeType);
+        auto qnodeType =
+            cast<FunctionType>(qnode->getAttrOfType<TypeAttr>("unwrapped_type").getValue());
+
+        OpBuilder::InsertionGuard insertionGuard(builder);
+        builder.setInsertionPoint(qnode);
+        auto funcType = FunctionType::get(ctx, argTypes, {});
+        customQGrad = builder.create<func::FuncOp>(qnode.getLoc(), customQGradName, funcType);
+        customQGrad.setPrivate();
+        Block *block = customQGrad.addEntryBlock();
+        builder.setInsertionPointToStart(block);
+
+        SmallVector<Value> shadowArgs;
+        for (unsigned i = 0; i < qnodeType.getNumInputs(); i++) {
+            shadowArgs.push_back(block->getArgument(i * 2 + 1));
+        }
+        SmallVector<Value> unwrappedShadows;
+        unwrapInputs(builder, loc, qnodeType, shadowArgs, unwrappedShadows);
+        Value gateParamShadow = unwrappedShadows.back();
+
+        Value tape = block->getArguments().back();
+        LLVM::LLVMStructType tapeStructType = getFusedTapeStructType(qnode, fusedQGradFn);
+        Value tapeStruct = builder.create<LLVM::LoadOp>(loc, tapeStructType, tape);
+
+        SmallVector<Value> qgrads;
+        for (const auto &[i, qgradType] : llvm::enumerate(
+                 fusedQGradFn.getResultTypes().drop_front(qnodeType.getNumResults()))) {
+            Value qgradStruct = builder.create<LLVM::ExtractValueOp>(loc, tapeStruct, i);
+            qgrads.push_back(
+                builder.create<UnrealizedConversionCastOp>(loc, qgradType, qgradStruct)
+                    .getResult(0));
+        }
+
+        applyQGradChainRule(builder, loc, qnodeType, block, qgrads, gateParamShadow);
+
+        // The quantum gradient buffers are allocated by the bufferization of the adjoint op.
+        for (Value qgrad : qgrads) {
+            builder.create<memref::DeallocOp>(loc, qgrad);
         }
+        LLVM::LLVMFuncOp freeFn = LLVM::lookupOrCreateFreeFn(
+            moduleOp, getTypeConverter()->getOptions().useOpaquePointers);
+        builder.create<LLVM::CallOp>(loc, freeFn, tape);
         builder.create<func::ReturnOp>(loc);
 
         return customQGrad;
@@ -45,12 +45,17 @@ void AdjointLowering::rewrite(func::FuncOp op, PatternRewriter &rewriter) const
     // computation.
     func::FuncOp qGradFn = genQGradFunction(rewriter, loc, op);
 
+    // Generate the value-and-gradient function, which computes the results of the QNode and its
+    // quantum gradient from the same recorded execution.
+    func::FuncOp fusedQGradFn = genFusedQGradFunction(rewriter, loc, op);
+
     // Register the quantum gradient on the quantum-only split-out QNode.
-    registerCustomGradient(op, FlatSymbolRefAttr::get(qGradFn));
+    registerCustomGradient(op, FlatSymbolRefAttr::get(qGradFn),
+                           FlatSymbolRefAttr::get(fusedQGradFn));
 }
 
 func::FuncOp AdjointLowering::discardAndReturnReg(PatternRewriter &rewriter, Location loc,
-                                                  func::FuncOp callee)
+                                                  func::FuncOp callee, bool keepResults)
 {
     SmallVector<quantum::DeallocOp> deallocs;
     for (auto op : callee.getOps<quantum::DeallocOp>()) {
@@ -67,11 +72,17 @@ func::FuncOp AdjointLowering::discardAndReturnReg(PatternRewriter &rewriter, Loc
         return callee;
     }
 
-    // Since the return value is guaranteed to be discarded, then let's change the return type
-    // to be only the quantum register.
-    std::string fnName = callee.getName().str() + ".nodealloc";
+    // Unless the results are kept, the return value is guaranteed to be discarded, then let's
+    // change the return type to be only the quantum register. Otherwise, the quantum register is
+    // returned after the results.
+    std::string fnName = callee.getName().str() + (keepResults ? ".withreg" : ".nodealloc");
     Type qregType = quantum::QuregType::get(rewriter.getContext());
-    FunctionType fnType = rewriter.getFunctionType(callee.getArgumentTypes(), qregType);
+    SmallVector<Type> resultTypes;
+    if (keepResults) {
+        resultTypes.append(callee.getResultTypes().begin(), callee.getResultTypes().end());
+    }
+    resultTypes.push_back(qregType);
+    FunctionType fnType = rewriter.getFunctionType(callee.getArgumentTypes(), resultTypes);
     StringAttr visibility = rewriter.getStringAttr("private");
 
     func::FuncOp unallocFn =
@@ -95,7 +106,12 @@ func::FuncOp AdjointLowering::discardAndReturnReg(PatternRewriter &rewriter, Loc
                 rewriter.eraseOp(op);
             }
             else if (isa<func::ReturnOp>(op)) {
-                op->setOperands(localDealloc.getOperand());
+                SmallVector<Value> operands;
+                if (keepResults) {
+                    operands.append(op->operand_begin(), op->operand_end());
+                }
+                operands.push_back(localDealloc.getOperand());
+                op->setOperands(operands);
             }
         });
 
@@ -138,5 +154,42 @@ func::FuncOp AdjointLowering::genQGradFunction(PatternRewriter &rewriter, Locati
     return qGradFn;
 }
 
+func::FuncOp AdjointLowering::genFusedQGradFunction(PatternRewriter &rewriter, Location loc,
+                                                    func::FuncOp callee)
+{
+    func::FuncOp withRegFn = discardAndReturnReg(rewriter, loc, callee, /*keepResults=*/true);
+
+    std::string fnName = callee.getName().str() + ".fusedadjoint";
+    std::vector<Type> fnArgTypes = callee.getArgumentTypes().vec();
+    Type gradientSizeType = rewriter.getIndexType();
+    fnArgTypes.push_back(gradientSizeType);
+
+    // The results of the QNode are followed by its quantum gradient.
+    std::vector<Type> fnResultTypes = callee.getResultTypes().vec();
+    std::vector<Type> qGradTypes = computeQGradTypes(callee);
+    fnResultTypes.insert(fnResultTypes.end(), qGradTypes.begin(), qGradTypes.end());
+    FunctionType fnType = rewriter.getFunctionType(fnArgTypes, fnResultTypes);
+    StringAttr visibility = rewriter.getStringAttr("private");
+
+    func::FuncOp fusedQGradFn =
+        SymbolTable::lookupNearestSymbolFrom<func::FuncOp>(callee, rewriter.getStringAttr(fnName));
+    if (!fusedQGradFn) {
+        PatternRewriter::InsertionGuard insertGuard(rewriter);
+        rewriter.setInsertionPointAfter(callee);
+
+        fusedQGradFn =
+            rewriter.create<func::FuncOp>(loc, fnName, fnType, visibility, nullptr, nullptr);
+        rewriter.setInsertionPointToStart(fusedQGradFn.addEntryBlock());
+
+        AdjointOp qGradOp = rewriter.create<AdjointOp>(
+            loc, fnResultTypes, withRegFn.getName(), fusedQGradFn.getArguments().back(),
+            fusedQGradFn.getArguments().drop_back(), ValueRange{});
+
+        rewriter.create<func::ReturnOp>(loc, qGradOp.getResults());
+    }
+
+    return fusedQGradFn;
+}
+
 } // namespace gradient
 } // namespace catalyst
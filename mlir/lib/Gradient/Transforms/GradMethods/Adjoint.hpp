@@ -31,8 +31,10 @@ struct AdjointLowering : public OpRewritePattern<func::FuncOp> {
   private:
     static func::FuncOp genQGradFunction(PatternRewriter &rewriter, Location loc,
                                          func::FuncOp callee);
+    static func::FuncOp genFusedQGradFunction(PatternRewriter &rewriter, Location loc,
+                                              func::FuncOp callee);
     static func::FuncOp discardAndReturnReg(PatternRewriter &rewriter, Location loc,
-                                            func::FuncOp callee);
+                                            func::FuncOp callee, bool keepResults = false);
 };
 
 } // namespace gradient
@@ -295,6 +295,9 @@ func::FuncOp HybridGradientLowering::genFullGradFunction(PatternRewriter &rewrit
     std::stringstream uniquer;
     std::copy(diffArgIndices.begin(), diffArgIndices.end(), std::ostream_iterator<int>(uniquer));
     std::string fnName = gradOp.getCallee().str() + ".fullgrad" + uniquer.str();
+    if (std::optional<uint64_t> checkpoints = gradOp.getCheckpoints()) {
+        fnName += ".checkpoints" + std::to_string(*checkpoints);
+    }
 
     func::FuncOp fullGradFn =
         SymbolTable::lookupNearestSymbolFrom<func::FuncOp>(gradOp, rewriter.getStringAttr(fnName));
@@ -341,7 +344,7 @@ func::FuncOp HybridGradientLowering::genFullGradFunction(PatternRewriter &rewrit
                             entryBlock->getArguments(),
                             /*arg_shadows=*/ValueRange{},
                             /*primal results=*/ValueRange{}, cotangents,
-                            gradOp.getDiffArgIndicesAttr());
+                            gradOp.getDiffArgIndicesAttr(), gradOp.getCheckpointsAttr());
 
                         // Backprop gives a gradient of a single output entry w.r.t.
                         // all active inputs. Catalyst gives transposed Jacobians,
@@ -402,7 +405,7 @@ func::FuncOp HybridGradientLowering::genFullGradFunction(PatternRewriter &rewrit
                     loc, computeBackpropTypes(callee, diffArgIndices), callee.getName(),
                     entryBlock->getArguments(),
                     /*arg_shadows=*/ValueRange{}, /*primal results=*/ValueRange{}, cotangents,
-                    gradOp.getDiffArgIndicesAttr());
+                    gradOp.getDiffArgIndicesAttr(), gradOp.getCheckpointsAttr());
                 for (const auto &[backpropIdx, jacobianSlice] :
                      llvm::enumerate(backpropOp.getResults())) {
                     size_t resultIdx = backpropIdx * callee.getNumResults() + cotangentIdx;
@@ -97,7 +97,7 @@ LogicalResult JVPLoweringPattern::matchAndRewrite(JVPOp op, PatternRewriter &rew
 
     auto gradOp = rewriter.create<GradOp>(loc, grad_result_types, op.getMethod(), op.getCallee(),
                                           calleeOperands, op.getDiffArgIndicesAttr(),
-                                          op.getFiniteDiffParamAttr());
+                                          op.getFiniteDiffParamAttr(), /*checkpoints=*/nullptr);
 
     std::vector<Value> einsumResults;
     for (size_t nout = 0; nout < funcResultTypes.size(); nout++) {
@@ -219,7 +219,7 @@ LogicalResult VJPLoweringPattern::matchAndRewrite(VJPOp op, PatternRewriter &rew
 
     auto gradOp = rewriter.create<GradOp>(loc, grad_result_types, op.getMethod(), op.getCallee(),
                                           calleeOperands, op.getDiffArgIndicesAttr(),
-                                          op.getFiniteDiffParamAttr());
+                                          op.getFiniteDiffParamAttr(), /*checkpoints=*/nullptr);
 
     std::vector<Value> einsumResults;
     for (size_t nparam = 0; nparam < func_diff_operand_indices.size(); nparam++) {
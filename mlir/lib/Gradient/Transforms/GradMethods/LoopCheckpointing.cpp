@@ -0,0 +1,407 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define DEBUG_TYPE "checkpointing"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "llvm/Support/Debug.h"
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+
+#include "Gradient/Utils/GradientShape.h"
+
+#include "LoopCheckpointing.hpp"
+
+using namespace mlir;
+using llvm::dbgs;
+
+namespace catalyst {
+namespace gradient {
+
+namespace {
+
+/// Ops preceding the checkpointed loop are recomputed wherever their results are needed, which
+/// requires them to be free of side effects. Their results must not carry derivatives, except for
+/// constants.
+bool isRecomputable(Operation *op)
+{
+    if (!isPure(op) || op->getNumRegions() != 0) {
+        return false;
+    }
+    if (op->hasTrait<OpTrait::ConstantLike>()) {
+        return true;
+    }
+    return llvm::none_of(op->getResultTypes(), [](Type type) { return isDifferentiable(type); });
+}
+
+/// The values carried by the checkpointed loop are stacked in tensors, and are the arguments
+/// differentiated by the backpropagation of a segment.
+bool isCheckpointable(Type type)
+{
+    if (isa<FloatType>(type)) {
+        return true;
+    }
+    auto tensorType = dyn_cast<RankedTensorType>(type);
+    return tensorType && tensorType.hasStaticShape() && isa<FloatType>(tensorType.getElementType());
+}
+
+/// Find the first loop of the callee, provided all the ops preceding it are recomputable.
+scf::ForOp findCheckpointedLoop(func::FuncOp callee)
+{
+    if (!callee.getBody().hasOneBlock()) {
+        return nullptr;
+    }
+    for (Operation &op : callee.getBody().front()) {
+        if (auto loop = dyn_cast<scf::ForOp>(op)) {
+            return llvm::all_of(loop.getResultTypes(), isCheckpointable) ? loop : nullptr;
+        }
+        if (!isRecomputable(&op)) {
+            return nullptr;
+        }
+    }
+    return nullptr;
+}
+
+/// Clone the ops preceding `loop` in the callee, whose arguments are already mapped.
+void clonePrologue(OpBuilder &builder, scf::ForOp loop, IRMapping &mapping)
+{
+    for (Operation *op = &loop->getBlock()->front(); op != loop.getOperation();
+         op = op->getNextNode()) {
+        builder.clone(*op, mapping);
+    }
+}
+
+RankedTensorType getStackType(Type type, int64_t numCheckpoints)
+{
+    SmallVector<int64_t> shape{numCheckpoints};
+    if (auto tensorType = dyn_cast<RankedTensorType>(type)) {
+        shape.append(tensorType.getShape().begin(), tensorType.getShape().end());
+        return RankedTensorType::get(shape, tensorType.getElementType());
+    }
+    return RankedTensorType::get(shape, type);
+}
+
+/// Compute the offsets, sizes and strides of the `index`-th checkpoint of a stack of tensors.
+void getCheckpointSlice(OpBuilder &builder, RankedTensorType type, Value index,
+                        SmallVectorImpl<OpFoldResult> &offsets,
+                        SmallVectorImpl<OpFoldResult> &sizes,
+                        SmallVectorImpl<OpFoldResult> &strides)
+{
+    offsets.push_back(index);
+    offsets.append(type.getRank(), builder.getIndexAttr(0));
+    sizes.push_back(builder.getIndexAttr(1));
+    for (int64_t dim : type.getShape()) {
+        sizes.push_back(builder.getIndexAttr(dim));
+    }
+    strides.append(type.getRank() + 1, builder.getIndexAttr(1));
+}
+
+Value storeCheckpoint(OpBuilder &builder, Location loc, Value value, Value stack, Value index)
+{
+    auto tensorType = dyn_cast<RankedTensorType>(value.getType());
+    if (!tensorType) {
+        return builder.create<tensor::InsertOp>(loc, value, stack, index);
+    }
+    SmallVector<OpFoldResult> offsets, sizes, strides;
+    getCheckpointSlice(builder, tensorType, index, offsets, sizes, strides);
+    return builder.create<tensor::InsertSliceOp>(loc, value, stack, offsets, sizes, strides);
+}
+
+Value loadCheckpoint(OpBuilder &builder, Location loc, Type type, Value stack, Value index)
+{
+    auto tensorType = dyn_cast<RankedTensorType>(type);
+    if (!tensorType) {
+        return builder.create<tensor::ExtractOp>(loc, stack, index);
+    }
+    SmallVector<OpFoldResult> offsets, sizes, strides;
+    getCheckpointSlice(builder, tensorType, index, offsets, sizes, strides);
+    return builder.create<tensor::ExtractSliceOp>(loc, tensorType, stack, offsets, sizes, strides);
+}
+
+/// BackpropOps return the derivatives of scalar arguments as scalars, but take the cotangents of
+/// scalar results as point tensors.
+Value toCotangent(OpBuilder &builder, Location loc, Value adjoint)
+{
+    if (isa<RankedTensorType>(adjoint.getType())) {
+        return adjoint;
+    }
+    auto pointTensorType = RankedTensorType::get({}, adjoint.getType());
+    return builder.create<tensor::FromElementsOp>(loc, pointTensorType, adjoint);
+}
+
+Value toIndex(OpBuilder &builder, Location loc, Value value)
+{
+    if (value.getType().isIndex()) {
+        return value;
+    }
+    return builder.create<arith::IndexCastOp>(loc, builder.getIndexType(), value);
+}
+
+DenseIntElementsAttr getDiffArgIndicesAttr(OpBuilder &builder,
+                                           const std::vector<size_t> &diffArgIndices)
+{
+    return builder.getI64TensorAttr(
+        SmallVector<int64_t>(diffArgIndices.begin(), diffArgIndices.end()));
+}
+
+} // namespace
+
+func::FuncOp BackpropCheckpointingPattern::genSegmentFunction(PatternRewriter &rewriter,
+                                                              func::FuncOp callee, scf::ForOp loop)
+{
+    std::string fnName = (callee.getName() + ".segment").str();
+    func::FuncOp segmentFn =
+        SymbolTable::lookupNearestSymbolFrom<func::FuncOp>(callee, rewriter.getStringAttr(fnName));
+    if (segmentFn) {
+        return segmentFn;
+    }
+
+    Location loc = loop.getLoc();
+    Type boundType = loop.getLowerBound().getType();
+    SmallVector<Type> fnArgTypes{boundType, boundType};
+    fnArgTypes.append(loop.getResultTypes().begin(), loop.getResultTypes().end());
+    fnArgTypes.append(callee.getArgumentTypes().begin(), callee.getArgumentTypes().end());
+    FunctionType fnType = rewriter.getFunctionType(fnArgTypes, loop.getResultTypes());
+
+    PatternRewriter::InsertionGuard insertGuard(rewriter);
+    rewriter.setInsertionPointAfter(callee);
+    segmentFn = rewriter.create<func::FuncOp>(loc, fnName, fnType);
+    segmentFn.setPrivate();
+    Block *entryBlock = segmentFn.addEntryBlock();
+    rewriter.setInsertionPointToStart(entryBlock);
+
+    const size_t numStates = loop.getNumResults();
+    IRMapping mapping;
+    mapping.map(callee.getArguments(), entryBlock->getArguments().drop_front(2 + numStates));
+    clonePrologue(rewriter, loop, mapping);
+
+    auto segment = rewriter.create<scf::ForOp>(
+        loc, entryBlock->getArgument(0), entryBlock->getArgument(1),
+        mapping.lookupOrDefault(loop.getStep()), entryBlock->getArguments().slice(2, numStates),
+        [&](OpBuilder &builder, Location loc, Value inductionVar, ValueRange iterArgs) {
+            mapping.map(loop.getInductionVar(), inductionVar);
+            mapping.map(loop.getRegionIterArgs(), iterArgs);
+            for (Operation &op : *loop.getBody()) {
+                builder.clone(op, mapping);
+            }
+        });
+    rewriter.create<func::ReturnOp>(loc, segment.getResults());
+    return segmentFn;
+}
+
+func::FuncOp BackpropCheckpointingPattern::genEpilogueFunction(PatternRewriter &rewriter,
+                                                               func::FuncOp callee,
+                                                               scf::ForOp loop)
+{
+    std::string fnName = (callee.getName() + ".epilogue").str();
+    func::FuncOp epilogueFn =
+        SymbolTable::lookupNearestSymbolFrom<func::FuncOp>(callee, rewriter.getStringAttr(fnName));
+    if (epilogueFn) {
+        return epilogueFn;
+    }
+
+    SmallVector<Type> fnArgTypes(callee.getArgumentTypes());
+    fnArgTypes.append(loop.getResultTypes().begin(), loop.getResultTypes().end());
+    FunctionType fnType = rewriter.getFunctionType(fnArgTypes, callee.getResultTypes());
+
+    PatternRewriter::InsertionGuard insertGuard(rewriter);
+    rewriter.setInsertionPointAfter(callee);
+    epilogueFn = rewriter.create<func::FuncOp>(loop.getLoc(), fnName, fnType);
+    epilogueFn.setPrivate();
+    Block *entryBlock = epilogueFn.addEntryBlock();
+    rewriter.setInsertionPointToStart(entryBlock);
+
+    const size_t numArgs = callee.getNumArguments();
+    IRMapping mapping;
+    mapping.map(callee.getArguments(), entryBlock->getArguments().take_front(numArgs));
+    clonePrologue(rewriter, loop, mapping);
+    mapping.map(loop.getResults(), entryBlock->getArguments().drop_front(numArgs));
+    for (Operation *op = loop->getNextNode(); op != nullptr; op = op->getNextNode()) {
+        rewriter.clone(*op, mapping);
+    }
+    return epilogueFn;
+}
+
+LogicalResult BackpropCheckpointingPattern::matchAndRewrite(BackpropOp op,
+                                                            PatternRewriter &rewriter) const
+{
+    // Checkpointing applies to BackpropOps with tensor semantics, before bufferization.
+    IntegerAttr checkpointsAttr = op.getCheckpointsAttr();
+    if (!checkpointsAttr || !op.getDiffArgShadows().empty() || !op.getCalleeResults().empty()) {
+        return failure();
+    }
+
+    func::FuncOp callee =
+        SymbolTable::lookupNearestSymbolFrom<func::FuncOp>(op, op.getCalleeAttr());
+    scf::ForOp loop = callee ? findCheckpointedLoop(callee) : nullptr;
+    if (!loop) {
+        return failure();
+    }
+
+    LLVM_DEBUG(dbgs() << "checkpointing the loop of " << callee.getName() << "\n");
+
+    Location loc = op.getLoc();
+    const int64_t numCheckpoints = checkpointsAttr.getInt();
+    const size_t numArgs = callee.getNumArguments();
+    const size_t numStates = loop.getNumResults();
+    const std::vector<size_t> &diffArgIndices = computeDiffArgIndices(op.getDiffArgIndices());
+
+    func::FuncOp segmentFn = genSegmentFunction(rewriter, callee, loop);
+    func::FuncOp epilogueFn = genEpilogueFunction(rewriter, callee, loop);
+
+    // Recompute the operands of the loop from the arguments of the BackpropOp.
+    IRMapping mapping;
+    mapping.map(callee.getArguments(), op.getArgs());
+    clonePrologue(rewriter, loop, mapping);
+    Value lowerBound = mapping.lookupOrDefault(loop.getLowerBound());
+    Value upperBound = mapping.lookupOrDefault(loop.getUpperBound());
+    Value step = mapping.lookupOrDefault(loop.getStep());
+    SmallVector<Value> initArgs;
+    for (Value initArg : loop.getInitArgs()) {
+        initArgs.push_back(mapping.lookupOrDefault(initArg));
+    }
+
+    // The iterations are split into `numCheckpoints` segments of `segmentSize` iterations, the last
+    // ones being shorter or empty when the iterations do not divide evenly.
+    Type boundType = lowerBound.getType();
+    auto createBound = [&](int64_t value) -> Value {
+        return rewriter.create<arith::ConstantOp>(loc, rewriter.getIntegerAttr(boundType, value));
+    };
+    Value zero = createBound(0);
+    Value one = createBound(1);
+    Value numSegments = createBound(numCheckpoints);
+    Value lastSegment = createBound(numCheckpoints - 1);
+    Value numIterations = rewriter.create<arith::CeilDivSIOp>(
+        loc, rewriter.create<arith::SubIOp>(loc, upperBound, lowerBound), step);
+    Value segmentSize = rewriter.create<arith::MaxSIOp>(
+        loc, rewriter.create<arith::CeilDivSIOp>(loc, numIterations, numSegments), zero);
+    Value segmentStride = rewriter.create<arith::MulIOp>(loc, segmentSize, step);
+    auto getSegmentArgs = [&](OpBuilder &builder, Value segment, ValueRange states) {
+        Value segmentLowerBound = builder.create<arith::AddIOp>(
+            loc, lowerBound, builder.create<arith::MulIOp>(loc, segment, segmentStride));
+        Value segmentUpperBound = builder.create<arith::MinSIOp>(
+            loc, upperBound, builder.create<arith::AddIOp>(loc, segmentLowerBound, segmentStride));
+        SmallVector<Value> segmentArgs{segmentLowerBound, segmentUpperBound};
+        segmentArgs.append(states.begin(), states.end());
+        segmentArgs.append(op.getArgs().begin(), op.getArgs().end());
+        return segmentArgs;
+    };
+
+    // Forward pass: run the segments, storing the loop-carried values at the start of each one.
+    SmallVector<Value> forwardArgs(initArgs);
+    for (Type stateType : loop.getResultTypes()) {
+        forwardArgs.push_back(rewriter.create<tensor::EmptyOp>(
+            loc, getStackType(stateType, numCheckpoints), ValueRange{}));
+    }
+    auto forward = rewriter.create<scf::ForOp>(
+        loc, zero, numSegments, one, forwardArgs,
+        [&](OpBuilder &builder, Location loc, Value segment, ValueRange iterArgs) {
+            ValueRange states = iterArgs.take_front(numStates);
+            Value index = toIndex(builder, loc, segment);
+            auto call = builder.create<func::CallOp>(loc, segmentFn,
+                                                     getSegmentArgs(builder, segment, states));
+
+            SmallVector<Value> yieldedValues(call.getResults());
+            for (auto [state, stack] : llvm::zip(states, iterArgs.drop_front(numStates))) {
+                yieldedValues.push_back(storeCheckpoint(builder, loc, state, stack, index));
+            }
+            builder.create<scf::YieldOp>(loc, yieldedValues);
+        });
+    ValueRange finalStates = forward.getResults().take_front(numStates);
+    ValueRange stacks = forward.getResults().drop_front(numStates);
+
+    // Backpropagate the cotangents through the ops following the loop, which may hold further
+    // loops to checkpoint.
+    SmallVector<Value> epilogueArgs(op.getArgs());
+    epilogueArgs.append(finalStates.begin(), finalStates.end());
+    std::vector<size_t> epilogueDiffArgIndices(diffArgIndices);
+    for (size_t idx = 0; idx < numStates; idx++) {
+        epilogueDiffArgIndices.push_back(numArgs + idx);
+    }
+    auto epilogueBackprop = rewriter.create<BackpropOp>(
+        loc, computeBackpropTypes(epilogueFn, epilogueDiffArgIndices), epilogueFn.getName(),
+        epilogueArgs, /*arg_shadows=*/ValueRange{}, /*primal results=*/ValueRange{},
+        op.getCotangents(), getDiffArgIndicesAttr(rewriter, epilogueDiffArgIndices),
+        checkpointsAttr);
+
+    // Reverse pass: backpropagate through the segments in reverse order, each one being recomputed
+    // from its checkpoint. The derivatives of the arguments of the callee are accumulated.
+    std::vector<size_t> segmentDiffArgIndices;
+    for (size_t idx = 0; idx < numStates; idx++) {
+        segmentDiffArgIndices.push_back(2 + idx);
+    }
+    for (size_t idx : diffArgIndices) {
+        segmentDiffArgIndices.push_back(2 + numStates + idx);
+    }
+    SmallVector<Value> reverseArgs(epilogueBackprop.getResults().drop_front(diffArgIndices.size()));
+    reverseArgs.append(epilogueBackprop.getResults().begin(),
+                       epilogueBackprop.getResults().begin() + diffArgIndices.size());
+    auto reverse = rewriter.create<scf::ForOp>(
+        loc, zero, numSegments, one, reverseArgs,
+        [&](OpBuilder &builder, Location loc, Value iteration, ValueRange iterArgs) {
+            Value segment = builder.create<arith::SubIOp>(loc, lastSegment, iteration);
+            Value index = toIndex(builder, loc, segment);
+            SmallVector<Value> states;
+            for (auto [stateType, stack] : llvm::zip(loop.getResultTypes(), stacks)) {
+                states.push_back(loadCheckpoint(builder, loc, stateType, stack, index));
+            }
+            SmallVector<Value> cotangents;
+            for (Value adjoint : iterArgs.take_front(numStates)) {
+                cotangents.push_back(toCotangent(builder, loc, adjoint));
+            }
+            auto segmentBackprop = builder.create<BackpropOp>(
+                loc, computeBackpropTypes(segmentFn, segmentDiffArgIndices), segmentFn.getName(),
+                getSegmentArgs(builder, segment, states), /*arg_shadows=*/ValueRange{},
+                /*primal results=*/ValueRange{}, cotangents,
+                getDiffArgIndicesAttr(builder, segmentDiffArgIndices), /*checkpoints=*/nullptr);
+
+            SmallVector<Value> yieldedValues(segmentBackprop.getResults().take_front(numStates));
+            for (auto [argGradient, segmentGradient] :
+                 llvm::zip(iterArgs.drop_front(numStates),
+                           segmentBackprop.getResults().drop_front(numStates))) {
+                yieldedValues.push_back(
+                    builder.create<arith::AddFOp>(loc, argGradient, segmentGradient));
+            }
+            builder.create<scf::YieldOp>(loc, yieldedValues);
+        });
+
+    // The derivatives of the initial loop-carried values flow back to the differentiated arguments
+    // they are initialized with.
+    SmallVector<Value> gradients(reverse.getResults().drop_front(numStates));
+    for (auto [initArg, adjoint] :
+         llvm::zip(loop.getInitArgs(), reverse.getResults().take_front(numStates))) {
+        auto arg = dyn_cast<BlockArgument>(initArg);
+        if (!arg || arg.getParentRegion() != &callee.getBody()) {
+            continue;
+        }
+        auto it = llvm::find(diffArgIndices, arg.getArgNumber());
+        if (it != diffArgIndices.end()) {
+            size_t position = std::distance(diffArgIndices.begin(), it);
+            gradients[position] = rewriter.create<arith::AddFOp>(loc, gradients[position], adjoint);
+        }
+    }
+
+    rewriter.replaceOp(op, gradients);
+    return success();
+}
+
+} // namespace gradient
+} // namespace catalyst
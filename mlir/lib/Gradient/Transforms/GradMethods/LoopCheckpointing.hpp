@@ -0,0 +1,56 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/IR/PatternMatch.h"
+
+#include "Gradient/IR/GradientOps.h"
+
+namespace catalyst {
+namespace gradient {
+
+/// A pattern splitting the backpropagation through the first loop of the callee of a BackpropOp
+/// with checkpoints into one BackpropOp per segment of the loop, so that Enzyme only records the
+/// intermediate values of a single segment at a time.
+///
+/// The callee is split into:
+///   - the ops preceding the loop, which must be free of side effects and of differentiable
+///     results, so that they are recomputed wherever they are needed,
+///   - the loop, whose iterations within given bounds are run by a segment function,
+///   - the ops following the loop, which are run by an epilogue function from the loop results.
+struct BackpropCheckpointingPattern : public mlir::OpRewritePattern<BackpropOp> {
+    using mlir::OpRewritePattern<BackpropOp>::OpRewritePattern;
+
+    mlir::LogicalResult matchAndRewrite(BackpropOp op,
+                                        mlir::PatternRewriter &rewriter) const override;
+
+  private:
+    /// Generate a function running the iterations of `loop` between the bounds given by its first
+    /// two arguments, from the loop-carried values given by the following ones. The remaining
+    /// arguments are the arguments of the callee.
+    static mlir::func::FuncOp genSegmentFunction(mlir::PatternRewriter &rewriter,
+                                                 mlir::func::FuncOp callee, mlir::scf::ForOp loop);
+
+    /// Generate a function computing the results of the callee from its arguments followed by the
+    /// results of `loop`.
+    static mlir::func::FuncOp genEpilogueFunction(mlir::PatternRewriter &rewriter,
+                                                  mlir::func::FuncOp callee,
+                                                  mlir::scf::ForOp loop);
+};
+
+} // namespace gradient
+} // namespace catalyst
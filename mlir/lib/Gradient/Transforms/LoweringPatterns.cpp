@@ -16,6 +16,7 @@
 #include "GradMethods/FiniteDifference.hpp"
 #include "GradMethods/HybridGradient.hpp"
 #include "GradMethods/JVPVJPPatterns.hpp"
+#include "GradMethods/LoopCheckpointing.hpp"
 #include "GradMethods/ParameterShift.hpp"
 
 #include "mlir/IR/PatternMatch.h"
@@ -36,6 +37,7 @@ void populateLoweringPatterns(RewritePatternSet &patterns)
     patterns.add<AdjointLowering>(patterns.getContext(), 1);
     patterns.add<JVPLoweringPattern>(patterns.getContext());
     patterns.add<VJPLoweringPattern>(patterns.getContext());
+    patterns.add<BackpropCheckpointingPattern>(patterns.getContext());
 }
 
 } // namespace gradient
@@ -47,11 +47,15 @@ bool catalyst::gradient::requiresCustomGradient(func::FuncOp funcOp)
     return funcOp->hasAttrOfType<FlatSymbolRefAttr>(pureQuantumKey);
 }
 
-void catalyst::gradient::registerCustomGradient(func::FuncOp qnode, FlatSymbolRefAttr qgradFn)
+void catalyst::gradient::registerCustomGradient(func::FuncOp qnode, FlatSymbolRefAttr qgradFn,
+                                                FlatSymbolRefAttr fusedQGradFn)
 {
     Operation *pureQuantumFunc = SymbolTable::lookupNearestSymbolFrom(
         qnode, qnode->getAttrOfType<FlatSymbolRefAttr>(pureQuantumKey));
     pureQuantumFunc->setAttr("gradient.qgrad", qgradFn);
+    if (fusedQGradFn) {
+        pureQuantumFunc->setAttr("gradient.fused_qgrad", fusedQGradFn);
+    }
 
     // Mark this op as processed so it doesn't get processed again.
     qnode->removeAttr(pureQuantumKey);
@@ -0,0 +1,537 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define DEBUG_TYPE "cancellation"
+
+#include <cmath>
+#include <optional>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/Debug.h"
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/IR/PatternMatch.h"
+
+#include "Quantum/IR/QuantumOps.h"
+#include "Quantum/Transforms/Patterns.h"
+
+using llvm::dbgs;
+using namespace mlir;
+using namespace catalyst::quantum;
+
+namespace {
+
+static constexpr double angleTolerance = 1e-12;
+
+// Maximum number of operations looked through when searching for the partner of a gate.
+static constexpr size_t commutationWindow = 256;
+
+/// The Pauli basis in which a gate acts on one of its wires, i.e. the single-qubit Pauli operator
+/// its action on the wire is diagonal in. Two gates commute when they act in the same basis on
+/// every wire they share, e.g. RZ and the control of a CNOT gate, or PauliX and its target.
+enum class WireBasis { X, Y, Z, None };
+
+WireBasis getWireBasis(StringRef name, size_t position)
+{
+    return llvm::StringSwitch<WireBasis>(name)
+        .Cases("PauliZ", "S", "T", "PhaseShift", "RZ", WireBasis::Z)
+        .Cases("CZ", "IsingZZ", "ControlledPhaseShift", "CRZ", WireBasis::Z)
+        .Cases("PauliX", "RX", "IsingXX", WireBasis::X)
+        .Cases("PauliY", "RY", "IsingYY", WireBasis::Y)
+        .Cases("CNOT", "CRX", position == 0 ? WireBasis::Z : WireBasis::X)
+        .Cases("CY", "CRY", position == 0 ? WireBasis::Z : WireBasis::Y)
+        .Case("Toffoli", position < 2 ? WireBasis::Z : WireBasis::X)
+        .Cases("CSWAP", "CRot", position == 0 ? WireBasis::Z : WireBasis::None)
+        .Default(WireBasis::None);
+}
+
+/// Return the basis of a gate on the wire of its qubit operand at the given position.
+WireBasis getWireBasis(Operation *op, size_t position)
+{
+    if (isa<MultiRZOp>(op)) {
+        return WireBasis::Z;
+    }
+    if (auto gate = dyn_cast<CustomOp>(op)) {
+        return getWireBasis(gate.getGateName(), position);
+    }
+    return WireBasis::None;
+}
+
+bool isSelfInverse(StringRef name)
+{
+    return llvm::StringSwitch<bool>(name)
+        .Cases("Hadamard", "PauliX", "PauliY", "PauliZ", "SWAP", true)
+        .Cases("CNOT", "CY", "CZ", "Toffoli", "CSWAP", true)
+        .Default(false);
+}
+
+/// Rotations with a single parameter, such that two consecutive rotations are a rotation by the
+/// sum of their angles.
+bool isAdditiveRotation(StringRef name)
+{
+    return llvm::StringSwitch<bool>(name)
+        .Cases("RX", "RY", "RZ", "PhaseShift", true)
+        .Cases("IsingXX", "IsingYY", "IsingXY", "IsingZZ", true)
+        .Cases("ControlledPhaseShift", "CRX", "CRY", "CRZ", true)
+        .Default(false);
+}
+
+enum class Simplification { Cancel, Merge };
+
+/// Return how a gate simplifies with a later gate acting on the same wires in the same order, if
+/// at all.
+std::optional<Simplification> getSimplification(CustomOp gate, CustomOp next)
+{
+    StringRef name = gate.getGateName();
+    if (name != next.getGateName() || gate.getParams().size() != next.getParams().size()) {
+        return std::nullopt;
+    }
+    if (gate.getParams().empty()) {
+        if (isSelfInverse(name) || gate.getAdjointFlag() != next.getAdjointFlag()) {
+            return Simplification::Cancel;
+        }
+        return std::nullopt;
+    }
+    if (isAdditiveRotation(name) && gate.getParams().size() == 1) {
+        return Simplification::Merge;
+    }
+    return std::nullopt;
+}
+
+/// Return the value of a constant gate parameter, looking through the extraction of a scalar
+/// from a constant tensor.
+std::optional<double> getConstantParam(Value value)
+{
+    FloatAttr floatAttr;
+    if (matchPattern(value, m_Constant(&floatAttr))) {
+        return floatAttr.getValueAsDouble();
+    }
+
+    if (auto extractOp = value.getDefiningOp<tensor::ExtractOp>()) {
+        DenseFPElementsAttr denseAttr;
+        if (matchPattern(extractOp.getTensor(), m_Constant(&denseAttr)) && denseAttr.isSplat()) {
+            return denseAttr.getSplatValue<APFloat>().convertToDouble();
+        }
+    }
+
+    return std::nullopt;
+}
+
+/// Return the constant index of the qubit extracted from or inserted in a register, if any.
+template <typename IndexedOp> std::optional<int64_t> getConstantWire(IndexedOp op)
+{
+    if (std::optional<int64_t> idx = op.getIdxAttr()) {
+        return idx;
+    }
+    APInt idx;
+    if (op.getIdx() && matchPattern(op.getIdx(), m_ConstantInt(&idx))) {
+        return idx.getSExtValue();
+    }
+    return std::nullopt;
+}
+
+/// Cancel a gate with its inverse, or merge a rotation with a rotation of the same kind, when
+/// every gate between them on their wires commutes with the gate. For instance in
+///
+///     RZ(a) q0; CNOT q0, q1; RZ(b) q0
+///
+/// the first rotation commutes with the control of the CNOT gate, and both rotations are merged
+/// into RZ(a + b) after it. The gates in between are left in place: the outputs of the first gate
+/// are replaced by its inputs, which moves it past them along the SSA chains of the wires.
+///
+/// The search follows the wires through the operations of the block of the gate, so it applies in
+/// the bodies of loops and conditionals as well, and stops at anything that is not a commuting
+/// gate, such as a measurement, an extraction, or an operation with regions.
+struct CommutingCancellationPattern : public OpRewritePattern<CustomOp> {
+    using OpRewritePattern<CustomOp>::OpRewritePattern;
+
+    LogicalResult matchAndRewrite(CustomOp op, PatternRewriter &rewriter) const override
+    {
+        const size_t numWires = op.getInQubits().size();
+        if (numWires == 0) {
+            return failure();
+        }
+
+        // The current value of each wire of the gate, and its only user.
+        SmallVector<Value> current(op.getOutQubits());
+        SmallVector<Operation *> users;
+        for (Value qubit : current) {
+            if (!qubit.hasOneUse()) {
+                return failure();
+            }
+            users.push_back(*qubit.getUsers().begin());
+        }
+
+        CustomOp partner;
+        std::optional<Simplification> simplification;
+        size_t numVisited = 0;
+        for (Operation *next = op->getNextNode(); next && !partner; next = next->getNextNode()) {
+            if (numVisited++ >= commutationWindow) {
+                return failure();
+            }
+            if (!llvm::any_of(users, [&](Operation *user) { return next->isAncestor(user); })) {
+                continue;
+            }
+            if (!llvm::is_contained(users, next) || !isa<CustomOp, MultiRZOp>(next)) {
+                return failure();
+            }
+
+            auto gate = dyn_cast<CustomOp>(next);
+            if (gate && llvm::equal(gate.getInQubits(), current)) {
+                if ((simplification = getSimplification(op, gate))) {
+                    partner = gate;
+                    break;
+                }
+            }
+
+            // Advance the wires past the gate if it commutes with the gate being moved.
+            auto quantumGate = cast<QuantumGate>(next);
+            for (auto [position, qubit] : llvm::enumerate(quantumGate.getQubitOperands())) {
+                auto wire = llvm::find(current, qubit);
+                if (wire == current.end()) {
+                    continue;
+                }
+                const size_t idx = wire - current.begin();
+                WireBasis basis = getWireBasis(op, idx);
+                if (basis == WireBasis::None || basis != getWireBasis(next, position)) {
+                    return failure();
+                }
+
+                Value result = quantumGate.getQubitResults()[position];
+                if (!result.hasOneUse()) {
+                    return failure();
+                }
+                current[idx] = result;
+                users[idx] = *result.getUsers().begin();
+            }
+        }
+        if (!partner) {
+            return failure();
+        }
+
+        LLVM_DEBUG(dbgs() << (*simplification == Simplification::Cancel ? "cancelling "
+                                                                         : "merging ")
+                          << op.getGateName() << " gates\n");
+
+        if (*simplification == Simplification::Cancel) {
+            rewriter.replaceOp(partner, partner.getInQubits());
+            rewriter.replaceOp(op, op.getInQubits());
+            return success();
+        }
+
+        rewriter.setInsertionPoint(partner);
+        Location loc = partner.getLoc();
+        auto getAngle = [&](CustomOp gate) -> Value {
+            Value param = gate.getParams().front();
+            return gate.getAdjointFlag() ? rewriter.create<arith::NegFOp>(loc, param) : param;
+        };
+        Value angle = rewriter.create<arith::AddFOp>(loc, getAngle(op), getAngle(partner));
+        rewriter.replaceOpWithNewOp<CustomOp>(
+            partner, partner.getOutQubits().getTypes(), ValueRange{angle}, partner.getInQubits(),
+            partner.getGateNameAttr(), UnitAttr());
+        rewriter.replaceOp(op, op.getInQubits());
+        return success();
+    }
+};
+
+/// Remove identity gates, and rotations by a constant angle of zero, which are left over in
+/// particular when merged rotations cancel out.
+struct IdentityRemovalPattern : public OpRewritePattern<CustomOp> {
+    using OpRewritePattern<CustomOp>::OpRewritePattern;
+
+    LogicalResult matchAndRewrite(CustomOp op, PatternRewriter &rewriter) const override
+    {
+        StringRef name = op.getGateName();
+        if (name != "Identity") {
+            if (!isAdditiveRotation(name) || op.getParams().size() != 1) {
+                return failure();
+            }
+            std::optional<double> angle = getConstantParam(op.getParams().front());
+            if (!angle || std::abs(*angle) >= angleTolerance) {
+                return failure();
+            }
+        }
+
+        LLVM_DEBUG(dbgs() << "removing identity " << name << " gate\n");
+        rewriter.replaceOp(op, op.getInQubits());
+        return success();
+    }
+};
+
+/// Hoist the conjugation of a loop body out of the loop. When the body starts with a gate on
+/// loop-carried qubits and ends with its inverse on the same qubits, consecutive iterations
+/// cancel the inverse against the gate of the next one:
+///
+///     for i: (U B U^-1)   ==   U (for i: B) U^-1
+///
+/// which holds for any number of iterations, including none. The gates hoisted before and after
+/// the loop can then cancel with the gates around it.
+struct LoopConjugationHoistingPattern : public OpRewritePattern<scf::ForOp> {
+    using OpRewritePattern<scf::ForOp>::OpRewritePattern;
+
+    LogicalResult matchAndRewrite(scf::ForOp loop, PatternRewriter &rewriter) const override
+    {
+        Block *body = loop.getBody();
+        auto yield = cast<scf::YieldOp>(body->getTerminator());
+
+        for (BlockArgument iterArg : loop.getRegionIterArgs()) {
+            if (!isa<QubitType>(iterArg.getType()) || !iterArg.hasOneUse()) {
+                continue;
+            }
+            auto first = dyn_cast<CustomOp>(*iterArg.getUsers().begin());
+            if (!first || first->getBlock() != body) {
+                continue;
+            }
+
+            // Position in the iteration arguments of each wire of the first gate.
+            SmallVector<unsigned> positions;
+            for (Value qubit : first.getInQubits()) {
+                auto arg = dyn_cast<BlockArgument>(qubit);
+                if (!arg || arg.getOwner() != body || arg.getArgNumber() == 0 ||
+                    !arg.hasOneUse()) {
+                    break;
+                }
+                positions.push_back(arg.getArgNumber() - loop.getNumInductionVars());
+            }
+            if (positions.size() != first.getInQubits().size()) {
+                continue;
+            }
+
+            auto last = yield.getOperand(positions.front()).getDefiningOp<CustomOp>();
+            if (!last || last == first || last->getBlock() != body ||
+                last.getInQubits().size() != positions.size()) {
+                continue;
+            }
+            bool matched = llvm::all_of(llvm::enumerate(positions), [&](auto entry) {
+                Value result = last.getOutQubits()[entry.index()];
+                return yield.getOperand(entry.value()) == result && result.hasOneUse();
+            });
+            auto simplification = getSimplification(first, last);
+            if (!matched || simplification != Simplification::Cancel) {
+                continue;
+            }
+
+            LLVM_DEBUG(dbgs() << "hoisting " << first.getGateName() << " conjugation of loop\n");
+
+            SmallVector<Value> inits;
+            SmallVector<Value> results;
+            for (unsigned position : positions) {
+                inits.push_back(loop.getInitArgs()[position]);
+                results.push_back(loop.getResult(position));
+            }
+
+            rewriter.setInsertionPoint(loop);
+            auto before = rewriter.create<CustomOp>(
+                first.getLoc(), first.getOutQubits().getTypes(), ValueRange{}, inits,
+                first.getGateNameAttr(), first.getAdjointAttr());
+            rewriter.updateRootInPlace(loop, [&] {
+                for (auto [position, qubit] : llvm::zip(positions, before.getOutQubits())) {
+                    loop->setOperand(loop.getNumControlOperands() + position, qubit);
+                }
+            });
+
+            rewriter.setInsertionPointAfter(loop);
+            auto after = rewriter.create<CustomOp>(last.getLoc(), last.getOutQubits().getTypes(),
+                                                   ValueRange{}, results, last.getGateNameAttr(),
+                                                   last.getAdjointAttr());
+            for (auto [result, qubit] : llvm::zip(results, after.getOutQubits())) {
+                for (OpOperand &use : llvm::make_early_inc_range(result.getUses())) {
+                    if (use.getOwner() != after) {
+                        rewriter.updateRootInPlace(use.getOwner(), [&] { use.set(qubit); });
+                    }
+                }
+            }
+
+            rewriter.replaceOp(last, last.getInQubits());
+            rewriter.replaceOp(first, first.getInQubits());
+            return success();
+        }
+        return failure();
+    }
+};
+
+/// Hoist the conjugation of a loop body out of the loop when its qubits are carried by a register,
+/// as in the loops of a qnode: the body starts with a gate on qubits extracted from the iteration
+/// register at constant indices, and ends with its inverse on the qubits last inserted at the same
+/// indices before the register is yielded. The gates are hoisted together with the extraction and
+/// insertion of their qubits around the loop.
+struct RegisterLoopConjugationHoistingPattern : public OpRewritePattern<scf::ForOp> {
+    using OpRewritePattern<scf::ForOp>::OpRewritePattern;
+
+    LogicalResult matchAndRewrite(scf::ForOp loop, PatternRewriter &rewriter) const override
+    {
+        Block *body = loop.getBody();
+        auto yield = cast<scf::YieldOp>(body->getTerminator());
+
+        for (BlockArgument iterArg : loop.getRegionIterArgs()) {
+            if (!isa<QuregType>(iterArg.getType())) {
+                continue;
+            }
+            const unsigned position = iterArg.getArgNumber() - loop.getNumInductionVars();
+
+            // Follow the registers from the iteration argument to the yielded one. Each register
+            // may only be read by extractions and written by a single insertion, at constant
+            // indices, so that the qubit of each wire is known along the chain.
+            MapVector<int64_t, ExtractOp> entryExtracts;
+            DenseMap<int64_t, InsertOp> lastInserts;
+            bool valid = true;
+            Value reg = iterArg;
+            while (valid && reg != yield.getOperand(position)) {
+                InsertOp next;
+                for (Operation *user : reg.getUsers()) {
+                    auto extract = dyn_cast<ExtractOp>(user);
+                    std::optional<int64_t> wire = extract ? getConstantWire(extract) : std::nullopt;
+                    if (extract && wire && extract->getBlock() == body) {
+                        if (reg == iterArg && !entryExtracts.insert({*wire, extract}).second) {
+                            valid = false;
+                        }
+                        // The wire is read again after its last insertion.
+                        lastInserts.erase(*wire);
+                        continue;
+                    }
+                    auto insert = dyn_cast<InsertOp>(user);
+                    if (!insert || next || !getConstantWire(insert) ||
+                        insert->getBlock() != body) {
+                        valid = false;
+                        break;
+                    }
+                    next = insert;
+                }
+                if (!valid || !next) {
+                    valid = false;
+                    break;
+                }
+                lastInserts[*getConstantWire(next)] = next;
+                reg = next.getOutQreg();
+            }
+            if (!valid || !reg.hasOneUse()) {
+                continue;
+            }
+
+            for (auto &candidate : entryExtracts) {
+                Value qubit = candidate.second.getQubit();
+                if (!qubit.hasOneUse()) {
+                    continue;
+                }
+                auto first = dyn_cast<CustomOp>(*qubit.getUsers().begin());
+                if (!first || first->getBlock() != body) {
+                    continue;
+                }
+
+                // Wire of each qubit of the first gate, which all come from the iteration register.
+                SmallVector<int64_t> wires;
+                for (Value in : first.getInQubits()) {
+                    auto extract = in.getDefiningOp<ExtractOp>();
+                    if (!extract || extract.getQreg() != iterArg || !in.hasOneUse()) {
+                        break;
+                    }
+                    wires.push_back(*getConstantWire(extract));
+                }
+                if (wires.size() != first.getInQubits().size() ||
+                    !lastInserts.count(wires.front())) {
+                    continue;
+                }
+
+                Value lastQubit = lastInserts.lookup(wires.front()).getQubit();
+                auto last = lastQubit.getDefiningOp<CustomOp>();
+                if (!last || last == first || last->getBlock() != body ||
+                    last.getOutQubits().size() != wires.size()) {
+                    continue;
+                }
+                bool matched = llvm::all_of(llvm::enumerate(wires), [&](auto entry) {
+                    InsertOp insert = lastInserts.lookup(entry.value());
+                    Value result = last.getOutQubits()[entry.index()];
+                    return insert && insert.getQubit() == result && result.hasOneUse();
+                });
+                auto simplification = getSimplification(first, last);
+                if (!matched || simplification != Simplification::Cancel) {
+                    continue;
+                }
+
+                LLVM_DEBUG(dbgs() << "hoisting " << first.getGateName()
+                                  << " conjugation of register loop\n");
+
+                // Apply the gate to the wires of a register, returning the updated register and
+                // the operations created for it.
+                auto applyToRegister = [&](CustomOp gate, Value qreg,
+                                           SmallVectorImpl<Operation *> &created) -> Value {
+                    Location loc = gate.getLoc();
+                    SmallVector<Value> qubits;
+                    for (auto [wire, qubit] : llvm::zip(wires, gate.getInQubits())) {
+                        auto extract = rewriter.create<ExtractOp>(
+                            loc, qubit.getType(), qreg, Value(), rewriter.getI64IntegerAttr(wire));
+                        created.push_back(extract);
+                        qubits.push_back(extract.getQubit());
+                    }
+                    auto hoisted = rewriter.create<CustomOp>(
+                        loc, gate.getOutQubits().getTypes(), ValueRange{}, qubits,
+                        gate.getGateNameAttr(), gate.getAdjointAttr());
+                    created.push_back(hoisted);
+                    for (auto [wire, qubit] : llvm::zip(wires, hoisted.getOutQubits())) {
+                        auto insert = rewriter.create<InsertOp>(
+                            loc, qreg.getType(), qreg, Value(), rewriter.getI64IntegerAttr(wire),
+                            qubit);
+                        created.push_back(insert);
+                        qreg = insert.getOutQreg();
+                    }
+                    return qreg;
+                };
+
+                SmallVector<Operation *> before;
+                rewriter.setInsertionPoint(loop);
+                Value init = applyToRegister(first, loop.getInitArgs()[position], before);
+                rewriter.updateRootInPlace(loop, [&] {
+                    loop->setOperand(loop.getNumControlOperands() + position, init);
+                });
+
+                SmallVector<Operation *> after;
+                rewriter.setInsertionPointAfter(loop);
+                Value result = loop.getResult(position);
+                Value updated = applyToRegister(last, result, after);
+                for (OpOperand &use : llvm::make_early_inc_range(result.getUses())) {
+                    if (!llvm::is_contained(after, use.getOwner())) {
+                        rewriter.updateRootInPlace(use.getOwner(), [&] { use.set(updated); });
+                    }
+                }
+
+                rewriter.replaceOp(last, last.getInQubits());
+                rewriter.replaceOp(first, first.getInQubits());
+                return success();
+            }
+        }
+        return failure();
+    }
+};
+
+} // namespace
+
+namespace catalyst {
+namespace quantum {
+
+void populateCommutationPatterns(RewritePatternSet &patterns)
+{
+    patterns.add<CommutingCancellationPattern>(patterns.getContext(), 1);
+    patterns.add<IdentityRemovalPattern>(patterns.getContext(), 1);
+    patterns.add<LoopConjugationHoistingPattern>(patterns.getContext(), 1);
+    patterns.add<RegisterLoopConjugationHoistingPattern>(patterns.getContext(), 1);
+}
+
+} // namespace quantum
+} // namespace catalyst
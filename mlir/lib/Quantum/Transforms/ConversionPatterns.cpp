@@ -14,6 +14,7 @@
 
 #include <string>
 
+#include "mlir/Conversion/LLVMCommon/MemRefBuilder.h"
 #include "mlir/Dialect/LLVMIR/LLVMDialect.h"
 #include "mlir/Transforms/DialectConversion.h"
 
@@ -96,17 +97,24 @@ template <typename T> struct RTBasedPattern : public OpConversionPattern<T> {
     }
 };
 
-struct DeviceInitOpPattern : public OpConversionPattern<DeviceInitOp> {
-    using OpConversionPattern::OpConversionPattern;
+template <typename T> struct DeviceOpPattern : public OpConversionPattern<T> {
+    using OpConversionPattern<T>::OpConversionPattern;
 
-    LogicalResult matchAndRewrite(DeviceInitOp op, DeviceInitOpAdaptor adaptor,
+    LogicalResult matchAndRewrite(T op, typename T::Adaptor adaptor,
                                   ConversionPatternRewriter &rewriter) const override
     {
         Location loc = op.getLoc();
         MLIRContext *ctx = this->getContext();
         ModuleOp mod = op->getParentOfType<ModuleOp>();
 
-        StringRef qirName = "__quantum__rt__device_init"; // (int8_t *, int8_t *, int8_t *) -> void
+        // (int8_t *, int8_t *, int8_t *) -> void
+        StringRef qirName;
+        if constexpr (std::is_same_v<T, DeviceInitOp>) {
+            qirName = "__quantum__rt__device_init";
+        }
+        else {
+            qirName = "__quantum__rt__device_prefetch";
+        }
 
         Type charPtrType = LLVM::LLVMPointerType::get(IntegerType::get(ctx, 8));
         Type qirSignature = LLVM::LLVMFunctionType::get(LLVM::LLVMVoidType::get(ctx),
@@ -156,6 +164,86 @@ struct DeviceReleaseOpPattern : public OpConversionPattern<DeviceReleaseOp> {
     }
 };
 
+struct ToggleTemplateOpPattern : public OpConversionPattern<ToggleTemplateOp> {
+    using OpConversionPattern::OpConversionPattern;
+
+    LogicalResult matchAndRewrite(ToggleTemplateOp op, ToggleTemplateOpAdaptor adaptor,
+                                  ConversionPatternRewriter &rewriter) const override
+    {
+        Location loc = op.getLoc();
+        MLIRContext *ctx = this->getContext();
+
+        // (int64_t, bool) -> void
+        StringRef qirName = "__quantum__rt__toggle_template";
+        Type qirSignature = LLVM::LLVMFunctionType::get(
+            LLVM::LLVMVoidType::get(ctx), {IntegerType::get(ctx, 64), IntegerType::get(ctx, 1)});
+        LLVM::LLVMFuncOp fnDecl = ensureFunctionDeclaration(rewriter, op, qirName, qirSignature);
+
+        SmallVector<Value> args = {
+            rewriter.create<LLVM::ConstantOp>(loc, rewriter.getI64IntegerAttr(op.getId())),
+            rewriter.create<LLVM::ConstantOp>(loc, rewriter.getBoolAttr(op.getStatus()))};
+        rewriter.replaceOpWithNewOp<LLVM::CallOp>(op, fnDecl, args);
+
+        return success();
+    }
+};
+
+struct ReplayOpPattern : public OpConversionPattern<ReplayOp> {
+    using OpConversionPattern::OpConversionPattern;
+
+    LogicalResult matchAndRewrite(ReplayOp op, ReplayOpAdaptor adaptor,
+                                  ConversionPatternRewriter &rewriter) const override
+    {
+        Location loc = op.getLoc();
+        MLIRContext *ctx = getContext();
+        TypeConverter *conv = getTypeConverter();
+
+        // (int64_t, MemRefT_double_1d *) -> bool
+        Type f64Type = Float64Type::get(ctx);
+        Type vectorType = conv->convertType(MemRefType::get({UNKNOWN}, f64Type));
+        Type vectorPtrType = LLVM::LLVMPointerType::get(vectorType);
+        StringRef qirName = "__quantum__rt__replay";
+        Type qirSignature = LLVM::LLVMFunctionType::get(IntegerType::get(ctx, 1),
+                                                        {IntegerType::get(ctx, 64), vectorPtrType});
+        LLVM::LLVMFuncOp fnDecl = ensureFunctionDeclaration(rewriter, op, qirName, qirSignature);
+
+        Value id = rewriter.create<LLVM::ConstantOp>(loc, rewriter.getI64IntegerAttr(op.getId()));
+        ValueRange params = adaptor.getParams();
+        if (params.empty()) {
+            Value null = rewriter.create<LLVM::NullOp>(loc, vectorPtrType);
+            rewriter.replaceOpWithNewOp<LLVM::CallOp>(op, fnDecl, ValueRange{id, null});
+            return success();
+        }
+
+        // The parameters are stored in a stack buffer viewed by a 1-d memref descriptor
+        Type f64PtrType = LLVM::LLVMPointerType::get(f64Type);
+        Value numParams =
+            rewriter.create<LLVM::ConstantOp>(loc, rewriter.getI64IntegerAttr(params.size()));
+        Value buffer = rewriter.create<LLVM::AllocaOp>(loc, f64PtrType, numParams);
+        for (auto [idx, param] : llvm::enumerate(params)) {
+            Value offset = rewriter.create<LLVM::ConstantOp>(loc, rewriter.getI64IntegerAttr(idx));
+            Value ptr =
+                rewriter.create<LLVM::GEPOp>(loc, f64PtrType, buffer, ArrayRef<Value>({offset}));
+            rewriter.create<LLVM::StoreOp>(loc, param, ptr);
+        }
+
+        MemRefDescriptor desc = MemRefDescriptor::undef(rewriter, loc, vectorType);
+        desc.setAllocatedPtr(rewriter, loc, buffer);
+        desc.setAlignedPtr(rewriter, loc, buffer);
+        desc.setConstantOffset(rewriter, loc, 0);
+        desc.setConstantSize(rewriter, loc, 0, params.size());
+        desc.setConstantStride(rewriter, loc, 0, 1);
+
+        Value c1 = rewriter.create<LLVM::ConstantOp>(loc, rewriter.getI64IntegerAttr(1));
+        Value descPtr = rewriter.create<LLVM::AllocaOp>(loc, vectorPtrType, c1);
+        rewriter.create<LLVM::StoreOp>(loc, Value(desc), descPtr);
+
+        rewriter.replaceOpWithNewOp<LLVM::CallOp>(op, fnDecl, ValueRange{id, descPtr});
+
+        return success();
+    }
+};
+
 ///////////////////////
 // Memory Management //
 ///////////////////////
@@ -315,6 +403,43 @@ struct MultiRZOpPattern : public OpConversionPattern<MultiRZOp> {
     }
 };
 
+template <typename T> struct StructuredGatePattern : public OpConversionPattern<T> {
+    using OpConversionPattern<T>::OpConversionPattern;
+
+    LogicalResult matchAndRewrite(T op, typename T::Adaptor adaptor,
+                                  ConversionPatternRewriter &rewriter) const override
+    {
+        Location loc = op.getLoc();
+        MLIRContext *ctx = this->getContext();
+
+        StringRef qirName;
+        if constexpr (std::is_same_v<T, QFTOp>) {
+            qirName = "__quantum__qis__QFT";
+        }
+        else {
+            qirName = "__quantum__qis__ReflectUniform";
+        }
+
+        Type qirSignature = LLVM::LLVMFunctionType::get(
+            LLVM::LLVMVoidType::get(ctx), {IntegerType::get(ctx, 1), IntegerType::get(ctx, 64)},
+            /*isVarArg=*/true);
+
+        LLVM::LLVMFuncOp fnDecl = ensureFunctionDeclaration(rewriter, op, qirName, qirSignature);
+
+        int64_t numQubits = op.getNumResults();
+        SmallVector<Value> args = adaptor.getOperands();
+        args.insert(args.begin(),
+                    rewriter.create<LLVM::ConstantOp>(loc, rewriter.getI64IntegerAttr(numQubits)));
+        args.insert(args.begin(), rewriter.create<LLVM::ConstantOp>(
+                                      loc, rewriter.getBoolAttr(op.getAdjointFlag())));
+
+        rewriter.create<LLVM::CallOp>(loc, fnDecl, args);
+        rewriter.replaceOp(op, adaptor.getInQubits());
+
+        return success();
+    }
+};
+
 struct QubitUnitaryOpPattern : public OpConversionPattern<QubitUnitaryOp> {
     using OpConversionPattern::OpConversionPattern;
 
@@ -744,14 +869,19 @@ void populateQIRConversionPatterns(TypeConverter &typeConverter, RewritePatternS
 {
     patterns.add<RTBasedPattern<InitializeOp>>(typeConverter, patterns.getContext());
     patterns.add<RTBasedPattern<FinalizeOp>>(typeConverter, patterns.getContext());
-    patterns.add<DeviceInitOpPattern>(typeConverter, patterns.getContext());
+    patterns.add<DeviceOpPattern<DeviceInitOp>>(typeConverter, patterns.getContext());
+    patterns.add<DeviceOpPattern<DevicePrefetchOp>>(typeConverter, patterns.getContext());
     patterns.add<DeviceReleaseOpPattern>(typeConverter, patterns.getContext());
+    patterns.add<ToggleTemplateOpPattern>(typeConverter, patterns.getContext());
+    patterns.add<ReplayOpPattern>(typeConverter, patterns.getContext());
     patterns.add<AllocOpPattern>(typeConverter, patterns.getContext());
     patterns.add<DeallocOpPattern>(typeConverter, patterns.getContext());
     patterns.add<ExtractOpPattern>(typeConverter, patterns.getContext());
     patterns.add<InsertOpPattern>(typeConverter, patterns.getContext());
     patterns.add<CustomOpPattern>(typeConverter, patterns.getContext());
     patterns.add<MultiRZOpPattern>(typeConverter, patterns.getContext());
+    patterns.add<StructuredGatePattern<QFTOp>>(typeConverter, patterns.getContext());
+    patterns.add<StructuredGatePattern<ReflectUniformOp>>(typeConverter, patterns.getContext());
     patterns.add<QubitUnitaryOpPattern>(typeConverter, patterns.getContext());
     patterns.add<MeasureOpPattern>(typeConverter, patterns.getContext());
     patterns.add<ComputationalBasisOpPattern>(typeConverter, patterns.getContext());
@@ -0,0 +1,272 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define DEBUG_TYPE "shotbatching"
+
+#include <optional>
+#include <string>
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Debug.h"
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/IR/SymbolTable.h"
+
+#include "Quantum/IR/QuantumOps.h"
+
+using namespace llvm;
+using namespace mlir;
+using namespace catalyst::quantum;
+
+namespace {
+
+// The qnode a function runs a batch of the shots of, and its number of shots.
+constexpr StringLiteral shotBatchOfAttrName = "shot_batch_of";
+constexpr StringLiteral batchShotsAttrName = "batch_shots";
+
+/// How the batches of a result of a qnode are merged into the result of all shots.
+enum class MergeKind { Samples, Eigvals, Counts };
+
+/// Get the number of shots of a dynamic circuit whose results are all samples
+/// or counts, which can then be drawn by independent runs of the circuit on a
+/// subset of the shots.
+std::optional<int64_t> getBatchableShots(func::FuncOp qnode, SmallVectorImpl<MergeKind> &merges)
+{
+    if (qnode.isExternal() || !qnode.getBody().hasOneBlock()) {
+        return std::nullopt;
+    }
+
+    bool dynamic = false;
+    std::optional<int64_t> shots;
+    WalkResult walk = qnode.walk([&](Operation *op) {
+        if (isa<MeasureOp>(op)) {
+            dynamic = true;
+            return WalkResult::advance();
+        }
+        if (!isa<MeasurementProcess>(op)) {
+            return WalkResult::advance();
+        }
+
+        std::optional<int64_t> opShots;
+        if (auto sample = dyn_cast<SampleOp>(op);
+            sample && !sample.isBufferized() &&
+            cast<RankedTensorType>(sample.getSamples().getType()).hasStaticShape()) {
+            opShots = sample.getShots();
+        }
+        else if (auto counts = dyn_cast<CountsOp>(op); counts && !counts.isBufferized()) {
+            opShots = counts.getShots();
+        }
+        // The other measurement processes can't be merged across the batches
+        if (!opShots || (shots && *shots != *opShots)) {
+            return WalkResult::interrupt();
+        }
+        shots = opShots;
+        return WalkResult::advance();
+    });
+    if (walk.wasInterrupted() || !dynamic || !shots) {
+        return std::nullopt;
+    }
+
+    // The samples and counts must be returned as they are, since their number of
+    // rows changes in the batches.
+    auto returnOp = cast<func::ReturnOp>(qnode.getBody().front().getTerminator());
+    for (Value result : returnOp.getOperands()) {
+        Operation *def = result.getDefiningOp();
+        if (!def || !isa<SampleOp, CountsOp>(def) ||
+            !llvm::all_of(result.getUsers(), [](Operation *user) {
+                return isa<func::ReturnOp>(user);
+            })) {
+            return std::nullopt;
+        }
+        if (isa<SampleOp>(def)) {
+            merges.push_back(MergeKind::Samples);
+        }
+        else {
+            merges.push_back(result == def->getResult(0) ? MergeKind::Eigvals : MergeKind::Counts);
+        }
+    }
+    return shots;
+}
+
+/// Split the shots of the calls to a dynamic circuit, i.e. a qnode with
+/// mid-circuit measurements, in independent batches. Each batch calls a clone
+/// of the qnode drawing its subset of the shots, and the samples and counts of
+/// the batches are merged into the results of the original call. The batch
+/// calls run concurrently on pooled devices once lowered to asynchronous calls.
+struct ShotBatchingPattern : public OpRewritePattern<func::CallOp> {
+    ShotBatchingPattern(MLIRContext *context, unsigned numBatches)
+        : OpRewritePattern<func::CallOp>(context), numBatches(numBatches)
+    {
+    }
+
+    unsigned numBatches;
+
+    static func::FuncOp lookupBatch(ModuleOp mod, func::FuncOp callee, int64_t shots)
+    {
+        for (auto func : mod.getOps<func::FuncOp>()) {
+            auto origin = func->getAttrOfType<FlatSymbolRefAttr>(shotBatchOfAttrName);
+            auto batchShots = func->getAttrOfType<IntegerAttr>(batchShotsAttrName);
+            if (origin && origin.getValue() == callee.getSymName() && batchShots &&
+                batchShots.getInt() == shots) {
+                return func;
+            }
+        }
+        return nullptr;
+    }
+
+    static func::FuncOp createBatch(PatternRewriter &rewriter, func::FuncOp callee,
+                                    int64_t shots, int64_t batches)
+    {
+        func::FuncOp batch = callee.clone();
+
+        std::string name = (callee.getSymName() + ".shots." + Twine(shots)).str();
+        for (unsigned idx = 1; SymbolTable::lookupNearestSymbolFrom(
+                 callee, StringAttr::get(callee.getContext(), name));
+             idx++) {
+            name = (callee.getSymName() + ".shots." + Twine(shots) + "." + Twine(idx)).str();
+        }
+        batch.setSymName(name);
+        batch->setAttr(shotBatchOfAttrName, FlatSymbolRefAttr::get(callee));
+        batch->setAttr(batchShotsAttrName, rewriter.getI64IntegerAttr(shots));
+
+        IntegerAttr shotsAttr = rewriter.getI64IntegerAttr(shots);
+        batch.walk([&](Operation *op) {
+            if (auto sample = dyn_cast<SampleOp>(op)) {
+                auto type = cast<RankedTensorType>(sample.getSamples().getType());
+                SmallVector<int64_t> shape(type.getShape());
+                shape[0] = shots;
+                sample.setShotsAttr(shotsAttr);
+                sample.getSamples().setType(RankedTensorType::get(shape, type.getElementType()));
+            }
+            else if (auto counts = dyn_cast<CountsOp>(op)) {
+                counts.setShotsAttr(shotsAttr);
+            }
+            else if (auto device = dyn_cast<DeviceInitOp>(op)) {
+                // Lightning devices share the cores between the concurrent batches
+                StringRef kwargs = device.getKwargs().rtrim();
+                if (device.getName().contains("Lightning") && kwargs.endswith("}")) {
+                    std::string batchKwargs = kwargs.drop_back().rtrim().str();
+                    batchKwargs += batchKwargs.back() == '{' ? "" : ", ";
+                    batchKwargs += "'shot_batches': " + std::to_string(batches) + "}";
+                    device.setKwargsAttr(rewriter.getStringAttr(batchKwargs));
+                }
+            }
+        });
+
+        auto returnOp = cast<func::ReturnOp>(batch.getBody().front().getTerminator());
+        batch.setFunctionType(rewriter.getFunctionType(batch.getArgumentTypes(),
+                                                       returnOp.getOperandTypes()));
+
+        PatternRewriter::InsertionGuard insertGuard(rewriter);
+        rewriter.setInsertionPointAfter(callee);
+        rewriter.insert(batch);
+        return batch;
+    }
+
+    LogicalResult matchAndRewrite(func::CallOp op, PatternRewriter &rewriter) const override
+    {
+        auto mod = op->getParentOfType<ModuleOp>();
+        func::FuncOp callee =
+            SymbolTable::lookupNearestSymbolFrom<func::FuncOp>(op, op.getCalleeAttr());
+        if (!mod || !callee || !callee->hasAttrOfType<UnitAttr>("qnode") ||
+            callee->hasAttr(shotBatchOfAttrName)) {
+            return failure();
+        }
+
+        SmallVector<MergeKind> merges;
+        std::optional<int64_t> shots = getBatchableShots(callee, merges);
+        if (!shots) {
+            return failure();
+        }
+        const int64_t batches = std::min<int64_t>(numBatches, *shots);
+        if (batches <= 1) {
+            return failure();
+        }
+
+        LLVM_DEBUG(dbgs() << "splitting " << *shots << " shots of " << callee.getSymName()
+                          << " in " << batches << " batches\n");
+
+        // The first `shots % batches` batches draw one more shot than the others
+        Location loc = op.getLoc();
+        SmallVector<int64_t> batchShots;
+        SmallVector<ValueRange> batchResults;
+        for (int64_t idx = 0; idx < batches; idx++) {
+            const int64_t size = *shots / batches + (idx < *shots % batches ? 1 : 0);
+            func::FuncOp batch = lookupBatch(mod, callee, size);
+            if (!batch) {
+                batch = createBatch(rewriter, callee, size, batches);
+            }
+            batchShots.push_back(size);
+            batchResults.push_back(
+                rewriter.create<func::CallOp>(loc, batch, op.getOperands()).getResults());
+        }
+
+        SmallVector<Value> results;
+        for (auto [idx, merge] : llvm::enumerate(merges)) {
+            if (merge == MergeKind::Eigvals) {
+                results.push_back(batchResults[0][idx]);
+                continue;
+            }
+            if (merge == MergeKind::Counts) {
+                Value counts = batchResults[0][idx];
+                for (ValueRange batch : ArrayRef(batchResults).drop_front()) {
+                    counts = rewriter.create<arith::AddIOp>(loc, counts, batch[idx]);
+                }
+                results.push_back(counts);
+                continue;
+            }
+
+            // The samples of the batches are stacked along the shots
+            auto type = cast<RankedTensorType>(op.getResult(idx).getType());
+            Value samples =
+                rewriter.create<tensor::EmptyOp>(loc, type.getShape(), type.getElementType());
+            int64_t offset = 0;
+            for (auto [batch, size] : llvm::zip(batchResults, batchShots)) {
+                SmallVector<OpFoldResult> offsets(type.getRank(), rewriter.getIndexAttr(0));
+                SmallVector<OpFoldResult> sizes;
+                SmallVector<OpFoldResult> strides(type.getRank(), rewriter.getIndexAttr(1));
+                offsets[0] = rewriter.getIndexAttr(offset);
+                sizes.push_back(rewriter.getIndexAttr(size));
+                for (int64_t dim : type.getShape().drop_front()) {
+                    sizes.push_back(rewriter.getIndexAttr(dim));
+                }
+                samples = rewriter.create<tensor::InsertSliceOp>(loc, batch[idx], samples,
+                                                                 offsets, sizes, strides);
+                offset += size;
+            }
+            results.push_back(samples);
+        }
+
+        rewriter.replaceOp(op, results);
+        return success();
+    }
+};
+
+} // namespace
+
+namespace catalyst {
+namespace quantum {
+
+void populateShotBatchingPatterns(RewritePatternSet &patterns, unsigned numBatches)
+{
+    patterns.add<ShotBatchingPattern>(patterns.getContext(), numBatches);
+}
+
+} // namespace quantum
+} // namespace catalyst
@@ -0,0 +1,316 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define DEBUG_TYPE "subcircuits"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/MathExtras.h"
+
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/IR/PatternMatch.h"
+
+#include "Quantum/IR/QuantumOps.h"
+#include "Quantum/Transforms/Patterns.h"
+
+using llvm::dbgs;
+using namespace mlir;
+using namespace catalyst::quantum;
+
+namespace {
+
+static constexpr double angleTolerance = 1e-12;
+
+/// Return the value of a constant gate parameter, looking through the extraction of a scalar
+/// from a constant tensor.
+std::optional<double> getConstantParam(Value value)
+{
+    FloatAttr floatAttr;
+    if (matchPattern(value, m_Constant(&floatAttr))) {
+        return floatAttr.getValueAsDouble();
+    }
+
+    if (auto extractOp = value.getDefiningOp<tensor::ExtractOp>()) {
+        DenseFPElementsAttr denseAttr;
+        if (matchPattern(extractOp.getTensor(), m_Constant(&denseAttr)) && denseAttr.isSplat()) {
+            return denseAttr.getSplatValue<APFloat>().convertToDouble();
+        }
+    }
+
+    return std::nullopt;
+}
+
+/// Return the unique user of a qubit value if it is a custom gate with the given name.
+CustomOp getNextGate(Value qubit, StringRef name)
+{
+    if (!qubit.hasOneUse()) {
+        return nullptr;
+    }
+    auto gate = dyn_cast<CustomOp>(*qubit.getUsers().begin());
+    return gate && gate.getGateName() == name ? gate : nullptr;
+}
+
+/// Return the defining op of a qubit value if it is a custom gate with the given name, and the
+/// value is not used anywhere else.
+CustomOp getPrevGate(Value qubit, StringRef name)
+{
+    if (!qubit.hasOneUse()) {
+        return nullptr;
+    }
+    auto gate = qubit.getDefiningOp<CustomOp>();
+    return gate && gate.getGateName() == name ? gate : nullptr;
+}
+
+/// Check that a gate has a single parameter equal to the given angle, taking the adjoint flag
+/// into account.
+bool hasAngle(CustomOp gate, double angle)
+{
+    if (gate.getParams().size() != 1) {
+        return false;
+    }
+    std::optional<double> param = getConstantParam(gate.getParams().front());
+    if (!param) {
+        return false;
+    }
+    double effective = gate.getAdjointFlag() ? -*param : *param;
+    return std::abs(effective - angle) < angleTolerance;
+}
+
+/// Follow a gate sequence forward along a set of wires, keeping track of the current SSA value of
+/// every wire and of the matched operations.
+struct WireTracker {
+    SmallVector<Value> inputs;
+    SmallVector<Value> current;
+    SmallVector<Operation *> ops;
+
+    void addWire(Value input, Value value)
+    {
+        inputs.push_back(input);
+        current.push_back(value);
+    }
+
+    /// Match the next gate acting on exactly the given wires, and advance the wires past it.
+    /// Symmetric gates may list the wires in any order.
+    bool advance(StringRef name, ArrayRef<size_t> wires, std::optional<double> angle = std::nullopt,
+                 bool symmetric = false)
+    {
+        CustomOp gate = getNextGate(current[wires.front()], name);
+        if (!gate || gate.getInQubits().size() != wires.size()) {
+            return false;
+        }
+        if (angle ? !hasAngle(gate, *angle) : !gate.getParams().empty()) {
+            return false;
+        }
+
+        SmallVector<size_t> order;
+        for (Value qubit : gate.getInQubits()) {
+            auto wire = llvm::find_if(wires, [&](size_t w) { return current[w] == qubit; });
+            if (wire == wires.end()) {
+                return false;
+            }
+            order.push_back(*wire);
+        }
+        if (!symmetric && !llvm::equal(order, wires)) {
+            return false;
+        }
+
+        for (auto [wire, result] : llvm::zip(order, gate.getOutQubits())) {
+            current[wire] = result;
+        }
+        ops.push_back(gate);
+        return true;
+    }
+
+    /// Replace the matched sequence with a single operation acting on all the wires. The new
+    /// operation is placed after the last matched one, which requires every later user of the
+    /// wires to come after it in the same block.
+    template <typename OpTy> LogicalResult replace(PatternRewriter &rewriter, Location loc)
+    {
+        Block *block = ops.front()->getBlock();
+        if (!llvm::all_of(ops, [&](Operation *op) { return op->getBlock() == block; })) {
+            return failure();
+        }
+
+        Operation *lastOp = *std::max_element(ops.begin(), ops.end(), [](auto lhs, auto rhs) {
+            return lhs->isBeforeInBlock(rhs);
+        });
+        for (Value qubit : current) {
+            for (Operation *user : qubit.getUsers()) {
+                Operation *ancestor = block->findAncestorOpInBlock(*user);
+                if (!ancestor || !lastOp->isBeforeInBlock(ancestor)) {
+                    return failure();
+                }
+            }
+        }
+
+        rewriter.setInsertionPointAfter(lastOp);
+        auto newOp = rewriter.create<OpTy>(loc, ValueRange(current).getTypes(), inputs, UnitAttr());
+        for (auto [oldQubit, newQubit] : llvm::zip(current, newOp.getOutQubits())) {
+            rewriter.replaceAllUsesWith(oldQubit, newQubit);
+        }
+
+        llvm::sort(ops, [](Operation *lhs, Operation *rhs) { return rhs->isBeforeInBlock(lhs); });
+        for (Operation *op : ops) {
+            rewriter.eraseOp(op);
+        }
+        return success();
+    }
+};
+
+/// Recognize the canonical decomposition of the quantum Fourier transform on n wires:
+///
+///     for i in 0..n-1:
+///         Hadamard(i)
+///         for j in i+1..n-1:
+///             ControlledPhaseShift(pi / 2^(j-i), [j, i])
+///     for i in 0..n/2-1:
+///         SWAP(i, n-1-i)
+///
+/// The match is anchored on the first Hadamard gate, and the wires are discovered through the
+/// controlled phase shifts that follow it.
+struct QFTRecognitionPattern : public OpRewritePattern<CustomOp> {
+    using OpRewritePattern<CustomOp>::OpRewritePattern;
+
+    LogicalResult matchAndRewrite(CustomOp op, PatternRewriter &rewriter) const override
+    {
+        if (op.getGateName() != "Hadamard" || op.getInQubits().size() != 1) {
+            return failure();
+        }
+
+        WireTracker tracker;
+        tracker.addWire(op.getInQubits().front(), op.getOutQubits().front());
+        tracker.ops.push_back(op);
+
+        for (int k = 1;; k++) {
+            CustomOp gate = getNextGate(tracker.current[0], "ControlledPhaseShift");
+            if (!gate || gate.getInQubits().size() != 2 ||
+                !hasAngle(gate, std::ldexp(llvm::numbers::pi, -k))) {
+                break;
+            }
+
+            size_t pos = gate.getInQubits()[0] == tracker.current[0] ? 0 : 1;
+            Value other = gate.getInQubits()[1 - pos];
+            if (llvm::is_contained(tracker.current, other)) {
+                break;
+            }
+
+            tracker.current[0] = gate.getOutQubits()[pos];
+            tracker.addWire(other, gate.getOutQubits()[1 - pos]);
+            tracker.ops.push_back(gate);
+        }
+
+        const size_t numWires = tracker.current.size();
+        if (numWires < 2) {
+            return failure();
+        }
+
+        for (size_t i = 1; i < numWires; i++) {
+            if (!tracker.advance("Hadamard", {i})) {
+                return failure();
+            }
+            for (size_t j = i + 1; j < numWires; j++) {
+                double angle = std::ldexp(llvm::numbers::pi, -static_cast<int>(j - i));
+                if (!tracker.advance("ControlledPhaseShift", {j, i}, angle, /*symmetric=*/true)) {
+                    return failure();
+                }
+            }
+        }
+
+        for (size_t i = 0; i < numWires / 2; i++) {
+            if (!tracker.advance("SWAP", {i, numWires - 1 - i}, std::nullopt,
+                                 /*symmetric=*/true)) {
+                return failure();
+            }
+        }
+
+        LLVM_DEBUG(dbgs() << "recognized QFT on " << numWires << " wires\n");
+        return tracker.replace<QFTOp>(rewriter, op.getLoc());
+    }
+};
+
+/// Recognize the Grover diffusion circuit on n wires, made of Hadamard and PauliX layers around a
+/// multi-controlled Z gate:
+///
+///     H^n X^n MCZ X^n H^n
+///
+/// where MCZ is either a CZ gate, or a CNOT or Toffoli gate conjugated by Hadamard gates on its
+/// target. The match is anchored on the multi-controlled gate.
+struct ReflectUniformRecognitionPattern : public OpRewritePattern<CustomOp> {
+    using OpRewritePattern<CustomOp>::OpRewritePattern;
+
+    LogicalResult matchAndRewrite(CustomOp op, PatternRewriter &rewriter) const override
+    {
+        StringRef name = op.getGateName();
+        const size_t numWires = op.getInQubits().size();
+        if (!op.getParams().empty() ||
+            !((name == "CZ" && numWires == 2) || (name == "CNOT" && numWires == 2) ||
+              (name == "Toffoli" && numWires == 3))) {
+            return failure();
+        }
+
+        // Inputs and outputs of the multi-controlled Z gate.
+        SmallVector<Operation *> ops = {op};
+        SmallVector<Value> mczInputs(op.getInQubits());
+        SmallVector<Value> mczOutputs(op.getOutQubits());
+        if (name != "CZ") {
+            CustomOp pre = getPrevGate(mczInputs.back(), "Hadamard");
+            CustomOp post = getNextGate(mczOutputs.back(), "Hadamard");
+            if (!pre || !post) {
+                return failure();
+            }
+            mczInputs.back() = pre.getInQubits().front();
+            mczOutputs.back() = post.getOutQubits().front();
+            ops.append({pre, post});
+        }
+
+        WireTracker tracker;
+        for (auto [input, output] : llvm::zip(mczInputs, mczOutputs)) {
+            CustomOp xPre = getPrevGate(input, "PauliX");
+            CustomOp xPost = getNextGate(output, "PauliX");
+            if (!xPre || !xPost) {
+                return failure();
+            }
+            CustomOp hPre = getPrevGate(xPre.getInQubits().front(), "Hadamard");
+            CustomOp hPost = getNextGate(xPost.getOutQubits().front(), "Hadamard");
+            if (!hPre || !hPost) {
+                return failure();
+            }
+            tracker.addWire(hPre.getInQubits().front(), hPost.getOutQubits().front());
+            tracker.ops.append({hPre, xPre, xPost, hPost});
+        }
+        tracker.ops.append(ops);
+
+        LLVM_DEBUG(dbgs() << "recognized Grover diffusion on " << numWires << " wires\n");
+        return tracker.replace<ReflectUniformOp>(rewriter, op.getLoc());
+    }
+};
+
+} // namespace
+
+namespace catalyst {
+namespace quantum {
+
+void populateSubcircuitRecognitionPatterns(RewritePatternSet &patterns)
+{
+    patterns.add<QFTRecognitionPattern>(patterns.getContext(), 1);
+    patterns.add<ReflectUniformRecognitionPattern>(patterns.getContext(), 1);
+}
+
+} // namespace quantum
+} // namespace catalyst
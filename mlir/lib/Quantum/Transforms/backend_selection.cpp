@@ -0,0 +1,237 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define DEBUG_TYPE "backends"
+
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/Debug.h"
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Pass/Pass.h"
+
+#include "Gradient/Utils/DifferentialQNode.h"
+#include "Quantum/IR/QuantumOps.h"
+
+using namespace llvm;
+using namespace mlir;
+using namespace catalyst::quantum;
+
+namespace catalyst {
+namespace quantum {
+
+#define GEN_PASS_DEF_BACKENDSELECTIONPASS
+#include "Quantum/Transforms/Passes.h.inc"
+
+namespace {
+
+constexpr StringLiteral circuitClassAttrName = "quantum.circuit_class";
+
+/// Gates mapping basis states to basis states.
+bool isPermutationGate(StringRef name)
+{
+    return StringSwitch<bool>(name)
+        .Cases("Identity", "PauliX", "CNOT", "SWAP", "Toffoli", "CSWAP", true)
+        .Default(false);
+}
+
+/// Gates of the Clifford group, which admit an efficient stabilizer simulation.
+bool isCliffordGate(StringRef name)
+{
+    return StringSwitch<bool>(name)
+        .Cases("Identity", "PauliX", "PauliY", "PauliZ", "Hadamard", "S", true)
+        .Cases("CNOT", "CY", "CZ", "SWAP", true)
+        .Default(false);
+}
+
+/// The backends this pass is allowed to substitute for one another.
+bool isLightningBackend(StringRef name)
+{
+    return name == "LightningSimulator" || name == "LightningKokkosSimulator";
+}
+
+/// Whether the device kwargs only hold the keys read by all the backends above, such that the
+/// device can be substituted without dropping any of them.
+bool hasPortableKwargs(StringRef kwargs)
+{
+    SmallVector<StringRef> entries;
+    kwargs.trim().trim("{}").split(entries, ',', /*MaxSplit=*/-1, /*KeepEmpty=*/false);
+    return llvm::all_of(entries, [](StringRef entry) {
+        StringRef key = entry.split(':').first.trim().trim("'\"");
+        return key.empty() || key == "shots";
+    });
+}
+
+std::optional<int64_t> getConstantIndex(Value value)
+{
+    APInt index;
+    if (value && matchPattern(value, m_ConstantInt(&index))) {
+        return index.getSExtValue();
+    }
+    return std::nullopt;
+}
+
+/// Structural properties of the circuit of a qnode.
+struct CircuitInfo {
+    bool permutation = true;
+    bool clifford = true;
+    // Multi-qubit gates only act on two neighbouring wires, as suited to 1D
+    // tensor-network methods.
+    bool nearestNeighbour = true;
+    // Total number of allocated qubits, if known at compile time.
+    std::optional<int64_t> numQubits = 0;
+
+    StringRef getCircuitClass() const
+    {
+        if (permutation) {
+            return "permutation";
+        }
+        if (clifford) {
+            return "clifford";
+        }
+        if (nearestNeighbour) {
+            return "nearest_neighbour";
+        }
+        return "general";
+    }
+};
+
+CircuitInfo analyzeCircuit(func::FuncOp qnode)
+{
+    CircuitInfo info;
+    // The wire of the qubits extracted at a constant index, propagated through gates.
+    DenseMap<Value, int64_t> wires;
+
+    qnode.walk([&](Operation *op) {
+        if (auto alloc = dyn_cast<AllocOp>(op)) {
+            std::optional<int64_t> nqubits = alloc.getNqubitsAttr();
+            if (!nqubits) {
+                nqubits = getConstantIndex(alloc.getNqubits());
+            }
+            info.numQubits = nqubits && info.numQubits
+                                 ? std::optional<int64_t>(*info.numQubits + *nqubits)
+                                 : std::nullopt;
+            return;
+        }
+        if (auto extract = dyn_cast<ExtractOp>(op)) {
+            std::optional<int64_t> idx = extract.getIdxAttr();
+            if (!idx) {
+                idx = getConstantIndex(extract.getIdx());
+            }
+            if (idx) {
+                wires[extract.getQubit()] = *idx;
+            }
+            return;
+        }
+
+        auto gate = dyn_cast<QuantumGate>(op);
+        if (!gate) {
+            return;
+        }
+
+        auto custom = dyn_cast<CustomOp>(op);
+        info.permutation &= custom && isPermutationGate(custom.getGateName());
+        info.clifford &= custom && isCliffordGate(custom.getGateName());
+
+        SmallVector<std::optional<int64_t>> gateWires;
+        for (auto [input, output] : zip(gate.getQubitOperands(), gate.getQubitResults())) {
+            auto it = wires.find(input);
+            std::optional<int64_t> wire =
+                it == wires.end() ? std::nullopt : std::optional<int64_t>(it->second);
+            if (wire) {
+                wires[output] = *wire;
+            }
+            gateWires.push_back(wire);
+        }
+        if (gateWires.size() > 2 ||
+            (gateWires.size() == 2 && (!gateWires[0] || !gateWires[1] ||
+                                       std::abs(*gateWires[0] - *gateWires[1]) != 1))) {
+            info.nearestNeighbour = false;
+        }
+    });
+    return info;
+}
+
+struct BackendSelectionPass : impl::BackendSelectionPassBase<BackendSelectionPass> {
+    using BackendSelectionPassBase::BackendSelectionPassBase;
+
+    void runOnOperation() final
+    {
+        getOperation()->walk([&](func::FuncOp func) {
+            if (!gradient::isQNode(func)) {
+                return;
+            }
+
+            CircuitInfo info = analyzeCircuit(func);
+            func->setAttr(circuitClassAttrName,
+                          StringAttr::get(&getContext(), info.getCircuitClass()));
+
+            // The device requested by the user is kept for circuits of unknown width.
+            if (!info.numQubits) {
+                return;
+            }
+            StringRef backends = *info.numQubits <= static_cast<int64_t>(smallQubits)
+                                     ? StringRef(smallBackends)
+                                     : StringRef(largeBackends);
+
+            func.walk([&](DeviceInitOp device) {
+                StringRef requested = device.getName();
+                if (!isLightningBackend(requested)) {
+                    return;
+                }
+                // Options specific to the requested backend, e.g. its sampler or threading, are
+                // kept along with it.
+                if (!hasPortableKwargs(device.getKwargs())) {
+                    LLVM_DEBUG(dbgs() << "keeping " << requested << " for " << func.getSymName()
+                                      << " with kwargs " << device.getKwargs() << "\n");
+                    return;
+                }
+
+                // The requested backend remains the last alternative, so that a runtime built
+                // with none of the selected backends still loads it.
+                SmallVector<StringRef> alternatives;
+                backends.split(alternatives, '|', /*MaxSplit=*/-1, /*KeepEmpty=*/false);
+                std::string selected = backends.str();
+                if (!llvm::is_contained(alternatives, requested)) {
+                    selected += ("|" + requested).str();
+                }
+
+                LLVM_DEBUG(dbgs() << "selecting backends " << selected << " for "
+                                  << func.getSymName() << " on " << *info.numQubits
+                                  << " qubits\n");
+                device.setNameAttr(StringAttr::get(&getContext(), selected));
+            });
+        });
+    }
+};
+
+} // namespace
+
+} // namespace quantum
+
+std::unique_ptr<Pass> createBackendSelectionPass()
+{
+    return std::make_unique<quantum::BackendSelectionPass>();
+}
+
+} // namespace catalyst
@@ -0,0 +1,96 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define DEBUG_TYPE "deviceprefetch"
+
+#include <memory>
+#include <tuple>
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Debug.h"
+
+#include "mlir/IR/Builders.h"
+#include "mlir/Pass/Pass.h"
+
+#include "Quantum/IR/QuantumOps.h"
+
+using namespace llvm;
+using namespace mlir;
+using namespace catalyst::quantum;
+
+namespace catalyst {
+namespace quantum {
+
+#define GEN_PASS_DEF_DEVICEPREFETCHPASS
+#include "Quantum/Transforms/Passes.h.inc"
+
+namespace {
+
+using DeviceSpec = std::tuple<StringAttr, StringAttr, StringAttr>;
+
+template <typename T> DeviceSpec getDeviceSpec(T op)
+{
+    return {op.getLibAttr(), op.getNameAttr(), op.getKwargsAttr()};
+}
+
+} // namespace
+
+struct DevicePrefetchPass : impl::DevicePrefetchPassBase<DevicePrefetchPass> {
+    using DevicePrefetchPassBase::DevicePrefetchPassBase;
+
+    void runOnOperation() final
+    {
+        // The distinct devices of the program, in order of appearance
+        SmallVector<DeviceSpec> devices;
+        getOperation()->walk([&](DeviceInitOp op) {
+            DeviceSpec device = getDeviceSpec(op);
+            if (!llvm::is_contained(devices, device)) {
+                devices.push_back(device);
+            }
+        });
+        if (devices.empty()) {
+            return;
+        }
+
+        getOperation()->walk([&](InitializeOp init) {
+            // Devices already prefetched after this initialization are skipped
+            SmallVector<DeviceSpec> prefetched;
+            for (Operation *op = init->getNextNode(); op && isa<DevicePrefetchOp>(op);
+                 op = op->getNextNode()) {
+                prefetched.push_back(getDeviceSpec(cast<DevicePrefetchOp>(op)));
+            }
+
+            OpBuilder builder(init->getContext());
+            builder.setInsertionPointAfter(init);
+            for (auto [lib, name, kwargs] : devices) {
+                if (llvm::is_contained(prefetched, DeviceSpec{lib, name, kwargs})) {
+                    continue;
+                }
+                LLVM_DEBUG(dbgs() << "prefetching device " << name.getValue() << " of "
+                                  << lib.getValue() << "\n");
+                builder.create<DevicePrefetchOp>(init.getLoc(), lib, name, kwargs);
+            }
+        });
+    }
+};
+
+} // namespace quantum
+
+std::unique_ptr<Pass> createDevicePrefetchPass()
+{
+    return std::make_unique<quantum::DevicePrefetchPass>();
+}
+
+} // namespace catalyst
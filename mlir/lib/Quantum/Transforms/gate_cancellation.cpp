@@ -0,0 +1,125 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define DEBUG_TYPE "cancellation"
+
+#include <memory>
+
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/Debug.h"
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Rewrite/FrozenRewritePatternSet.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+#include "Gradient/Utils/DifferentialQNode.h"
+#include "Quantum/IR/QuantumOps.h"
+#include "Quantum/Transforms/Patterns.h"
+
+using namespace llvm;
+using namespace mlir;
+using namespace catalyst::quantum;
+
+namespace catalyst {
+namespace quantum {
+
+#define GEN_PASS_DEF_GATECANCELLATIONPASS
+#include "Quantum/Transforms/Passes.h.inc"
+
+namespace {
+
+/// Return the qnodes from which the gradient lowering derived functions, such as their
+/// `.quantum`, `.argmap` or `.adjoint` functions, named after the qnode.
+StringSet<> getDifferentiatedQNodes(Operation *root)
+{
+    StringSet<> qnodes;
+    root->walk([&](func::FuncOp func) {
+        if (gradient::isQNode(func)) {
+            qnodes.insert(func.getSymName());
+        }
+    });
+
+    StringSet<> differentiated;
+    root->walk([&](func::FuncOp func) {
+        StringRef name = func.getSymName();
+        for (size_t pos = name.find('.'); pos != StringRef::npos; pos = name.find('.', pos + 1)) {
+            if (qnodes.contains(name.take_front(pos))) {
+                differentiated.insert(name.take_front(pos));
+            }
+        }
+    });
+    return differentiated;
+}
+
+/// Whether the function is a differentiated qnode or one of the functions derived from it.
+bool isDifferentiated(func::FuncOp func, const StringSet<> &differentiated)
+{
+    StringRef name = func.getSymName();
+    if (differentiated.contains(name)) {
+        return true;
+    }
+    for (size_t pos = name.find('.'); pos != StringRef::npos; pos = name.find('.', pos + 1)) {
+        if (differentiated.contains(name.take_front(pos))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+struct GateCancellationPass : impl::GateCancellationPassBase<GateCancellationPass> {
+    using GateCancellationPassBase::GateCancellationPassBase;
+
+    void runOnOperation() final
+    {
+        LLVM_DEBUG(dbgs() << "gate cancellation pass"
+                          << "\n");
+
+        RewritePatternSet patternSet(&getContext());
+        populateCommutationPatterns(patternSet);
+        FrozenRewritePatternSet patterns(std::move(patternSet));
+
+        // The functions generated by the gradient lowering rely on the gates of the qnode they
+        // are derived from, e.g. through its parameter count and argument map, and are left as
+        // they are together with the qnode.
+        StringSet<> differentiated = getDifferentiatedQNodes(getOperation());
+        SmallVector<func::FuncOp> funcs;
+        getOperation()->walk([&](func::FuncOp func) {
+            if (isDifferentiated(func, differentiated)) {
+                LLVM_DEBUG(dbgs() << "skipping differentiated function " << func.getSymName()
+                                  << "\n");
+                return;
+            }
+            funcs.push_back(func);
+        });
+
+        for (func::FuncOp func : funcs) {
+            if (failed(applyPatternsAndFoldGreedily(func, patterns))) {
+                return signalPassFailure();
+            }
+        }
+    }
+};
+
+} // namespace quantum
+
+std::unique_ptr<Pass> createGateCancellationPass()
+{
+    return std::make_unique<quantum::GateCancellationPass>();
+}
+
+} // namespace catalyst
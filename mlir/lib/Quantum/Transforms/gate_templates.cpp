@@ -0,0 +1,314 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define DEBUG_TYPE "gatetemplates"
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "mlir/Pass/Pass.h"
+
+#include "Gradient/Utils/DifferentialQNode.h"
+#include "Quantum/IR/QuantumOps.h"
+
+using namespace llvm;
+using namespace mlir;
+using namespace catalyst::quantum;
+
+namespace catalyst {
+namespace quantum {
+
+#define GEN_PASS_DEF_GATETEMPLATEPASS
+#include "Quantum/Transforms/Passes.h.inc"
+
+namespace {
+
+template <typename IndexedOp> std::optional<int64_t> getConstantWire(IndexedOp op)
+{
+    if (std::optional<int64_t> idx = op.getIdxAttr()) {
+        return idx;
+    }
+    APInt idx;
+    if (op.getIdx() && matchPattern(op.getIdx(), m_ConstantInt(&idx))) {
+        return idx.getSExtValue();
+    }
+    return std::nullopt;
+}
+
+/// Whether the operation only computes classical values, e.g. the parameters of the gates, and
+/// can be moved before the gate sequence it appears in.
+bool isClassical(Operation *op)
+{
+    if (!isMemoryEffectFree(op)) {
+        return false;
+    }
+    auto isQuantumType = [](Type type) { return isa<QubitType, QuregType, ObservableType>(type); };
+    WalkResult result = op->walk([&](Operation *nested) {
+        bool quantum = isa_and_nonnull<QuantumDialect>(nested->getDialect()) ||
+                       any_of(nested->getOperandTypes(), isQuantumType) ||
+                       any_of(nested->getResultTypes(), isQuantumType);
+        return quantum ? WalkResult::interrupt() : WalkResult::advance();
+    });
+    return !result.wasInterrupted();
+}
+
+/// A straight-line sequence of gates of the entry block of a qnode, from its first to its last
+/// gate.
+struct GateSequence {
+    Operation *first = nullptr;
+    Operation *last = nullptr;
+    unsigned numGates = 0;
+};
+
+class TemplateRecorder {
+  public:
+    explicit TemplateRecorder(func::FuncOp qnode) : qnode(qnode) {}
+
+    /// Find the longest gate sequence of the qnode whose qubits are all statically extracted
+    /// from its register.
+    GateSequence findLongestSequence()
+    {
+        GateSequence longest;
+        GateSequence current;
+        for (Operation &op : qnode.getBody().front()) {
+            if (isa<CustomOp, MultiRZOp>(op) && hasKnownWires(&op)) {
+                current.first = current.first ? current.first : &op;
+                current.last = &op;
+                current.numGates++;
+            }
+            else if (!isTransparent(&op)) {
+                longest = current.numGates > longest.numGates ? current : longest;
+                current = GateSequence();
+            }
+            trackWires(&op);
+        }
+        return current.numGates > longest.numGates ? current : longest;
+    }
+
+    /// Guard the gate sequence with the replay of its template, and record the template when
+    /// the replay fails:
+    ///
+    ///     %replayed = quantum.replay id(params)
+    ///     scf.if %replayed {
+    ///         (the qubits of the sequence are forwarded from its inputs to its outputs)
+    ///     } else {
+    ///         quantum.toggle_template id, true
+    ///         (the gate sequence)
+    ///         quantum.toggle_template id, false
+    ///     }
+    void record(const GateSequence &sequence)
+    {
+        // The classical operations of the sequence are hoisted before it, so that the
+        // parameters of all gates are available to the replay.
+        SmallVector<Operation *> ops;
+        for (Operation *op = sequence.first; op != sequence.last->getNextNode();) {
+            Operation *next = op->getNextNode();
+            if (isClassical(op)) {
+                op->moveBefore(sequence.first);
+            }
+            else {
+                ops.push_back(op);
+            }
+            op = next;
+        }
+
+        SmallPtrSet<Operation *, 16> inSequence(ops.begin(), ops.end());
+        SmallVector<Value> params;
+        SmallVector<Value> outputs;
+        for (Operation *op : ops) {
+            if (auto gate = dyn_cast<CustomOp>(op)) {
+                params.append(gate.getParams().begin(), gate.getParams().end());
+            }
+            else if (auto gate = dyn_cast<MultiRZOp>(op)) {
+                params.push_back(gate.getTheta());
+            }
+            for (Value result : op->getResults()) {
+                if (any_of(result.getUsers(),
+                           [&](Operation *user) { return !inSequence.contains(user); })) {
+                    outputs.push_back(result);
+                }
+            }
+        }
+        if (outputs.empty()) {
+            return;
+        }
+
+        int64_t id = getTemplateId(ops);
+        LLVM_DEBUG(dbgs() << "recording " << sequence.numGates << " gates of "
+                          << qnode.getSymName() << " as template " << id << "\n");
+
+        Location loc = sequence.first->getLoc();
+        OpBuilder builder(sequence.first);
+        Value replayed = builder.create<ReplayOp>(loc, builder.getI1Type(), id, params);
+        auto ifOp = builder.create<scf::IfOp>(loc, ValueRange(outputs).getTypes(), replayed,
+                                              /*withElseRegion=*/true);
+
+        // The replay applied the gates, only the qubit and register values are left to forward.
+        builder.setInsertionPointToStart(ifOp.thenBlock());
+        IRMapping mapping;
+        for (Operation *op : ops) {
+            if (isa<ExtractOp, InsertOp>(op)) {
+                builder.clone(*op, mapping);
+                continue;
+            }
+            auto gate = cast<QuantumGate>(op);
+            for (auto [in, out] : llvm::zip(gate.getQubitOperands(), gate.getQubitResults())) {
+                mapping.map(out, mapping.lookupOrDefault(in));
+            }
+        }
+        SmallVector<Value> forwarded;
+        for (Value output : outputs) {
+            forwarded.push_back(mapping.lookupOrDefault(output));
+        }
+        builder.create<scf::YieldOp>(loc, forwarded);
+
+        builder.setInsertionPointToStart(ifOp.elseBlock());
+        builder.create<ToggleTemplateOp>(loc, id, true);
+        for (Operation *op : ops) {
+            op->moveBefore(ifOp.elseBlock(), ifOp.elseBlock()->end());
+        }
+        builder.setInsertionPointToEnd(ifOp.elseBlock());
+        builder.create<ToggleTemplateOp>(loc, id, false);
+        builder.create<scf::YieldOp>(loc, outputs);
+
+        for (auto [output, result] : llvm::zip(outputs, ifOp.getResults())) {
+            output.replaceUsesWithIf(result, [&](OpOperand &use) {
+                return !ifOp->isProperAncestor(use.getOwner());
+            });
+        }
+    }
+
+  private:
+    func::FuncOp qnode;
+    // The wires of the qubit values extracted from the register of the qnode
+    DenseMap<Value, int64_t> wires;
+
+    bool hasKnownWires(Operation *gate)
+    {
+        auto qubits = cast<QuantumGate>(gate).getQubitOperands();
+        return all_of(qubits, [&](Value qubit) { return wires.contains(qubit); });
+    }
+
+    /// Whether the operation can appear in a gate sequence without ending it.
+    bool isTransparent(Operation *op)
+    {
+        if (auto extract = dyn_cast<ExtractOp>(op)) {
+            return getConstantWire(extract).has_value();
+        }
+        if (auto insert = dyn_cast<InsertOp>(op)) {
+            return getConstantWire(insert).has_value();
+        }
+        return isClassical(op);
+    }
+
+    void trackWires(Operation *op)
+    {
+        if (auto extract = dyn_cast<ExtractOp>(op)) {
+            if (std::optional<int64_t> wire = getConstantWire(extract)) {
+                wires[extract.getQubit()] = *wire;
+            }
+        }
+        else if (auto measure = dyn_cast<MeasureOp>(op)) {
+            if (wires.contains(measure.getInQubit())) {
+                int64_t wire = wires.lookup(measure.getInQubit());
+                wires[measure.getOutQubit()] = wire;
+            }
+        }
+        else if (isa<QuantumGate>(op) && hasKnownWires(op)) {
+            auto gate = cast<QuantumGate>(op);
+            for (auto [in, out] : llvm::zip(gate.getQubitOperands(), gate.getQubitResults())) {
+                int64_t wire = wires.lookup(in);
+                wires[out] = wire;
+            }
+        }
+    }
+
+    /// Identify the template by the names, adjoint flags, number of parameters and wires of its
+    /// gates, such that the gate sequences of the same structure share their template.
+    int64_t getTemplateId(ArrayRef<Operation *> ops)
+    {
+        std::string structure;
+        raw_string_ostream os(structure);
+        for (Operation *op : ops) {
+            auto gate = dyn_cast<QuantumGate>(op);
+            if (!gate) {
+                continue;
+            }
+            if (auto custom = dyn_cast<CustomOp>(op)) {
+                os << custom.getGateName() << "(" << custom.getParams().size() << ")";
+            }
+            else {
+                os << "MultiRZ(1)";
+            }
+            os << (gate.getAdjointFlag() ? "!" : "");
+            for (Value qubit : gate.getQubitOperands()) {
+                os << " " << wires.lookup(qubit);
+            }
+            os << ";";
+        }
+        return static_cast<int64_t>(xxHash64(os.str()));
+    }
+};
+
+} // namespace
+
+struct GateTemplatePass : impl::GateTemplatePassBase<GateTemplatePass> {
+    using GateTemplatePassBase::GateTemplatePassBase;
+
+    void runOnOperation() final
+    {
+        getOperation()->walk([&](func::FuncOp func) {
+            if (!gradient::isQNode(func) || func.isExternal()) {
+                return;
+            }
+
+            // Device wires are only known from the register of a single allocation.
+            unsigned numAllocs = 0;
+            func.walk([&](AllocOp) { numAllocs++; });
+            if (numAllocs != 1) {
+                return;
+            }
+
+            TemplateRecorder recorder(func);
+            GateSequence sequence = recorder.findLongestSequence();
+            if (sequence.numGates < minGates) {
+                return;
+            }
+            recorder.record(sequence);
+        });
+    }
+};
+
+} // namespace quantum
+
+std::unique_ptr<Pass> createGateTemplatePass()
+{
+    return std::make_unique<quantum::GateTemplatePass>();
+}
+
+} // namespace catalyst
@@ -0,0 +1,500 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define DEBUG_TYPE "resources"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/TypeSwitch.h"
+#include "llvm/Support/Debug.h"
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/Pass/Pass.h"
+
+#include "Gradient/IR/GradientOps.h"
+#include "Gradient/Utils/DifferentialQNode.h"
+#include "Gradient/Utils/GradientShape.h"
+#include "Mitigation/IR/MitigationOps.h"
+#include "Quantum/IR/QuantumOps.h"
+
+using namespace llvm;
+using namespace mlir;
+using namespace catalyst::quantum;
+
+namespace catalyst {
+namespace quantum {
+
+#define GEN_PASS_DEF_RESOURCEESTIMATIONPASS
+#include "Quantum/Transforms/Passes.h.inc"
+
+namespace {
+
+constexpr StringLiteral resourcesAttrName = "quantum.resources";
+
+/// A resource count, as a polynomial with non-negative coefficients in the statically unknown
+/// loop trip counts and sizes of the module, named `n0`, `n1`, ... in their order of discovery.
+class ResourceCount {
+    // Coefficient of each monomial, given by the sorted identifiers of its unknowns.
+    std::map<std::vector<unsigned>, int64_t> terms;
+
+  public:
+    ResourceCount(int64_t value = 0)
+    {
+        if (value > 0) {
+            terms[{}] = value;
+        }
+    }
+
+    static ResourceCount unknown(unsigned id)
+    {
+        ResourceCount count;
+        count.terms[{id}] = 1;
+        return count;
+    }
+
+    bool isZero() const { return terms.empty(); }
+
+    ResourceCount &operator+=(const ResourceCount &other)
+    {
+        for (const auto &[monomial, coeff] : other.terms) {
+            terms[monomial] += coeff;
+        }
+        return *this;
+    }
+
+    ResourceCount operator*(const ResourceCount &other) const
+    {
+        ResourceCount product;
+        for (const auto &[lhsMonomial, lhsCoeff] : terms) {
+            for (const auto &[rhsMonomial, rhsCoeff] : other.terms) {
+                std::vector<unsigned> monomial;
+                std::merge(lhsMonomial.begin(), lhsMonomial.end(), rhsMonomial.begin(),
+                           rhsMonomial.end(), std::back_inserter(monomial));
+                product.terms[monomial] += lhsCoeff * rhsCoeff;
+            }
+        }
+        return product;
+    }
+
+    /// Upper bound of two counts, e.g. of the branches of a conditional.
+    static ResourceCount max(const ResourceCount &lhs, const ResourceCount &rhs)
+    {
+        ResourceCount result = lhs;
+        for (const auto &[monomial, coeff] : rhs.terms) {
+            int64_t &resultCoeff = result.terms[monomial];
+            resultCoeff = std::max(resultCoeff, coeff);
+        }
+        return result;
+    }
+
+    /// Return the count as an integer attribute if it is constant, e.g. `12`, and as a string
+    /// attribute otherwise, e.g. `"2 + 3*n0 + n0*n1"`.
+    Attribute getAttr(Builder &builder) const
+    {
+        if (terms.empty()) {
+            return builder.getI64IntegerAttr(0);
+        }
+        if (terms.size() == 1 && terms.begin()->first.empty()) {
+            return builder.getI64IntegerAttr(terms.begin()->second);
+        }
+
+        std::string str;
+        raw_string_ostream os(str);
+        ListSeparator sep(" + ");
+        for (const auto &[monomial, coeff] : terms) {
+            os << sep;
+            if (monomial.empty() || coeff != 1) {
+                os << coeff << (monomial.empty() ? "" : "*");
+            }
+            interleave(
+                monomial, os, [&](unsigned id) { os << "n" << id; }, "*");
+        }
+        return builder.getStringAttr(os.str());
+    }
+};
+
+/// Static resource counts of a function, including the functions it calls.
+struct Resources {
+    std::map<std::string, ResourceCount> gates;
+    std::map<size_t, ResourceCount> gateWidths;
+    ResourceCount gateParams;
+    ResourceCount measurements;
+    // Passes over the state-vector: one per gate and measurement, and more for adjoint gradients.
+    ResourceCount sweeps;
+    ResourceCount evaluations;
+    // Qubits allocated at the same time. Called functions allocate their qubits in turn.
+    ResourceCount qubits;
+
+    ResourceCount getNumGates() const
+    {
+        ResourceCount numGates;
+        for (const auto &entry : gates) {
+            numGates += entry.second;
+        }
+        return numGates;
+    }
+
+    bool isEmpty() const
+    {
+        return gates.empty() && measurements.isZero() && evaluations.isZero() && qubits.isZero();
+    }
+
+    /// Add the resources of a nested region or call, repeated `factor` times.
+    void add(const Resources &other, const ResourceCount &factor = 1)
+    {
+        for (const auto &[name, count] : other.gates) {
+            gates[name] += count * factor;
+        }
+        for (const auto &[width, count] : other.gateWidths) {
+            gateWidths[width] += count * factor;
+        }
+        gateParams += other.gateParams * factor;
+        measurements += other.measurements * factor;
+        sweeps += other.sweeps * factor;
+        evaluations += other.evaluations * factor;
+        qubits = ResourceCount::max(qubits, other.qubits);
+    }
+
+    /// Bound the resources by those of an alternative, e.g. the other branch of a conditional.
+    void join(const Resources &other)
+    {
+        for (const auto &[name, count] : other.gates) {
+            gates[name] = ResourceCount::max(gates[name], count);
+        }
+        for (const auto &[width, count] : other.gateWidths) {
+            gateWidths[width] = ResourceCount::max(gateWidths[width], count);
+        }
+        gateParams = ResourceCount::max(gateParams, other.gateParams);
+        measurements = ResourceCount::max(measurements, other.measurements);
+        sweeps = ResourceCount::max(sweeps, other.sweeps);
+        evaluations = ResourceCount::max(evaluations, other.evaluations);
+        qubits = ResourceCount::max(qubits, other.qubits);
+    }
+
+    DictionaryAttr getAttr(Builder &builder) const
+    {
+        SmallVector<NamedAttribute> gateAttrs;
+        for (const auto &[name, count] : gates) {
+            gateAttrs.push_back(builder.getNamedAttr(name, count.getAttr(builder)));
+        }
+        SmallVector<NamedAttribute> widthAttrs;
+        for (const auto &[width, count] : gateWidths) {
+            widthAttrs.push_back(
+                builder.getNamedAttr(std::to_string(width), count.getAttr(builder)));
+        }
+
+        return builder.getDictionaryAttr({
+            builder.getNamedAttr("gates", builder.getDictionaryAttr(gateAttrs)),
+            builder.getNamedAttr("gate_widths", builder.getDictionaryAttr(widthAttrs)),
+            builder.getNamedAttr("num_gates", getNumGates().getAttr(builder)),
+            builder.getNamedAttr("gate_params", gateParams.getAttr(builder)),
+            builder.getNamedAttr("measurements", measurements.getAttr(builder)),
+            builder.getNamedAttr("sweeps", sweeps.getAttr(builder)),
+            builder.getNamedAttr("circuit_evaluations", evaluations.getAttr(builder)),
+            builder.getNamedAttr("num_qubits", qubits.getAttr(builder)),
+        });
+    }
+};
+
+/// Compute the resources of the functions of a module, following calls, loops, and the
+/// evaluations of the quantum functions required by gradients and error mitigation.
+class ResourceAnalysis {
+    SymbolTableCollection symbolTables;
+    // Identifier of the unknown trip count or size of an operation.
+    DenseMap<Operation *, unsigned> unknowns;
+    // Resources of each function, and of its differentiation.
+    std::map<std::pair<Operation *, bool>, Resources> cache;
+    std::set<std::pair<Operation *, bool>> active;
+
+    ResourceCount getUnknown(Operation *op)
+    {
+        auto it = unknowns.try_emplace(op, unknowns.size()).first;
+        return ResourceCount::unknown(it->second);
+    }
+
+    ResourceCount getTripCount(scf::ForOp loop)
+    {
+        std::optional<int64_t> lb = getConstantIntValue(loop.getLowerBound());
+        std::optional<int64_t> ub = getConstantIntValue(loop.getUpperBound());
+        std::optional<int64_t> step = getConstantIntValue(loop.getStep());
+        if (!lb || !ub || !step || *step <= 0) {
+            return getUnknown(loop);
+        }
+        return std::max<int64_t>(0, (*ub - *lb + *step - 1) / *step);
+    }
+
+    func::FuncOp lookupCallee(Operation *op, FlatSymbolRefAttr callee)
+    {
+        return symbolTables.lookupNearestSymbolFrom<func::FuncOp>(op, callee);
+    }
+
+    static StringRef getGateName(QuantumGate gate)
+    {
+        return TypeSwitch<Operation *, StringRef>(gate)
+            .Case<CustomOp>([](auto op) { return op.getGateName(); })
+            .Case<MultiRZOp>([](auto) { return "MultiRZ"; })
+            .Case<QubitUnitaryOp>([](auto) { return "QubitUnitary"; })
+            .Case<QFTOp>([](auto) { return "QFT"; })
+            .Case<ReflectUniformOp>([](auto) { return "ReflectUniform"; })
+            .Default([](Operation *op) { return op->getName().stripDialect(); });
+    }
+
+    /// The gradient of a quantum function repeats its evaluation, twice per gate parameter with
+    /// the parameter-shift method, or adds reverse sweeps over the state-vector with the adjoint
+    /// method.
+    static Resources differentiateQNode(func::FuncOp qnode, const Resources &resources)
+    {
+        Resources gradient;
+        if (gradient::getQNodeDiffMethod(qnode) == "adjoint") {
+            gradient = resources;
+            gradient.sweeps += resources.sweeps * 2;
+            gradient.sweeps += resources.gateParams;
+            return gradient;
+        }
+        ResourceCount numShifts = resources.gateParams * 2;
+        numShifts += 1;
+        gradient.add(resources, numShifts);
+        return gradient;
+    }
+
+    void addGradient(Operation *op, StringRef method, FlatSymbolRefAttr calleeAttr,
+                     ValueRange args, std::optional<DenseIntElementsAttr> diffArgIndices,
+                     Resources &resources)
+    {
+        func::FuncOp callee = lookupCallee(op, calleeAttr);
+        if (!callee) {
+            return;
+        }
+        if (method != "fd") {
+            resources.add(analyzeFunction(callee, /*differentiate=*/true));
+            return;
+        }
+
+        // One evaluation of the callee per differentiable scalar, on top of the primal one.
+        ResourceCount numEvaluations = 1;
+        for (size_t idx : gradient::computeDiffArgIndices(diffArgIndices)) {
+            if (idx >= args.size()) {
+                continue;
+            }
+            auto type = dyn_cast<ShapedType>(args[idx].getType());
+            if (!type) {
+                numEvaluations += 1;
+            }
+            else if (type.hasStaticShape()) {
+                numEvaluations += type.getNumElements();
+            }
+            else {
+                numEvaluations += getUnknown(op);
+            }
+        }
+        resources.add(analyzeFunction(callee, /*differentiate=*/false), numEvaluations);
+    }
+
+    /// Zero-noise extrapolation evaluates the callee once per scale factor, on a circuit folded to
+    /// about that many times its gates.
+    void addZne(mitigation::ZneOp op, bool differentiate, Resources &resources)
+    {
+        func::FuncOp callee = lookupCallee(op, op.getCalleeAttr());
+        if (!callee) {
+            return;
+        }
+        Resources circuit = analyzeFunction(callee, differentiate);
+
+        ResourceCount numFactors;
+        ResourceCount numFolds;
+        DenseIntElementsAttr factors;
+        if (matchPattern(op.getScalarFactors(), m_Constant(&factors))) {
+            for (const APInt &factor : factors.getValues<APInt>()) {
+                numFactors += 1;
+                numFolds += std::max<int64_t>(0, factor.getSExtValue() - 1);
+            }
+        }
+        else {
+            auto type = cast<ShapedType>(op.getScalarFactors().getType());
+            numFactors = type.hasStaticShape() ? ResourceCount(type.getNumElements())
+                                               : getUnknown(op);
+            numFolds = getUnknown(op);
+        }
+
+        Resources folds;
+        folds.gates = circuit.gates;
+        folds.gateWidths = circuit.gateWidths;
+        folds.gateParams = circuit.gateParams;
+        folds.sweeps = circuit.getNumGates();
+        resources.add(circuit, numFactors);
+        resources.add(folds, numFolds);
+    }
+
+    void analyzeOp(Operation *op, bool differentiate, Resources &resources)
+    {
+        if (auto gate = dyn_cast<QuantumGate>(op)) {
+            resources.gates[getGateName(gate).str()] += 1;
+            resources.gateWidths[gate.getQubitOperands().size()] += 1;
+            resources.sweeps += 1;
+            if (auto diffGate = dyn_cast<DifferentiableGate>(op)) {
+                resources.gateParams += diffGate.getDiffParams().size();
+            }
+            return;
+        }
+        if (isa<MeasureOp, MeasurementProcess>(op)) {
+            resources.measurements += 1;
+            resources.sweeps += 1;
+            return;
+        }
+        if (auto alloc = dyn_cast<AllocOp>(op)) {
+            APInt nqubits;
+            if (std::optional<uint64_t> attr = alloc.getNqubitsAttr()) {
+                resources.qubits += *attr;
+            }
+            else if (matchPattern(alloc.getNqubits(), m_ConstantInt(&nqubits))) {
+                resources.qubits += nqubits.getSExtValue();
+            }
+            else {
+                resources.qubits += getUnknown(op);
+            }
+            return;
+        }
+        if (auto call = dyn_cast<func::CallOp>(op)) {
+            if (func::FuncOp callee = lookupCallee(op, call.getCalleeAttr())) {
+                resources.add(analyzeFunction(callee, differentiate));
+            }
+            return;
+        }
+        if (auto loop = dyn_cast<scf::ForOp>(op)) {
+            ResourceCount tripCount = getTripCount(loop);
+            resources.add(analyzeRegion(loop.getRegion(), differentiate), tripCount);
+            return;
+        }
+        if (auto loop = dyn_cast<scf::WhileOp>(op)) {
+            ResourceCount tripCount = getUnknown(op);
+            Resources iteration = analyzeRegion(loop.getBefore(), differentiate);
+            iteration.add(analyzeRegion(loop.getAfter(), differentiate));
+            resources.add(iteration, tripCount);
+            return;
+        }
+        if (auto ifOp = dyn_cast<scf::IfOp>(op)) {
+            Resources branches = analyzeRegion(ifOp.getThenRegion(), differentiate);
+            branches.join(analyzeRegion(ifOp.getElseRegion(), differentiate));
+            resources.add(branches);
+            return;
+        }
+        if (auto grad = dyn_cast<gradient::GradOp>(op)) {
+            addGradient(op, grad.getMethod(), grad.getCalleeAttr(), grad.getArgOperands(),
+                        grad.getDiffArgIndices(), resources);
+            return;
+        }
+        if (auto jvp = dyn_cast<gradient::JVPOp>(op)) {
+            addGradient(op, jvp.getMethod(), jvp.getCalleeAttr(), jvp.getParams(),
+                        jvp.getDiffArgIndices(), resources);
+            return;
+        }
+        if (auto vjp = dyn_cast<gradient::VJPOp>(op)) {
+            addGradient(op, vjp.getMethod(), vjp.getCalleeAttr(), vjp.getParams(),
+                        vjp.getDiffArgIndices(), resources);
+            return;
+        }
+        if (auto zne = dyn_cast<mitigation::ZneOp>(op)) {
+            addZne(zne, differentiate, resources);
+            return;
+        }
+
+        for (Region &region : op->getRegions()) {
+            resources.add(analyzeRegion(region, differentiate));
+        }
+    }
+
+    Resources analyzeRegion(Region &region, bool differentiate)
+    {
+        Resources resources;
+        for (Block &block : region) {
+            for (Operation &op : block) {
+                analyzeOp(&op, differentiate, resources);
+            }
+        }
+        return resources;
+    }
+
+  public:
+    /// Return the resources of a function, or of its differentiation. Recursive calls are not
+    /// counted.
+    Resources analyzeFunction(func::FuncOp func, bool differentiate)
+    {
+        auto key = std::make_pair(func.getOperation(), differentiate);
+        if (auto it = cache.find(key); it != cache.end()) {
+            return it->second;
+        }
+        if (func.isExternal() || !active.insert(key).second) {
+            return {};
+        }
+
+        const bool isQNode = gradient::isQNode(func);
+        Resources resources = analyzeRegion(func.getBody(), differentiate && !isQNode);
+        if (isQNode) {
+            resources.evaluations += 1;
+            if (differentiate) {
+                resources = differentiateQNode(func, resources);
+            }
+        }
+
+        active.erase(key);
+        cache[key] = resources;
+        return resources;
+    }
+};
+
+} // namespace
+
+struct ResourceEstimationPass : impl::ResourceEstimationPassBase<ResourceEstimationPass> {
+    using ResourceEstimationPassBase::ResourceEstimationPassBase;
+
+    void runOnOperation() final
+    {
+        LLVM_DEBUG(dbgs() << "resource estimation pass"
+                          << "\n");
+
+        ResourceAnalysis analysis;
+        Builder builder(&getContext());
+        getOperation()->walk([&](func::FuncOp func) {
+            Resources resources = analysis.analyzeFunction(func, /*differentiate=*/false);
+            if (!resources.isEmpty()) {
+                func->setAttr(resourcesAttrName, resources.getAttr(builder));
+            }
+        });
+    }
+};
+
+} // namespace quantum
+
+std::unique_ptr<Pass> createResourceEstimationPass()
+{
+    return std::make_unique<quantum::ResourceEstimationPass>();
+}
+
+} // namespace catalyst
@@ -0,0 +1,61 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define DEBUG_TYPE "subcircuits"
+
+#include <memory>
+
+#include "llvm/Support/Debug.h"
+
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+#include "Quantum/IR/QuantumOps.h"
+#include "Quantum/Transforms/Patterns.h"
+
+using namespace llvm;
+using namespace mlir;
+using namespace catalyst::quantum;
+
+namespace catalyst {
+namespace quantum {
+
+#define GEN_PASS_DEF_SUBCIRCUITRECOGNITIONPASS
+#include "Quantum/Transforms/Passes.h.inc"
+
+struct SubcircuitRecognitionPass
+    : impl::SubcircuitRecognitionPassBase<SubcircuitRecognitionPass> {
+    using SubcircuitRecognitionPassBase::SubcircuitRecognitionPassBase;
+
+    void runOnOperation() final
+    {
+        LLVM_DEBUG(dbgs() << "subcircuit recognition pass"
+                          << "\n");
+
+        RewritePatternSet patterns(&getContext());
+        populateSubcircuitRecognitionPatterns(patterns);
+        if (failed(applyPatternsAndFoldGreedily(getOperation(), std::move(patterns)))) {
+            return signalPassFailure();
+        }
+    }
+};
+
+} // namespace quantum
+
+std::unique_ptr<Pass> createSubcircuitRecognitionPass()
+{
+    return std::make_unique<quantum::SubcircuitRecognitionPass>();
+}
+
+} // namespace catalyst
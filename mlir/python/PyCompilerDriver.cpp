@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <iostream>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -71,13 +72,17 @@ PYBIND11_MODULE(compiler_driver, m)
         .def("get_function_attributes",
              [](const CompilerOutput &co) -> FunctionAttributes { return co.inferredAttributes; })
         .def("get_diagnostic_messages",
-             [](const CompilerOutput &co) -> std::string { return co.diagnosticMessages; });
+             [](const CompilerOutput &co) -> std::string { return co.diagnosticMessages; })
+        .def("get_resource_estimates",
+             [](const CompilerOutput &co) -> std::map<std::string, ResourceEstimates> {
+                 return co.resourceEstimates;
+             });
 
     m.def(
         "run_compiler_driver",
         [](const char *source, const char *workspace, const char *moduleName, bool keepIntermediate,
-           bool verbose, py::list pipelines,
-           bool lower_to_llvm) -> std::unique_ptr<CompilerOutput> {
+           bool verbose, py::list pipelines, bool lower_to_llvm,
+           const char *cacheDir) -> std::unique_ptr<CompilerOutput> {
             std::unique_ptr<CompilerOutput> output(new CompilerOutput());
             assert(output);
 
@@ -90,7 +95,8 @@ PYBIND11_MODULE(compiler_driver, m)
                                     .keepIntermediate = keepIntermediate,
                                     .verbosity = verbose ? Verbosity::All : Verbosity::Urgent,
                                     .pipelinesCfg = parseCompilerSpec(pipelines),
-                                    .lowerToLLVM = lower_to_llvm};
+                                    .lowerToLLVM = lower_to_llvm,
+                                    .cacheDir = cacheDir};
 
             errStream.flush();
 
@@ -101,5 +107,6 @@ PYBIND11_MODULE(compiler_driver, m)
         },
         py::arg("source"), py::arg("workspace"), py::arg("module_name") = "jit source",
         py::arg("keep_intermediate") = false, py::arg("verbose") = false,
-        py::arg("pipelines") = py::list(), py::arg("lower_to_llvm") = true);
+        py::arg("pipelines") = py::list(), py::arg("lower_to_llvm") = true,
+        py::arg("cache_dir") = "");
 }
@@ -0,0 +1,96 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// RUN: quantum-opt --specialize-qnode-constants --split-input-file %s | FileCheck %s
+
+// Test that a constant argument of a qnode is propagated into a specialization.
+
+module @workflow {
+  // CHECK-LABEL: func.func private @circuit(
+  // CHECK-SAME:    %arg0: f64, %arg1: f64)
+  func.func private @circuit(%arg0: f64, %arg1: f64) -> !quantum.bit attributes {qnode} {
+    %0 = quantum.alloc( 1) : !quantum.reg
+    %1 = quantum.extract %0[ 0] : !quantum.reg -> !quantum.bit
+    %2 = quantum.custom "RX"(%arg0) %1 : !quantum.bit
+    %3 = quantum.custom "RY"(%arg1) %2 : !quantum.bit
+    return %3 : !quantum.bit
+  }
+
+  // CHECK-LABEL: func.func private @circuit.specialized(
+  // CHECK-SAME:    [[ARG:%.+]]: f64)
+  // CHECK-SAME:    specialization_of = @circuit
+  // CHECK-SAME:    specialized_args = [5.000000e-01 : f64, unit]
+  // CHECK:         [[CST:%.+]] = arith.constant 5.000000e-01 : f64
+  // CHECK:         quantum.custom "RX"([[CST]])
+  // CHECK:         quantum.custom "RY"([[ARG]])
+
+  // CHECK-LABEL: func.func public @jit_workflow(
+  // CHECK-SAME:    [[X:%.+]]: f64)
+  func.func public @jit_workflow(%arg0: f64) -> !quantum.bit {
+    %cst = arith.constant 5.000000e-01 : f64
+    // CHECK: call @circuit.specialized([[X]]) : (f64) -> !quantum.bit
+    %0 = call @circuit(%cst, %arg0) : (f64, f64) -> !quantum.bit
+    return %0 : !quantum.bit
+  }
+}
+
+// -----
+
+// Test that calls with the same constants share a specialization, and that calls
+// with other constants get their own.
+
+module @workflow {
+  func.func private @circuit(%arg0: f64) -> !quantum.bit attributes {qnode} {
+    %0 = quantum.alloc( 1) : !quantum.reg
+    %1 = quantum.extract %0[ 0] : !quantum.reg -> !quantum.bit
+    %2 = quantum.custom "RX"(%arg0) %1 : !quantum.bit
+    return %2 : !quantum.bit
+  }
+
+  // CHECK-DAG: func.func private @circuit.specialized() {{.*}}specialized_args = [5.000000e-01 : f64]
+  // CHECK-DAG: func.func private @circuit.specialized.1() {{.*}}specialized_args = [2.500000e-01 : f64]
+
+  // CHECK-LABEL: func.func public @jit_workflow
+  func.func public @jit_workflow() -> (!quantum.bit, !quantum.bit, !quantum.bit) {
+    %cst = arith.constant 5.000000e-01 : f64
+    %cst_0 = arith.constant 2.500000e-01 : f64
+    // CHECK: call @circuit.specialized() : () -> !quantum.bit
+    // CHECK: call @circuit.specialized() : () -> !quantum.bit
+    // CHECK: call @circuit.specialized.1() : () -> !quantum.bit
+    %0 = call @circuit(%cst) : (f64) -> !quantum.bit
+    %1 = call @circuit(%cst) : (f64) -> !quantum.bit
+    %2 = call @circuit(%cst_0) : (f64) -> !quantum.bit
+    return %0, %1, %2 : !quantum.bit, !quantum.bit, !quantum.bit
+  }
+}
+
+// -----
+
+// Test that calls to functions other than qnodes are left unchanged.
+
+module @workflow {
+  func.func private @classical(%arg0: f64) -> f64 {
+    %0 = arith.mulf %arg0, %arg0 : f64
+    return %0 : f64
+  }
+
+  // CHECK-NOT: specialized
+  // CHECK-LABEL: func.func public @jit_workflow
+  func.func public @jit_workflow() -> f64 {
+    %cst = arith.constant 5.000000e-01 : f64
+    // CHECK: call @classical({{%.+}}) : (f64) -> f64
+    %0 = call @classical(%cst) : (f64) -> f64
+    return %0 : f64
+  }
+}
@@ -22,6 +22,16 @@ func.func private @funcScalarScalar(%arg0: f64) -> f64 attributes {qnode, diff_m
     return %arg0 : f64
 }
 
+// CHECK-LABEL: @funcScalarScalar.fusedadjoint(%arg0: f64, %arg1: index) -> (f64, tensor<?xf64>)
+    // CHECK-NEXT:   [[RES:%.+]]:2 = gradient.adjoint @funcScalarScalar.withreg(%arg0) size(%arg1) : (f64) -> (f64, tensor<?xf64>)
+    // CHECK-NEXT:   return [[RES]]#0, [[RES]]#1
+// }
+
+// CHECK-LABEL: @funcScalarScalar.withreg(%arg0: f64) -> (f64, !quantum.reg)
+    // CHECK-NOT:    quantum.dealloc
+    // CHECK:        return %arg0, {{%.+}} : f64, !quantum.reg
+// }
+
 // CHECK-LABEL: @funcScalarScalar.adjoint(%arg0: f64, %arg1: index) -> tensor<?xf64>
     // CHECK-NEXT:   [[GRAD:%.+]] = gradient.adjoint @funcScalarScalar.nodealloc(%arg0)
     // CHECK-NEXT:   return [[GRAD]]
@@ -30,6 +30,19 @@ func.func @adjoint(%arg0: f64, %arg1: index) {
 
 // -----
 
+func.func private @circuit.withreg(%arg0: f64) -> (tensor<f64>, !quantum.reg)
+
+// CHECK-LABEL: @fused_adjoint
+func.func @fused_adjoint(%arg0: f64, %arg1: index) -> (tensor<f64>, tensor<?xf64>) {
+
+    // CHECK:   [[alloc:%.+]] = memref.alloc(%arg1) : memref<?xf64>
+    // CHECK:   [[res:%.+]] = gradient.adjoint @circuit.withreg(%arg0) size(%arg1) in([[alloc]] : memref<?xf64>) : (f64) -> memref<f64>
+    %res:2 = gradient.adjoint @circuit.withreg(%arg0) size(%arg1) : (f64) -> (tensor<f64>, tensor<?xf64>)
+    return %res#0, %res#1 : tensor<f64>, tensor<?xf64>
+}
+
+// -----
+
 func.func private @circuit2(%arg0: f64)
 
 // CHECK-LABEL: @backprop
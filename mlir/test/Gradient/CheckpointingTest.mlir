@@ -0,0 +1,76 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// RUN: quantum-opt %s --lower-gradients --split-input-file | FileCheck %s
+
+// Check the backpropagation through a loop split into checkpointed segments
+func.func private @loop(%arg0: f64) -> f64 {
+    %c0 = arith.constant 0 : index
+    %c10 = arith.constant 10 : index
+    %c1 = arith.constant 1 : index
+    %0 = scf.for %i = %c0 to %c10 step %c1 iter_args(%x = %arg0) -> (f64) {
+        %1 = arith.mulf %x, %x : f64
+        scf.yield %1 : f64
+    }
+    %2 = arith.addf %0, %arg0 : f64
+    return %2 : f64
+}
+
+// CHECK-LABEL: func.func private @loop.epilogue(%arg0: f64, %arg1: f64) -> f64
+    // CHECK:        [[res:%.+]] = arith.addf %arg1, %arg0 : f64
+    // CHECK:        return [[res]]
+
+// CHECK-LABEL: func.func private @loop.segment(%arg0: index, %arg1: index, %arg2: f64, %arg3: f64) -> f64
+    // CHECK:        [[seg:%.+]] = scf.for {{%.+}} = %arg0 to %arg1 step {{%.+}} iter_args({{%.+}} = %arg2) -> (f64)
+    // CHECK:        return [[seg]]
+
+// CHECK-LABEL: @gradLoop(%arg0: f64, %arg1: tensor<f64>) -> f64
+func.func @gradLoop(%arg0: f64, %arg1: tensor<f64>) -> f64 {
+    // CHECK:        [[empty:%.+]] = tensor.empty() : tensor<4xf64>
+    // CHECK:        [[fwd:%.+]]:2 = scf.for {{%.+}} = {{%.+}} to {{%.+}} step {{%.+}} iter_args({{%.+}} = %arg0, {{%.+}} = [[empty]]) -> (f64, tensor<4xf64>)
+    // CHECK:          call @loop.segment(
+    // CHECK:          tensor.insert
+    // CHECK:        [[epi:%.+]]:2 = gradient.backprop @loop.epilogue(%arg0, [[fwd]]#0) cotangents(%arg1 : tensor<f64>)
+    // CHECK:        [[rev:%.+]]:2 = scf.for {{%.+}} = {{%.+}} to {{%.+}} step {{%.+}} iter_args({{%.+}} = [[epi]]#1, {{%.+}} = [[epi]]#0) -> (f64, f64)
+    // CHECK:          tensor.extract [[fwd]]#1
+    // CHECK:          [[cotangent:%.+]] = tensor.from_elements
+    // CHECK:          gradient.backprop @loop.segment({{.+}}) cotangents([[cotangent]] : tensor<f64>)
+    // CHECK:        [[grad:%.+]] = arith.addf [[rev]]#1, [[rev]]#0 : f64
+    // CHECK:        return [[grad]]
+    %0 = gradient.backprop @loop(%arg0) cotangents(%arg1 : tensor<f64>) {checkpoints = 4 : i64} : (f64) -> f64
+    func.return %0 : f64
+}
+
+// -----
+
+// Check that a loop preceded by differentiable computations is not checkpointed
+func.func private @prologue(%arg0: f64) -> f64 {
+    %c0 = arith.constant 0 : index
+    %c10 = arith.constant 10 : index
+    %c1 = arith.constant 1 : index
+    %0 = arith.mulf %arg0, %arg0 : f64
+    %1 = scf.for %i = %c0 to %c10 step %c1 iter_args(%x = %0) -> (f64) {
+        %2 = arith.mulf %x, %x : f64
+        scf.yield %2 : f64
+    }
+    return %1 : f64
+}
+
+// CHECK-NOT: @prologue.segment
+// CHECK-LABEL: @gradPrologue(%arg0: f64, %arg1: tensor<f64>) -> f64
+func.func @gradPrologue(%arg0: f64, %arg1: tensor<f64>) -> f64 {
+    // CHECK:        gradient.backprop @prologue(%arg0) cotangents(%arg1 : tensor<f64>)
+    %0 = gradient.backprop @prologue(%arg0) cotangents(%arg1 : tensor<f64>) {checkpoints = 4 : i64} : (f64) -> f64
+    func.return %0 : f64
+}
@@ -45,3 +45,78 @@ func.func @adjoint(%arg0: f32, %arg1 : index) -> (memref<?xf64>, memref<?xf64>)
 
     return %alloc0, %alloc1 : memref<?xf64>, memref<?xf64>
 }
+
+// -----
+
+func.func private @circuit.withreg(%arg0: f32) -> (memref<f64>, !quantum.reg)
+
+// CHECK-LABEL: func.func @fused_adjoint(%arg0: f32, %arg1: index) {{.+}} {
+func.func @fused_adjoint(%arg0: f32, %arg1 : index) -> (memref<f64>, memref<?xf64>) {
+    // CHECK-DAG:   [[T:%.+]] = llvm.mlir.constant(true) : i1
+    // CHECK-DAG:   [[F:%.+]] = llvm.mlir.constant(false) : i1
+
+    // CHECK:       llvm.call @__quantum__rt__toggle_recorder([[T]]) : (i1) -> ()
+    // CHECK:       [[FWD:%.+]]:2 = call @circuit.withreg(%arg0)
+    // CHECK:       llvm.call @__quantum__rt__toggle_recorder([[F]])
+
+    // CHECK:       llvm.call @__quantum__qis__Gradient
+    // CHECK:       quantum.dealloc [[FWD]]#1
+    // CHECK:       return [[FWD]]#0, {{%.+}}
+    %alloc0 = memref.alloc(%arg1) : memref<?xf64>
+    %res = gradient.adjoint @circuit.withreg(%arg0) size(%arg1) in(%alloc0 : memref<?xf64>) : (f32) -> memref<f64>
+
+    return %res, %alloc0 : memref<f64>, memref<?xf64>
+}
+
+// -----
+
+//////////////////////////////
+// Fused Quantum Gradients  //
+//////////////////////////////
+
+func.func private @circuit.qgrad(%arg0: memref<f64>, %arg1: memref<?xf64>, %arg2: index) -> memref<?xf64>
+func.func private @circuit.fusedadjoint(%arg0: memref<f64>, %arg1: memref<?xf64>, %arg2: index) -> (memref<f64>, memref<?xf64>)
+
+// The reverse pass reads the quantum gradient from the tape, applies the chain rule and frees it
+// CHECK-LABEL: func.func private @circuit.quantum.customqgrad(
+// CHECK-SAME:      %arg6: !llvm.ptr)
+// CHECK:           [[tape:%.+]] = llvm.load %arg6 : !llvm.ptr -> !llvm.struct<(struct<(ptr, ptr, i64, array<1 x i64>, array<1 x i64>)>)>
+// CHECK:           llvm.extractvalue [[tape]][0]
+// CHECK-NOT:       call @circuit.fusedadjoint
+// CHECK-NOT:       call @circuit.qgrad
+// CHECK:           linalg.generic
+// CHECK:           llvm.call @free
+// CHECK:           llvm.call @free(%arg6)
+
+// The forward pass executes the circuit once, and passes its quantum gradient through the tape
+// CHECK-LABEL: func.func private @circuit.quantum.augfwd(
+// CHECK-SAME:      -> !llvm.ptr
+// CHECK:           [[fused:%.+]]:2 = call @circuit.fusedadjoint(
+// CHECK:           builtin.unrealized_conversion_cast [[fused]]#0
+// CHECK:           "llvm.intr.memcpy"
+// CHECK:           llvm.call @free
+// CHECK:           [[tapeEnd:%.+]] = llvm.getelementptr {{%.+}}[1] : (!llvm.ptr) -> !llvm.ptr, !llvm.struct<(struct<(ptr, ptr, i64, array<1 x i64>, array<1 x i64>)>)>
+// CHECK:           [[tapeSize:%.+]] = llvm.ptrtoint [[tapeEnd]]
+// CHECK:           [[tapePtr:%.+]] = llvm.call @malloc([[tapeSize]])
+// CHECK:           [[qgrad:%.+]] = builtin.unrealized_conversion_cast [[fused]]#1
+// CHECK:           [[tapeVal:%.+]] = llvm.insertvalue [[qgrad]], {{%.+}}[0]
+// CHECK:           llvm.store [[tapeVal]], [[tapePtr]]
+// CHECK:           return [[tapePtr]]
+func.func private @circuit.quantum(%arg0: memref<f64>, %arg1: memref<?xf64>) -> memref<f64> attributes {gradient.qgrad = @circuit.qgrad, gradient.fused_qgrad = @circuit.fusedadjoint} {
+    %alloc = memref.alloc() : memref<f64>
+    return %alloc : memref<f64>
+}
+
+func.func @circuit(%arg0: memref<f64>) -> memref<f64> {
+    %c1 = arith.constant 1 : index
+    %params = memref.alloc(%c1) : memref<?xf64>
+    %res = call @circuit.quantum(%arg0, %params) : (memref<f64>, memref<?xf64>) -> memref<f64>
+    return %res : memref<f64>
+}
+
+// CHECK-LABEL: func.func @backprop_fused(
+func.func @backprop_fused(%arg0: memref<f64>, %arg1: memref<f64>, %arg2: memref<f64>, %arg3: memref<f64>) -> memref<f64> {
+    // CHECK: llvm.call @__enzyme_autodiff
+    gradient.backprop @circuit(%arg0) grad_out(%arg1 : memref<f64>) callee_out(%arg2 : memref<f64>) cotangents(%arg3 : memref<f64>) {diffArgIndices=dense<0> : tensor<1xindex>} : (memref<f64>) -> ()
+    return %arg1 : memref<f64>
+}
@@ -0,0 +1,157 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// RUN: quantum-opt --select-backend --split-input-file %s | FileCheck %s
+// RUN: quantum-opt --select-backend="small-qubits=1" --split-input-file %s \
+// RUN:   | FileCheck %s --check-prefix=LARGE
+
+// CHECK-LABEL: @permutation
+// CHECK-SAME: quantum.circuit_class = "permutation"
+// LARGE-LABEL: @permutation
+func.func @permutation() attributes {qnode} {
+    %c0 = arith.constant 0 : i64
+    %c1 = arith.constant 1 : i64
+
+    // CHECK: quantum.device ["rtd_lightning.so", "LightningSimulator", "{shots: 0}"]
+    // LARGE: quantum.device [{{.*}}, "LightningKokkosSimulator|LightningSimulator", {{.*}}]
+    quantum.device ["rtd_lightning.so", "LightningSimulator", "{shots: 0}"]
+    %r = quantum.alloc( 2) : !quantum.reg
+    %q0 = quantum.extract %r[%c0] : !quantum.reg -> !quantum.bit
+    %q1 = quantum.extract %r[%c1] : !quantum.reg -> !quantum.bit
+    %0 = quantum.custom "PauliX"() %q0 : !quantum.bit
+    %1:2 = quantum.custom "CNOT"() %0, %q1 : !quantum.bit, !quantum.bit
+    quantum.dealloc %r : !quantum.reg
+    return
+}
+
+// -----
+
+// CHECK-LABEL: @clifford
+// CHECK-SAME: quantum.circuit_class = "clifford"
+// LARGE-LABEL: @clifford
+func.func @clifford() attributes {qnode} {
+    %c0 = arith.constant 0 : i64
+    %c2 = arith.constant 2 : i64
+
+    // CHECK: quantum.device [{{.*}}, "LightningSimulator|LightningKokkosSimulator", {{.*}}]
+    // LARGE: quantum.device [{{.*}}, "LightningKokkosSimulator|LightningSimulator", {{.*}}]
+    quantum.device ["rtd_lightning.so", "LightningKokkosSimulator", "{shots: 0}"]
+    %r = quantum.alloc( 3) : !quantum.reg
+    %q0 = quantum.extract %r[%c0] : !quantum.reg -> !quantum.bit
+    %q2 = quantum.extract %r[%c2] : !quantum.reg -> !quantum.bit
+    %0 = quantum.custom "Hadamard"() %q0 : !quantum.bit
+    %1:2 = quantum.custom "CZ"() %0, %q2 : !quantum.bit, !quantum.bit
+    quantum.dealloc %r : !quantum.reg
+    return
+}
+
+// -----
+
+// CHECK-LABEL: @nearest_neighbour
+// CHECK-SAME: quantum.circuit_class = "nearest_neighbour"
+func.func @nearest_neighbour(%x : f64) attributes {qnode} {
+    %c1 = arith.constant 1 : i64
+    %c2 = arith.constant 2 : i64
+
+    quantum.device ["rtd_lightning.so", "LightningSimulator", "{shots: 0}"]
+    %r = quantum.alloc( 3) : !quantum.reg
+    %q1 = quantum.extract %r[%c1] : !quantum.reg -> !quantum.bit
+    %q2 = quantum.extract %r[%c2] : !quantum.reg -> !quantum.bit
+    %0 = quantum.custom "RX"(%x) %q2 : !quantum.bit
+    %1:2 = quantum.custom "IsingZZ"(%x) %q1, %0 : !quantum.bit, !quantum.bit
+    quantum.dealloc %r : !quantum.reg
+    return
+}
+
+// -----
+
+// CHECK-LABEL: @general
+// CHECK-SAME: quantum.circuit_class = "general"
+func.func @general(%x : f64) attributes {qnode} {
+    %c0 = arith.constant 0 : i64
+    %c2 = arith.constant 2 : i64
+
+    quantum.device ["rtd_lightning.so", "LightningSimulator", "{shots: 0}"]
+    %r = quantum.alloc( 3) : !quantum.reg
+    %q0 = quantum.extract %r[%c0] : !quantum.reg -> !quantum.bit
+    %q2 = quantum.extract %r[%c2] : !quantum.reg -> !quantum.bit
+    %0 = quantum.custom "RX"(%x) %q0 : !quantum.bit
+    %1:2 = quantum.custom "CNOT"() %0, %q2 : !quantum.bit, !quantum.bit
+    quantum.dealloc %r : !quantum.reg
+    return
+}
+
+// -----
+
+// The device is kept for circuits of unknown width, and for other devices.
+
+// CHECK-LABEL: @dynamic_width
+// LARGE-LABEL: @dynamic_width
+func.func @dynamic_width(%n : i64) attributes {qnode} {
+    // CHECK: quantum.device ["rtd_lightning.so", "LightningKokkosSimulator", "{shots: 0}"]
+    // LARGE: quantum.device ["rtd_lightning.so", "LightningKokkosSimulator", "{shots: 0}"]
+    quantum.device ["rtd_lightning.so", "LightningKokkosSimulator", "{shots: 0}"]
+    %r = quantum.alloc(%n) : !quantum.reg
+    quantum.dealloc %r : !quantum.reg
+    return
+}
+
+// CHECK-LABEL: @other_device
+// LARGE-LABEL: @other_device
+func.func @other_device() attributes {qnode} {
+    // CHECK: quantum.device ["rtd_dummy.so", "DummyDevice", "{shots: 0}"]
+    // LARGE: quantum.device ["rtd_dummy.so", "DummyDevice", "{shots: 0}"]
+    quantum.device ["rtd_dummy.so", "DummyDevice", "{shots: 0}"]
+    %r = quantum.alloc( 2) : !quantum.reg
+    quantum.dealloc %r : !quantum.reg
+    return
+}
+
+// -----
+
+// Devices with backend-specific kwargs are kept, as the other backends would drop them.
+
+// CHECK-LABEL: @specific_kwargs
+// LARGE-LABEL: @specific_kwargs
+func.func @specific_kwargs() attributes {qnode} {
+    // CHECK: quantum.device ["rtd_lightning.so", "LightningSimulator", "{'shots': 100, 'mcmc': True, 'num_burnin': 10}"]
+    // LARGE: quantum.device ["rtd_lightning.so", "LightningSimulator", "{'shots': 100, 'mcmc': True, 'num_burnin': 10}"]
+    quantum.device ["rtd_lightning.so", "LightningSimulator", "{'shots': 100, 'mcmc': True, 'num_burnin': 10}"]
+    %r = quantum.alloc( 2) : !quantum.reg
+    quantum.dealloc %r : !quantum.reg
+    return
+}
+
+// CHECK-LABEL: @shot_batches
+// LARGE-LABEL: @shot_batches
+func.func @shot_batches() attributes {qnode} {
+    // CHECK: quantum.device ["rtd_lightning.so", "LightningSimulator", "{'shots': 100, 'shot_batches': 4}"]
+    // LARGE: quantum.device ["rtd_lightning.so", "LightningSimulator", "{'shots': 100, 'shot_batches': 4}"]
+    quantum.device ["rtd_lightning.so", "LightningSimulator", "{'shots': 100, 'shot_batches': 4}"]
+    %r = quantum.alloc( 2) : !quantum.reg
+    quantum.dealloc %r : !quantum.reg
+    return
+}
+
+// CHECK-LABEL: @shots_only
+// LARGE-LABEL: @shots_only
+func.func @shots_only() attributes {qnode} {
+    // CHECK: quantum.device ["rtd_lightning.so", "LightningSimulator", "{'shots': 100}"]
+    // LARGE: quantum.device [{{.*}}, "LightningKokkosSimulator|LightningSimulator", "{'shots': 100}"]
+    quantum.device ["rtd_lightning.so", "LightningSimulator", "{'shots': 100}"]
+    %r = quantum.alloc( 2) : !quantum.reg
+    quantum.dealloc %r : !quantum.reg
+    return
+}
@@ -0,0 +1,218 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// RUN: quantum-opt --cancel-commuting-gates --split-input-file %s | FileCheck %s
+
+// CHECK-LABEL: @hadamard_pair
+func.func @hadamard_pair(%q0 : !quantum.bit) -> !quantum.bit {
+    // CHECK-NOT: quantum.custom
+    // CHECK: return %arg0
+    %0 = quantum.custom "Hadamard"() %q0 : !quantum.bit
+    %1 = quantum.custom "Hadamard"() %0 : !quantum.bit
+    return %1 : !quantum.bit
+}
+
+// -----
+
+// CHECK-LABEL: @rz_through_control
+func.func @rz_through_control(%q0 : !quantum.bit, %q1 : !quantum.bit, %a : f64, %b : f64) -> (!quantum.bit, !quantum.bit) {
+    // CHECK: [[cnot:%.+]]:2 = quantum.custom "CNOT"() %arg0, %arg1
+    // CHECK: [[angle:%.+]] = arith.addf %arg2, %arg3
+    // CHECK: [[rz:%.+]] = quantum.custom "RZ"([[angle]]) [[cnot]]#0
+    // CHECK-NOT: quantum.custom
+    // CHECK: return [[rz]], [[cnot]]#1
+    %0 = quantum.custom "RZ"(%a) %q0 : !quantum.bit
+    %1:2 = quantum.custom "CNOT"() %0, %q1 : !quantum.bit, !quantum.bit
+    %2 = quantum.custom "RZ"(%b) %1#0 : !quantum.bit
+    return %2, %1#1 : !quantum.bit, !quantum.bit
+}
+
+// -----
+
+// CHECK-LABEL: @s_adjoint_through_cz
+func.func @s_adjoint_through_cz(%q0 : !quantum.bit, %q1 : !quantum.bit) -> (!quantum.bit, !quantum.bit) {
+    // CHECK: [[cz:%.+]]:2 = quantum.custom "CZ"() %arg0, %arg1
+    // CHECK-NOT: quantum.custom
+    // CHECK: return [[cz]]#0, [[cz]]#1
+    %0 = quantum.custom "S"() %q0 : !quantum.bit
+    %1:2 = quantum.custom "CZ"() %0, %q1 : !quantum.bit, !quantum.bit
+    %2 = quantum.custom "S"() %1#0 {adjoint} : !quantum.bit
+    return %2, %1#1 : !quantum.bit, !quantum.bit
+}
+
+// -----
+
+// CHECK-LABEL: @opposite_rotations
+func.func @opposite_rotations(%q0 : !quantum.bit, %q1 : !quantum.bit) -> (!quantum.bit, !quantum.bit) {
+    %a = arith.constant 0.5 : f64
+    %b = arith.constant -0.5 : f64
+
+    // CHECK-NOT: quantum.custom "IsingZZ"
+    // CHECK: return %arg0, %arg1
+    %0:2 = quantum.custom "IsingZZ"(%a) %q0, %q1 : !quantum.bit, !quantum.bit
+    %1:2 = quantum.custom "IsingZZ"(%b) %0#0, %0#1 : !quantum.bit, !quantum.bit
+    return %1#0, %1#1 : !quantum.bit, !quantum.bit
+}
+
+// -----
+
+// CHECK-LABEL: @non_commuting
+func.func @non_commuting(%q0 : !quantum.bit, %q1 : !quantum.bit) -> (!quantum.bit, !quantum.bit) {
+    // CHECK: quantum.custom "PauliX"
+    // CHECK: quantum.custom "CNOT"
+    // CHECK: quantum.custom "PauliX"
+    %0 = quantum.custom "PauliX"() %q0 : !quantum.bit
+    %1:2 = quantum.custom "CNOT"() %0, %q1 : !quantum.bit, !quantum.bit
+    %2 = quantum.custom "PauliX"() %1#0 : !quantum.bit
+    return %2, %1#1 : !quantum.bit, !quantum.bit
+}
+
+// -----
+
+// CHECK-LABEL: @loop_body
+func.func @loop_body(%q0 : !quantum.bit, %n : index) -> !quantum.bit {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+
+    // CHECK: scf.for
+    // CHECK-NOT: quantum.custom "T"
+    // CHECK: quantum.custom "RX"
+    %r = scf.for %i = %c0 to %n step %c1 iter_args(%q = %q0) -> !quantum.bit {
+        %x = arith.index_cast %i : index to i64
+        %a = arith.sitofp %x : i64 to f64
+        %0 = quantum.custom "T"() %q : !quantum.bit
+        %1 = quantum.custom "T"() %0 {adjoint} : !quantum.bit
+        %2 = quantum.custom "RX"(%a) %1 : !quantum.bit
+        scf.yield %2 : !quantum.bit
+    }
+    return %r : !quantum.bit
+}
+
+// -----
+
+// CHECK-LABEL: @loop_conjugation
+func.func @loop_conjugation(%q0 : !quantum.bit, %n : index, %a : f64) -> !quantum.bit {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+
+    // CHECK: [[h:%.+]] = quantum.custom "Hadamard"() %arg0
+    // CHECK: [[r:%.+]] = scf.for {{.*}} iter_args([[q:%.+]] = [[h]])
+    // CHECK-NEXT: [[rz:%.+]] = quantum.custom "RZ"(%arg2) [[q]]
+    // CHECK-NEXT: scf.yield [[rz]]
+    // CHECK: [[out:%.+]] = quantum.custom "Hadamard"() [[r]]
+    // CHECK: return [[out]]
+    %r = scf.for %i = %c0 to %n step %c1 iter_args(%q = %q0) -> !quantum.bit {
+        %0 = quantum.custom "Hadamard"() %q : !quantum.bit
+        %1 = quantum.custom "RZ"(%a) %0 : !quantum.bit
+        %2 = quantum.custom "Hadamard"() %1 : !quantum.bit
+        scf.yield %2 : !quantum.bit
+    }
+    return %r : !quantum.bit
+}
+
+// -----
+
+// CHECK-LABEL: @register_loop_conjugation
+func.func @register_loop_conjugation(%r0 : !quantum.reg, %n : index, %a : f64) -> !quantum.reg {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+
+    // CHECK: [[q0:%.+]] = quantum.extract %arg0[ 0]
+    // CHECK: [[q1:%.+]] = quantum.extract %arg0[ 1]
+    // CHECK: [[cnot:%.+]]:2 = quantum.custom "CNOT"() [[q0]], [[q1]]
+    // CHECK: [[i0:%.+]] = quantum.insert %arg0[ 0], [[cnot]]#0
+    // CHECK: [[i1:%.+]] = quantum.insert [[i0]][ 1], [[cnot]]#1
+    // CHECK: [[r:%.+]] = scf.for {{.*}} iter_args([[reg:%.+]] = [[i1]])
+    // CHECK-NEXT: [[b0:%.+]] = quantum.extract [[reg]][ 0]
+    // CHECK-NEXT: [[b1:%.+]] = quantum.extract [[reg]][ 1]
+    // CHECK-NEXT: [[rz:%.+]] = quantum.custom "RZ"(%arg2) [[b1]]
+    // CHECK-NEXT: [[y0:%.+]] = quantum.insert [[reg]][ 0], [[b0]]
+    // CHECK-NEXT: [[y1:%.+]] = quantum.insert [[y0]][ 1], [[rz]]
+    // CHECK-NEXT: scf.yield [[y1]]
+    // CHECK: [[o0:%.+]] = quantum.extract [[r]][ 0]
+    // CHECK: [[o1:%.+]] = quantum.extract [[r]][ 1]
+    // CHECK: [[out:%.+]]:2 = quantum.custom "CNOT"() [[o0]], [[o1]]
+    // CHECK: [[f0:%.+]] = quantum.insert [[r]][ 0], [[out]]#0
+    // CHECK: [[f1:%.+]] = quantum.insert [[f0]][ 1], [[out]]#1
+    // CHECK: return [[f1]]
+    %r = scf.for %i = %c0 to %n step %c1 iter_args(%reg = %r0) -> !quantum.reg {
+        %0 = quantum.extract %reg[ 0] : !quantum.reg -> !quantum.bit
+        %1 = quantum.extract %reg[ 1] : !quantum.reg -> !quantum.bit
+        %2:2 = quantum.custom "CNOT"() %0, %1 : !quantum.bit, !quantum.bit
+        %3 = quantum.custom "RZ"(%a) %2#1 : !quantum.bit
+        %4:2 = quantum.custom "CNOT"() %2#0, %3 : !quantum.bit, !quantum.bit
+        %5 = quantum.insert %reg[ 0], %4#0 : !quantum.reg, !quantum.bit
+        %6 = quantum.insert %5[ 1], %4#1 : !quantum.reg, !quantum.bit
+        scf.yield %6 : !quantum.reg
+    }
+    return %r : !quantum.reg
+}
+
+// -----
+
+// CHECK-LABEL: @register_loop_read_after_insert
+func.func @register_loop_read_after_insert(%r0 : !quantum.reg, %n : index) -> !quantum.reg {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+
+    // The wire is updated again after the second Hadamard gate is inserted.
+    // CHECK: scf.for
+    // CHECK: quantum.custom "Hadamard"
+    // CHECK: quantum.custom "Hadamard"
+    %r = scf.for %i = %c0 to %n step %c1 iter_args(%reg = %r0) -> !quantum.reg {
+        %0 = quantum.extract %reg[ 0] : !quantum.reg -> !quantum.bit
+        %1 = quantum.custom "Hadamard"() %0 : !quantum.bit
+        %2 = quantum.custom "PauliY"() %1 : !quantum.bit
+        %3 = quantum.custom "Hadamard"() %2 : !quantum.bit
+        %4 = quantum.insert %reg[ 0], %3 : !quantum.reg, !quantum.bit
+        %5 = quantum.extract %4[ 0] : !quantum.reg -> !quantum.bit
+        %6 = quantum.custom "PauliX"() %5 : !quantum.bit
+        %7 = quantum.insert %4[ 0], %6 : !quantum.reg, !quantum.bit
+        scf.yield %7 : !quantum.reg
+    }
+    return %r : !quantum.reg
+}
+
+// -----
+
+// The functions derived from a qnode by the gradient lowering are left as they are together with
+// the qnode, other functions are simplified.
+
+// CHECK-LABEL: @circuit(
+func.func @circuit(%q0 : !quantum.bit, %a : f64, %b : f64) -> !quantum.bit attributes {qnode, diff_method = "adjoint"} {
+    // CHECK: quantum.custom "RX"(%arg1)
+    // CHECK: quantum.custom "RX"(%arg2)
+    %0 = quantum.custom "RX"(%a) %q0 : !quantum.bit
+    %1 = quantum.custom "RX"(%b) %0 : !quantum.bit
+    return %1 : !quantum.bit
+}
+
+// CHECK-LABEL: @circuit.nodealloc
+func.func @circuit.nodealloc(%q0 : !quantum.bit, %a : f64, %b : f64) -> !quantum.bit {
+    // CHECK: quantum.custom "RX"(%arg1)
+    // CHECK: quantum.custom "RX"(%arg2)
+    %0 = quantum.custom "RX"(%a) %q0 : !quantum.bit
+    %1 = quantum.custom "RX"(%b) %0 : !quantum.bit
+    return %1 : !quantum.bit
+}
+
+// CHECK-LABEL: @other_circuit
+func.func @other_circuit(%q0 : !quantum.bit, %a : f64, %b : f64) -> !quantum.bit attributes {qnode, diff_method = "adjoint"} {
+    // CHECK: [[angle:%.+]] = arith.addf %arg1, %arg2
+    // CHECK: quantum.custom "RX"([[angle]])
+    // CHECK-NOT: quantum.custom
+    %0 = quantum.custom "RX"(%a) %q0 : !quantum.bit
+    %1 = quantum.custom "RX"(%b) %0 : !quantum.bit
+    return %1 : !quantum.bit
+}
@@ -83,6 +83,62 @@ func.func @device() {
 
 // -----
 
+// CHECK: llvm.func @__quantum__rt__device_prefetch(!llvm.ptr<i8>, !llvm.ptr<i8>, !llvm.ptr<i8>)
+
+// CHECK-LABEL: @device_prefetch
+func.func @device_prefetch() {
+    // CHECK: [[lib:%.+]] = llvm.getelementptr {{.*}} -> !llvm.ptr<i8>
+    // CHECK: [[name:%.+]] = llvm.getelementptr {{.*}} -> !llvm.ptr<i8>
+    // CHECK: [[kwargs:%.+]] = llvm.getelementptr {{.*}} -> !llvm.ptr<i8>
+    // CHECK: llvm.call @__quantum__rt__device_prefetch([[lib]], [[name]], [[kwargs]])
+    quantum.device_prefetch ["rtd_lightning.so", "lightning.qubit", "{shots: 0}"]
+
+    return
+}
+
+// -----
+
+// CHECK: llvm.func @__quantum__rt__toggle_template(i64, i1)
+
+// CHECK-LABEL: @toggle_template
+func.func @toggle_template() {
+    // CHECK: [[id:%.+]] = llvm.mlir.constant(42 : i64) : i64
+    // CHECK: [[on:%.+]] = llvm.mlir.constant(true) : i1
+    // CHECK: llvm.call @__quantum__rt__toggle_template([[id]], [[on]])
+    quantum.toggle_template 42, true
+    // CHECK: [[off:%.+]] = llvm.mlir.constant(false) : i1
+    // CHECK: llvm.call @__quantum__rt__toggle_template({{%.+}}, [[off]])
+    quantum.toggle_template 42, false
+
+    return
+}
+
+// -----
+
+// CHECK: llvm.func @__quantum__rt__replay(i64, !llvm.ptr<struct<(ptr<f64>, ptr<f64>, i64, array<1 x i64>, array<1 x i64>)>>) -> i1
+
+// CHECK-LABEL: @replay
+func.func @replay(%a : f64, %b : f64) -> (i1, i1) {
+    // CHECK: [[null:%.+]] = llvm.mlir.null
+    // CHECK: llvm.call @__quantum__rt__replay({{%.+}}, [[null]])
+    %0 = quantum.replay 7()
+
+    // CHECK: [[buffer:%.+]] = llvm.alloca {{%.+}} x f64
+    // CHECK: [[ptr0:%.+]] = llvm.getelementptr [[buffer]]
+    // CHECK: llvm.store %arg0, [[ptr0]]
+    // CHECK: [[ptr1:%.+]] = llvm.getelementptr [[buffer]]
+    // CHECK: llvm.store %arg1, [[ptr1]]
+    // CHECK: [[desc:%.+]] = llvm.insertvalue {{.*}}[4, 0]
+    // CHECK: [[descPtr:%.+]] = llvm.alloca
+    // CHECK: llvm.store [[desc]], [[descPtr]]
+    // CHECK: [[res:%.+]] = llvm.call @__quantum__rt__replay({{%.+}}, [[descPtr]])
+    %1 = quantum.replay 7(%a, %b)
+
+    return %0, %1 : i1, i1
+}
+
+// -----
+
 ///////////////////////
 // Memory Management //
 ///////////////////////
@@ -228,6 +284,32 @@ func.func @multirz(%q0 : !quantum.bit, %p : f64) -> (!quantum.bit, !quantum.bit,
 
 // -----
 
+// CHECK: llvm.func @__quantum__qis__QFT(i1, i64, ...)
+// CHECK: llvm.func @__quantum__qis__ReflectUniform(i1, i64, ...)
+
+// CHECK-LABEL: @structured_gates
+func.func @structured_gates(%q0 : !quantum.bit, %q1 : !quantum.bit) -> (!quantum.bit, !quantum.bit) {
+
+    // CHECK: [[c2:%.+]] = llvm.mlir.constant(2 : i64)
+    // CHECK: [[a:%.+]] = llvm.mlir.constant(false) : i1
+    // CHECK: llvm.call @__quantum__qis__QFT([[a]], [[c2]], %arg0, %arg1)
+    %q2:2 = quantum.qft %q0, %q1 : !quantum.bit, !quantum.bit
+
+    // CHECK: [[c2:%.+]] = llvm.mlir.constant(2 : i64)
+    // CHECK: [[a:%.+]] = llvm.mlir.constant(true) : i1
+    // CHECK: llvm.call @__quantum__qis__QFT([[a]], [[c2]], %arg0, %arg1)
+    %q3:2 = quantum.qft %q2#0, %q2#1 {adjoint} : !quantum.bit, !quantum.bit
+
+    // CHECK: [[c2:%.+]] = llvm.mlir.constant(2 : i64)
+    // CHECK: [[a:%.+]] = llvm.mlir.constant(false) : i1
+    // CHECK: llvm.call @__quantum__qis__ReflectUniform([[a]], [[c2]], %arg0, %arg1)
+    %q4:2 = quantum.reflect_uniform %q3#0, %q3#1 : !quantum.bit, !quantum.bit
+
+    return %q4#0, %q4#1 : !quantum.bit, !quantum.bit
+}
+
+// -----
+
 // CHECK: llvm.func @__quantum__qis__QubitUnitary(!llvm.ptr<struct<(ptr, ptr, i64, array<2 x i64>, array<2 x i64>)>>, i1, i64, ...)
 
 // CHECK-LABEL: @qubit_unitary
@@ -0,0 +1,72 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// RUN: quantum-opt --prefetch-devices --split-input-file %s | FileCheck %s
+
+// CHECK-LABEL: @circuit0
+func.func @circuit0() attributes {qnode} {
+    quantum.device ["rtd_lightning.so", "LightningSimulator", "{shots: 0}"]
+    quantum.device_release
+    return
+}
+
+// CHECK-LABEL: @circuit1
+func.func @circuit1() attributes {qnode} {
+    quantum.device ["rtd_lightning.so", "LightningSimulator", "{shots: 0}"]
+    quantum.device_release
+    quantum.device ["rtd_openqasm.so", "OpenQasmDevice", "{shots: 100}"]
+    quantum.device_release
+    return
+}
+
+// Each distinct device is prefetched once, in order of appearance
+// CHECK-LABEL: @setup
+func.func @setup() {
+    // CHECK:      quantum.init
+    // CHECK-NEXT: quantum.device_prefetch ["rtd_lightning.so", "LightningSimulator", "{shots: 0}"]
+    // CHECK-NEXT: quantum.device_prefetch ["rtd_openqasm.so", "OpenQasmDevice", "{shots: 100}"]
+    // CHECK-NEXT: return
+    quantum.init
+    return
+}
+
+// -----
+
+// Devices already prefetched are not prefetched again
+// CHECK-LABEL: @circuit
+func.func @circuit() attributes {qnode} {
+    quantum.device ["rtd_lightning.so", "LightningSimulator", "{shots: 0}"]
+    quantum.device_release
+    return
+}
+
+// CHECK-LABEL: @setup
+func.func @setup() {
+    // CHECK:      quantum.init
+    // CHECK-NEXT: quantum.device_prefetch ["rtd_lightning.so", "LightningSimulator", "{shots: 0}"]
+    // CHECK-NEXT: return
+    quantum.init
+    quantum.device_prefetch ["rtd_lightning.so", "LightningSimulator", "{shots: 0}"]
+    return
+}
+
+// -----
+
+// CHECK-LABEL: @setup
+func.func @setup() {
+    // CHECK:      quantum.init
+    // CHECK-NOT:  quantum.device_prefetch
+    quantum.init
+    return
+}
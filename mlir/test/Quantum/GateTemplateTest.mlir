@@ -0,0 +1,158 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// RUN: quantum-opt --record-gate-templates="min-gates=2" --split-input-file %s | FileCheck %s
+
+// CHECK-LABEL: @circuit
+func.func @circuit(%arg0 : f64) -> f64 attributes {qnode} {
+    // CHECK: [[reg:%.+]] = quantum.alloc
+    %r = quantum.alloc( 2) : !quantum.reg
+    // CHECK: [[q0:%.+]] = quantum.extract [[reg]][ 0]
+    %q0 = quantum.extract %r[ 0] : !quantum.reg -> !quantum.bit
+
+    // The parameters are computed before the replay
+    // CHECK: [[theta:%.+]] = arith.mulf %arg0, %arg0
+    // CHECK: [[replayed:%.+]] = quantum.replay [[id:[-0-9]+]](%arg0, [[theta]], %arg0)
+    // CHECK: [[res:%.+]]:2 = scf.if [[replayed]]
+    // CHECK-NOT: quantum.custom
+    // CHECK-NOT: quantum.multirz
+    // CHECK: [[q1:%.+]] = quantum.extract [[reg]][ 1]
+    // CHECK: scf.yield [[q0]], [[q1]]
+    // CHECK: else
+    // CHECK: quantum.toggle_template [[id]], true
+    // CHECK: quantum.custom "RX"(%arg0)
+    // CHECK: quantum.extract [[reg]][ 1]
+    // CHECK: quantum.custom "CNOT"()
+    // CHECK: quantum.multirz([[theta]])
+    // CHECK: quantum.custom "RY"(%arg0) {{.*}} {adjoint}
+    // CHECK: quantum.toggle_template [[id]], false
+    // CHECK: scf.yield
+    %q2 = quantum.custom "RX"(%arg0) %q0 : !quantum.bit
+    %q1 = quantum.extract %r[ 1] : !quantum.reg -> !quantum.bit
+    %q3:2 = quantum.custom "CNOT"() %q2, %q1 : !quantum.bit, !quantum.bit
+    %theta = arith.mulf %arg0, %arg0 : f64
+    %q4:2 = quantum.multirz(%theta) %q3#0, %q3#1 : !quantum.bit, !quantum.bit
+    %q5 = quantum.custom "RY"(%arg0) %q4#1 {adjoint} : !quantum.bit
+
+    // CHECK: quantum.namedobs [[res]]#0[{{ *}}PauliZ]
+    %obs = quantum.namedobs %q4#0[PauliZ] : !quantum.obs
+    %expval = quantum.expval %obs : f64
+    // CHECK: quantum.insert [[reg]][ 1], [[res]]#1
+    %r1 = quantum.insert %r[ 1], %q5 : !quantum.reg, !quantum.bit
+    quantum.dealloc %r1 : !quantum.reg
+    return %expval : f64
+}
+
+// -----
+
+// The template is identified by the structure of the gates, not by their parameters
+
+// CHECK-LABEL: @first
+func.func @first(%arg0 : f64) attributes {qnode} {
+    %r = quantum.alloc( 2) : !quantum.reg
+    %q0 = quantum.extract %r[ 0] : !quantum.reg -> !quantum.bit
+    %q1 = quantum.extract %r[ 1] : !quantum.reg -> !quantum.bit
+    // CHECK: quantum.replay [[id:[-0-9]+]](%arg0)
+    %q2 = quantum.custom "RX"(%arg0) %q0 : !quantum.bit
+    %q3:2 = quantum.custom "CNOT"() %q2, %q1 : !quantum.bit, !quantum.bit
+    %r1 = quantum.insert %r[ 0], %q3#0 : !quantum.reg, !quantum.bit
+    %r2 = quantum.insert %r1[ 1], %q3#1 : !quantum.reg, !quantum.bit
+    quantum.dealloc %r2 : !quantum.reg
+    return
+}
+
+// CHECK-LABEL: @second
+func.func @second(%arg0 : f64) attributes {qnode} {
+    %r = quantum.alloc( 2) : !quantum.reg
+    %q0 = quantum.extract %r[ 0] : !quantum.reg -> !quantum.bit
+    %q1 = quantum.extract %r[ 1] : !quantum.reg -> !quantum.bit
+    %cst = arith.constant 0.5 : f64
+    // CHECK: quantum.replay [[id]]({{%.+}})
+    %q2 = quantum.custom "RX"(%cst) %q0 : !quantum.bit
+    %q3:2 = quantum.custom "CNOT"() %q2, %q1 : !quantum.bit, !quantum.bit
+    %r1 = quantum.insert %r[ 0], %q3#0 : !quantum.reg, !quantum.bit
+    %r2 = quantum.insert %r1[ 1], %q3#1 : !quantum.reg, !quantum.bit
+    quantum.dealloc %r2 : !quantum.reg
+    return
+}
+
+// CHECK-LABEL: @other_wires
+func.func @other_wires(%arg0 : f64) attributes {qnode} {
+    %r = quantum.alloc( 2) : !quantum.reg
+    %q0 = quantum.extract %r[ 0] : !quantum.reg -> !quantum.bit
+    %q1 = quantum.extract %r[ 1] : !quantum.reg -> !quantum.bit
+    // CHECK-NOT: quantum.replay [[id]](
+    %q2 = quantum.custom "RX"(%arg0) %q1 : !quantum.bit
+    %q3:2 = quantum.custom "CNOT"() %q2, %q0 : !quantum.bit, !quantum.bit
+    %r1 = quantum.insert %r[ 1], %q3#0 : !quantum.reg, !quantum.bit
+    %r2 = quantum.insert %r1[ 0], %q3#1 : !quantum.reg, !quantum.bit
+    quantum.dealloc %r2 : !quantum.reg
+    return
+}
+
+// -----
+
+// CHECK-LABEL: @measurement
+func.func @measurement(%arg0 : f64) attributes {qnode} {
+    %r = quantum.alloc( 2) : !quantum.reg
+    %q0 = quantum.extract %r[ 0] : !quantum.reg -> !quantum.bit
+    %q1 = quantum.extract %r[ 1] : !quantum.reg -> !quantum.bit
+
+    // Mid-circuit measurements end the sequence, the longest of which is recorded
+    // CHECK: quantum.custom "Hadamard"
+    // CHECK: quantum.measure
+    // CHECK: quantum.replay {{[-0-9]+}}(%arg0, %arg0)
+    // CHECK: else
+    // CHECK: quantum.custom "RX"
+    // CHECK: quantum.custom "CNOT"
+    // CHECK: quantum.custom "RZ"
+    %q2 = quantum.custom "Hadamard"() %q0 : !quantum.bit
+    %m, %q3 = quantum.measure %q2 : i1, !quantum.bit
+    %q4 = quantum.custom "RX"(%arg0) %q3 : !quantum.bit
+    %q5:2 = quantum.custom "CNOT"() %q4, %q1 : !quantum.bit, !quantum.bit
+    %q6 = quantum.custom "RZ"(%arg0) %q5#1 : !quantum.bit
+    %r1 = quantum.insert %r[ 0], %q5#0 : !quantum.reg, !quantum.bit
+    %r2 = quantum.insert %r1[ 1], %q6 : !quantum.reg, !quantum.bit
+    quantum.dealloc %r2 : !quantum.reg
+    return
+}
+
+// -----
+
+// CHECK-LABEL: @dynamic_wire
+func.func @dynamic_wire(%arg0 : f64, %idx : i64) attributes {qnode} {
+    // CHECK-NOT: quantum.replay
+    %r = quantum.alloc( 2) : !quantum.reg
+    %q0 = quantum.extract %r[%idx] : !quantum.reg -> !quantum.bit
+    %q1 = quantum.custom "RX"(%arg0) %q0 : !quantum.bit
+    %q2 = quantum.custom "RY"(%arg0) %q1 : !quantum.bit
+    %q3 = quantum.custom "RZ"(%arg0) %q2 : !quantum.bit
+    %r1 = quantum.insert %r[%idx], %q3 : !quantum.reg, !quantum.bit
+    quantum.dealloc %r1 : !quantum.reg
+    return
+}
+
+// -----
+
+// CHECK-LABEL: @not_a_qnode
+func.func @not_a_qnode(%arg0 : f64) {
+    // CHECK-NOT: quantum.replay
+    %r = quantum.alloc( 1) : !quantum.reg
+    %q0 = quantum.extract %r[ 0] : !quantum.reg -> !quantum.bit
+    %q1 = quantum.custom "RX"(%arg0) %q0 : !quantum.bit
+    %q2 = quantum.custom "RY"(%arg0) %q1 : !quantum.bit
+    %r1 = quantum.insert %r[ 0], %q2 : !quantum.reg, !quantum.bit
+    quantum.dealloc %r1 : !quantum.reg
+    return
+}
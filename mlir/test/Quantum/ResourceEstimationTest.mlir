@@ -0,0 +1,89 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// RUN: quantum-opt --estimate-resources --split-input-file %s | FileCheck %s
+
+// CHECK-LABEL: @circuit
+// CHECK-SAME: quantum.resources = {circuit_evaluations = 1 : i64, gate_params = 4 : i64
+// CHECK-SAME: gate_widths = {"1" = 5 : i64, "2" = 1 : i64}
+// CHECK-SAME: gates = {CNOT = 1 : i64, Hadamard = 1 : i64, RX = 1 : i64, RZ = 3 : i64}
+// CHECK-SAME: measurements = 1 : i64, num_gates = 6 : i64, num_qubits = 2 : i64, sweeps = 7 : i64}
+func.func @circuit(%x : f64) -> f64 attributes {qnode, diff_method = "parameter-shift"} {
+    %c0 = arith.constant 0 : i64
+    %c1 = arith.constant 1 : i64
+    %lb = arith.constant 0 : index
+    %ub = arith.constant 3 : index
+    %step = arith.constant 1 : index
+
+    %r = quantum.alloc( 2) : !quantum.reg
+    %q0 = quantum.extract %r[%c0] : !quantum.reg -> !quantum.bit
+    %q1 = quantum.extract %r[%c1] : !quantum.reg -> !quantum.bit
+    %0 = quantum.custom "Hadamard"() %q0 : !quantum.bit
+    %1:2 = quantum.custom "CNOT"() %0, %q1 : !quantum.bit, !quantum.bit
+    %2 = quantum.custom "RX"(%x) %1#0 : !quantum.bit
+    %3 = scf.for %i = %lb to %ub step %step iter_args(%q = %2) -> !quantum.bit {
+        %4 = quantum.custom "RZ"(%x) %q : !quantum.bit
+        scf.yield %4 : !quantum.bit
+    }
+    %obs = quantum.namedobs %3[PauliZ] : !quantum.obs
+    %res = quantum.expval %obs : f64
+    return %res : f64
+}
+
+// Two shifted evaluations per gate parameter, and the primal evaluation.
+// CHECK-LABEL: @grad_ps
+// CHECK-SAME: circuit_evaluations = 9 : i64
+// CHECK-SAME: num_gates = 54 : i64, num_qubits = 2 : i64
+func.func @grad_ps(%x : f64) -> f64 {
+    %0 = gradient.grad "auto" @circuit(%x) : (f64) -> f64
+    return %0 : f64
+}
+
+// One shifted evaluation per differentiable scalar, and the primal evaluation.
+// CHECK-LABEL: @grad_fd
+// CHECK-SAME: circuit_evaluations = 2 : i64
+// CHECK-SAME: num_gates = 12 : i64
+func.func @grad_fd(%x : f64) -> f64 {
+    %0 = gradient.grad "fd" @circuit(%x) : (f64) -> f64
+    return %0 : f64
+}
+
+// -----
+
+// CHECK-LABEL: @dynamic_loops
+// CHECK-SAME: gates = {Hadamard = "n0", RZ = "n0*n1"}
+// CHECK-SAME: num_gates = "n0 + n0*n1"
+func.func @dynamic_loops(%q0 : !quantum.bit, %n : index, %m : index, %x : f64) -> !quantum.bit {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+
+    %0 = scf.for %i = %c0 to %n step %c1 iter_args(%q = %q0) -> !quantum.bit {
+        %1 = quantum.custom "Hadamard"() %q : !quantum.bit
+        %2 = scf.for %j = %c0 to %m step %c1 iter_args(%qq = %1) -> !quantum.bit {
+            %3 = quantum.custom "RZ"(%x) %qq : !quantum.bit
+            scf.yield %3 : !quantum.bit
+        }
+        scf.yield %2 : !quantum.bit
+    }
+    return %0 : !quantum.bit
+}
+
+// -----
+
+// CHECK-LABEL: @classical
+// CHECK-NOT: quantum.resources
+func.func @classical(%x : f64) -> f64 {
+    %0 = arith.mulf %x, %x : f64
+    return %0 : f64
+}
@@ -0,0 +1,114 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// RUN: quantum-opt --split-shots="num-batches=3" --split-input-file %s | FileCheck %s
+
+// CHECK-LABEL: func.func @dynamic_circuit(
+// CHECK-SAME: -> (tensor<10x1xf64>, tensor<2xf64>, tensor<2xi64>) attributes {qnode}
+func.func @dynamic_circuit(%x : f64) -> (tensor<10x1xf64>, tensor<2xf64>, tensor<2xi64>)
+        attributes {qnode} {
+    %c0 = arith.constant 0 : i64
+
+    // CHECK: quantum.device ["rtd_lightning.so", "LightningSimulator", "{shots: 10}"]
+    quantum.device ["rtd_lightning.so", "LightningSimulator", "{shots: 10}"]
+    %r = quantum.alloc( 1) : !quantum.reg
+    %q0 = quantum.extract %r[%c0] : !quantum.reg -> !quantum.bit
+    %0 = quantum.custom "RX"(%x) %q0 : !quantum.bit
+    %m, %1 = quantum.measure %0 : i1, !quantum.bit
+    %obs = quantum.compbasis %1 : !quantum.obs
+    // CHECK: quantum.sample {{.*}} {shots = 10 : i64} : tensor<10x1xf64>
+    %samples = quantum.sample %obs {shots = 10 : i64} : tensor<10x1xf64>
+    %eigvals, %counts = quantum.counts %obs {shots = 10 : i64} : tensor<2xf64>, tensor<2xi64>
+    quantum.dealloc %r : !quantum.reg
+    return %samples, %eigvals, %counts : tensor<10x1xf64>, tensor<2xf64>, tensor<2xi64>
+}
+
+// CHECK-LABEL: func.func @dynamic_circuit.shots.3(
+// CHECK-SAME: -> (tensor<3x1xf64>, tensor<2xf64>, tensor<2xi64>)
+// CHECK-SAME: batch_shots = 3 : i64, qnode, shot_batch_of = @dynamic_circuit
+// CHECK: quantum.device [{{.*}}, "LightningSimulator", "{shots: 10, 'shot_batches': 3}"]
+// CHECK: quantum.sample {{.*}} {shots = 3 : i64} : tensor<3x1xf64>
+// CHECK: quantum.counts {{.*}} {shots = 3 : i64} : tensor<2xf64>, tensor<2xi64>
+
+// CHECK-LABEL: func.func @dynamic_circuit.shots.4(
+// CHECK-SAME: -> (tensor<4x1xf64>, tensor<2xf64>, tensor<2xi64>)
+// CHECK: quantum.sample {{.*}} {shots = 4 : i64} : tensor<4x1xf64>
+
+// CHECK-LABEL: @workflow
+func.func @workflow(%x : f64) -> (tensor<10x1xf64>, tensor<2xf64>, tensor<2xi64>) {
+    // CHECK: [[b0:%.+]]:3 = call @dynamic_circuit.shots.4(%arg0)
+    // CHECK: [[b1:%.+]]:3 = call @dynamic_circuit.shots.3(%arg0)
+    // CHECK: [[b2:%.+]]:3 = call @dynamic_circuit.shots.3(%arg0)
+    // CHECK: [[empty:%.+]] = tensor.empty() : tensor<10x1xf64>
+    // CHECK: [[s0:%.+]] = tensor.insert_slice [[b0]]#0 into [[empty]][0, 0] [4, 1] [1, 1]
+    // CHECK: [[s1:%.+]] = tensor.insert_slice [[b1]]#0 into [[s0]][4, 0] [3, 1] [1, 1]
+    // CHECK: [[s2:%.+]] = tensor.insert_slice [[b2]]#0 into [[s1]][7, 0] [3, 1] [1, 1]
+    // CHECK: [[c0:%.+]] = arith.addi [[b0]]#2, [[b1]]#2 : tensor<2xi64>
+    // CHECK: [[c1:%.+]] = arith.addi [[c0]], [[b2]]#2 : tensor<2xi64>
+    // CHECK: return [[s2]], [[b0]]#1, [[c1]]
+    %0:3 = call @dynamic_circuit(%x) : (f64) -> (tensor<10x1xf64>, tensor<2xf64>, tensor<2xi64>)
+    return %0#0, %0#1, %0#2 : tensor<10x1xf64>, tensor<2xf64>, tensor<2xi64>
+}
+
+// -----
+
+// Circuits without mid-circuit measurements draw all shots from a single execution.
+
+// CHECK-LABEL: @static_circuit
+func.func @static_circuit() -> tensor<10x1xf64> attributes {qnode} {
+    %c0 = arith.constant 0 : i64
+
+    quantum.device ["rtd_lightning.so", "LightningSimulator", "{shots: 10}"]
+    %r = quantum.alloc( 1) : !quantum.reg
+    %q0 = quantum.extract %r[%c0] : !quantum.reg -> !quantum.bit
+    %0 = quantum.custom "Hadamard"() %q0 : !quantum.bit
+    %obs = quantum.compbasis %0 : !quantum.obs
+    %samples = quantum.sample %obs {shots = 10 : i64} : tensor<10x1xf64>
+    quantum.dealloc %r : !quantum.reg
+    return %samples : tensor<10x1xf64>
+}
+
+// CHECK-LABEL: @static_workflow
+func.func @static_workflow() -> tensor<10x1xf64> {
+    // CHECK: call @static_circuit()
+    // CHECK-NOT: tensor.insert_slice
+    %0 = call @static_circuit() : () -> tensor<10x1xf64>
+    return %0 : tensor<10x1xf64>
+}
+
+// -----
+
+// Expectation values of dynamic circuits can't be merged across batches.
+
+// CHECK-LABEL: @expval_circuit
+func.func @expval_circuit() -> f64 attributes {qnode} {
+    %c0 = arith.constant 0 : i64
+
+    quantum.device ["rtd_lightning.so", "LightningSimulator", "{shots: 10}"]
+    %r = quantum.alloc( 1) : !quantum.reg
+    %q0 = quantum.extract %r[%c0] : !quantum.reg -> !quantum.bit
+    %m, %0 = quantum.measure %q0 : i1, !quantum.bit
+    %obs = quantum.namedobs %0[PauliZ] : !quantum.obs
+    %expval = quantum.expval %obs {shots = 10 : i64} : f64
+    quantum.dealloc %r : !quantum.reg
+    return %expval : f64
+}
+
+// CHECK-LABEL: @expval_workflow
+func.func @expval_workflow() -> f64 {
+    // CHECK: call @expval_circuit()
+    %0 = call @expval_circuit() : () -> f64
+    return %0 : f64
+}
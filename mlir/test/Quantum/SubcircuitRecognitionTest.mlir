@@ -0,0 +1,114 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// RUN: quantum-opt --recognize-subcircuits --split-input-file %s | FileCheck %s
+
+// CHECK-LABEL: @qft3
+func.func @qft3(%q0 : !quantum.bit, %q1 : !quantum.bit, %q2 : !quantum.bit) -> (!quantum.bit, !quantum.bit, !quantum.bit) {
+    %pi2 = arith.constant 1.5707963267948966 : f64
+    %pi4 = arith.constant 0.78539816339744828 : f64
+
+    // CHECK-NOT: quantum.custom
+    // CHECK: [[out:%.+]]:3 = quantum.qft %arg0, %arg1, %arg2 : !quantum.bit, !quantum.bit, !quantum.bit
+    // CHECK-NOT: quantum.custom
+    %0 = quantum.custom "Hadamard"() %q0 : !quantum.bit
+    %1:2 = quantum.custom "ControlledPhaseShift"(%pi2) %q1, %0 : !quantum.bit, !quantum.bit
+    %2:2 = quantum.custom "ControlledPhaseShift"(%pi4) %q2, %1#1 : !quantum.bit, !quantum.bit
+    %3 = quantum.custom "Hadamard"() %1#0 : !quantum.bit
+    %4:2 = quantum.custom "ControlledPhaseShift"(%pi2) %2#0, %3 : !quantum.bit, !quantum.bit
+    %5 = quantum.custom "Hadamard"() %4#0 : !quantum.bit
+    %6:2 = quantum.custom "SWAP"() %2#1, %5 : !quantum.bit, !quantum.bit
+
+    // CHECK: return [[out]]#0, [[out]]#1, [[out]]#2
+    return %6#0, %4#1, %6#1 : !quantum.bit, !quantum.bit, !quantum.bit
+}
+
+// -----
+
+// CHECK-LABEL: @qft_wrong_angle
+func.func @qft_wrong_angle(%q0 : !quantum.bit, %q1 : !quantum.bit) -> (!quantum.bit, !quantum.bit) {
+    %pi4 = arith.constant 0.78539816339744828 : f64
+
+    // CHECK-NOT: quantum.qft
+    %0 = quantum.custom "Hadamard"() %q0 : !quantum.bit
+    %1:2 = quantum.custom "ControlledPhaseShift"(%pi4) %q1, %0 : !quantum.bit, !quantum.bit
+    %2 = quantum.custom "Hadamard"() %1#0 : !quantum.bit
+    %3:2 = quantum.custom "SWAP"() %1#1, %2 : !quantum.bit, !quantum.bit
+
+    return %3#0, %3#1 : !quantum.bit, !quantum.bit
+}
+
+// -----
+
+// CHECK-LABEL: @grover_diffusion
+func.func @grover_diffusion(%q0 : !quantum.bit, %q1 : !quantum.bit) -> (!quantum.bit, !quantum.bit) {
+    // CHECK-NOT: quantum.custom
+    // CHECK: [[out:%.+]]:2 = quantum.reflect_uniform %arg0, %arg1 : !quantum.bit, !quantum.bit
+    // CHECK-NOT: quantum.custom
+    %0 = quantum.custom "Hadamard"() %q0 : !quantum.bit
+    %1 = quantum.custom "Hadamard"() %q1 : !quantum.bit
+    %2 = quantum.custom "PauliX"() %0 : !quantum.bit
+    %3 = quantum.custom "PauliX"() %1 : !quantum.bit
+    %4:2 = quantum.custom "CZ"() %2, %3 : !quantum.bit, !quantum.bit
+    %5 = quantum.custom "PauliX"() %4#0 : !quantum.bit
+    %6 = quantum.custom "PauliX"() %4#1 : !quantum.bit
+    %7 = quantum.custom "Hadamard"() %5 : !quantum.bit
+    %8 = quantum.custom "Hadamard"() %6 : !quantum.bit
+
+    // CHECK: return [[out]]#0, [[out]]#1
+    return %7, %8 : !quantum.bit, !quantum.bit
+}
+
+// -----
+
+// CHECK-LABEL: @grover_diffusion_toffoli
+func.func @grover_diffusion_toffoli(%q0 : !quantum.bit, %q1 : !quantum.bit, %q2 : !quantum.bit) -> (!quantum.bit, !quantum.bit, !quantum.bit) {
+    // CHECK: quantum.reflect_uniform %arg0, %arg1, %arg2 : !quantum.bit, !quantum.bit, !quantum.bit
+    // CHECK-NOT: quantum.custom
+    %0 = quantum.custom "Hadamard"() %q0 : !quantum.bit
+    %1 = quantum.custom "Hadamard"() %q1 : !quantum.bit
+    %2 = quantum.custom "Hadamard"() %q2 : !quantum.bit
+    %3 = quantum.custom "PauliX"() %0 : !quantum.bit
+    %4 = quantum.custom "PauliX"() %1 : !quantum.bit
+    %5 = quantum.custom "PauliX"() %2 : !quantum.bit
+    %6 = quantum.custom "Hadamard"() %5 : !quantum.bit
+    %7:3 = quantum.custom "Toffoli"() %3, %4, %6 : !quantum.bit, !quantum.bit, !quantum.bit
+    %8 = quantum.custom "Hadamard"() %7#2 : !quantum.bit
+    %9 = quantum.custom "PauliX"() %7#0 : !quantum.bit
+    %10 = quantum.custom "PauliX"() %7#1 : !quantum.bit
+    %11 = quantum.custom "PauliX"() %8 : !quantum.bit
+    %12 = quantum.custom "Hadamard"() %9 : !quantum.bit
+    %13 = quantum.custom "Hadamard"() %10 : !quantum.bit
+    %14 = quantum.custom "Hadamard"() %11 : !quantum.bit
+
+    return %12, %13, %14 : !quantum.bit, !quantum.bit, !quantum.bit
+}
+
+// -----
+
+// CHECK-LABEL: @grover_diffusion_shared_qubit
+func.func @grover_diffusion_shared_qubit(%q0 : !quantum.bit, %q1 : !quantum.bit) -> (!quantum.bit, !quantum.bit, !quantum.bit) {
+    // CHECK-NOT: quantum.reflect_uniform
+    %0 = quantum.custom "Hadamard"() %q0 : !quantum.bit
+    %1 = quantum.custom "Hadamard"() %q1 : !quantum.bit
+    %2 = quantum.custom "PauliX"() %0 : !quantum.bit
+    %3 = quantum.custom "PauliX"() %1 : !quantum.bit
+    %4:2 = quantum.custom "CZ"() %2, %3 : !quantum.bit, !quantum.bit
+    %5 = quantum.custom "PauliX"() %4#0 : !quantum.bit
+    %6 = quantum.custom "PauliX"() %4#1 : !quantum.bit
+    %7 = quantum.custom "Hadamard"() %5 : !quantum.bit
+    %8 = quantum.custom "Hadamard"() %6 : !quantum.bit
+
+    return %7, %8, %2 : !quantum.bit, !quantum.bit, !quantum.bit
+}
@@ -14,8 +14,11 @@
 
 #pragma once
 
+#include <cmath>
 #include <complex>
 #include <memory>
+#include <numbers>
+#include <string>
 #include <vector>
 
 #include "DataView.hpp"
@@ -118,6 +121,38 @@ struct QuantumDevice {
      */
     virtual void StopTapeRecording() = 0;
 
+    /**
+     * @brief Start recording the gates of a circuit as the template `id`,
+     * whose gate parameters are replaced at every replay.
+     *
+     * The default implementation records nothing, so that `Replay` always
+     * falls back to the execution of the circuit.
+     *
+     * @param id The identifier of the template
+     */
+    virtual void StartTemplateRecording([[maybe_unused]] int64_t id) {}
+
+    /**
+     * @brief Stop recording the current template.
+     */
+    virtual void StopTemplateRecording() {}
+
+    /**
+     * @brief Apply the gates of a recorded template, with the gate parameters
+     * taken in order from `params`.
+     *
+     * @param id The identifier of the template
+     * @param params The parameters of all gates of the template
+     *
+     * @return `bool` false if the template is not available, in which case the
+     * circuit must be executed and recorded again.
+     */
+    virtual auto Replay([[maybe_unused]] int64_t id,
+                        [[maybe_unused]] const std::vector<double> &params) -> bool
+    {
+        return false;
+    }
+
     /**
      * @brief Result value for "Zero" used in the measurement process.
      *
@@ -159,6 +194,115 @@ struct QuantumDevice {
     virtual void MatrixOperation(const std::vector<std::complex<double>> &matrix,
                                  const std::vector<QubitIdType> &wires, bool inverse) = 0;
 
+    /**
+     * @brief Apply the quantum Fourier transform, with the first wire as the most
+     * significant bit.
+     *
+     * The default implementation applies its decomposition into Hadamard,
+     * ControlledPhaseShift and SWAP gates; devices may override it with a
+     * native kernel.
+     *
+     * @param wires Wires to apply the transform to
+     * @param inverse Indicates whether to apply the inverse transform
+     */
+    virtual void QFT(const std::vector<QubitIdType> &wires, bool inverse)
+    {
+        struct GateT {
+            std::string name;
+            std::vector<double> params;
+            std::vector<QubitIdType> wires;
+        };
+
+        const size_t num_wires = wires.size();
+        std::vector<GateT> gates;
+        for (size_t i = 0; i < num_wires; i++) {
+            gates.push_back({"Hadamard", {}, {wires[i]}});
+            for (size_t j = i + 1; j < num_wires; j++) {
+                const double angle = std::ldexp(std::numbers::pi, -static_cast<int>(j - i));
+                gates.push_back({"ControlledPhaseShift", {angle}, {wires[j], wires[i]}});
+            }
+        }
+        for (size_t i = 0; i < num_wires / 2; i++) {
+            gates.push_back({"SWAP", {}, {wires[i], wires[num_wires - 1 - i]}});
+        }
+
+        if (inverse) {
+            for (auto gate = gates.rbegin(); gate != gates.rend(); gate++) {
+                NamedOperation(gate->name, gate->params, gate->wires, true);
+            }
+        }
+        else {
+            for (const auto &gate : gates) {
+                NamedOperation(gate.name, gate.params, gate.wires, false);
+            }
+        }
+    }
+
+    /**
+     * @brief Apply the reflection `I - 2|s><s|` about the uniform superposition
+     * `|s>` of the given wires, that is the Grover diffusion operator.
+     *
+     * The default implementation applies its decomposition into Hadamard and
+     * PauliX layers around a multi-controlled Z gate, itself decomposed into
+     * CNOT and PhaseShift gates over all subsets of more than 3 wires; devices
+     * may override it with a native kernel. The operator is self-inverse.
+     *
+     * @param wires Wires to apply the reflection to
+     * @param inverse Indicates whether to use inverse of the operator
+     */
+    virtual void ReflectUniform(const std::vector<QubitIdType> &wires,
+                                [[maybe_unused]] bool inverse)
+    {
+        const size_t num_wires = wires.size();
+        auto layer = [&](const std::string &name) {
+            for (auto wire : wires) {
+                NamedOperation(name, {}, {wire}, false);
+            }
+        };
+
+        layer("Hadamard");
+        layer("PauliX");
+        if (num_wires == 1) {
+            NamedOperation("PauliZ", {}, wires, false);
+        }
+        else if (num_wires == 2) {
+            NamedOperation("CZ", {}, wires, false);
+        }
+        else if (num_wires == 3) {
+            NamedOperation("Hadamard", {}, {wires[2]}, false);
+            NamedOperation("Toffoli", {}, wires, false);
+            NamedOperation("Hadamard", {}, {wires[2]}, false);
+        }
+        else if (num_wires > 3) {
+            // The phase of the all-ones state is the product of the bits, which is a sum
+            // over the parities of all subsets S of the wires:
+            //   x_1 ... x_n = 2^(1-n) sum_S (-1)^(|S|+1) parity_S(x)
+            // Each parity is computed onto the last wire of S to apply its phase.
+            const double unit = std::ldexp(std::numbers::pi, 1 - static_cast<int>(num_wires));
+            for (size_t subset = 1; subset < (1UL << num_wires); subset++) {
+                std::vector<QubitIdType> controls;
+                for (size_t i = 0; i < num_wires; i++) {
+                    if ((subset >> i) & 1UL) {
+                        controls.push_back(wires[i]);
+                    }
+                }
+                const QubitIdType target = controls.back();
+                controls.pop_back();
+
+                for (auto control : controls) {
+                    NamedOperation("CNOT", {}, {control, target}, false);
+                }
+                const double sign = controls.size() % 2 == 0 ? 1.0 : -1.0;
+                NamedOperation("PhaseShift", {sign * unit}, {target}, false);
+                for (auto control : controls) {
+                    NamedOperation("CNOT", {}, {control, target}, false);
+                }
+            }
+        }
+        layer("PauliX");
+        layer("Hadamard");
+    }
+
     /**
      * @brief Construct a named (Identity, PauliX, PauliY, PauliZ, and Hadamard)
      * or Hermitian observable.
@@ -28,9 +28,12 @@ extern "C" {
 void __quantum__rt__fail_cstr(const char *);
 void __quantum__rt__initialize();
 void __quantum__rt__device_init(int8_t *, int8_t *, int8_t *);
+void __quantum__rt__device_prefetch(int8_t *, int8_t *, int8_t *);
 void __quantum__rt__device_release();
 void __quantum__rt__finalize();
 void __quantum__rt__toggle_recorder(bool);
+void __quantum__rt__toggle_template(int64_t, bool);
+bool __quantum__rt__replay(int64_t, MemRefT_double_1d *);
 void __quantum__rt__print_state();
 void __quantum__rt__print_tensor(OpaqueMemRefT *, bool);
 void __quantum__rt__print_string(char *);
@@ -77,6 +80,8 @@ void __quantum__qis__CRot(double, double, double, QUBIT *, QUBIT *, bool);
 void __quantum__qis__CSWAP(QUBIT *, QUBIT *, QUBIT *, bool);
 void __quantum__qis__Toffoli(QUBIT *, QUBIT *, QUBIT *, bool);
 void __quantum__qis__MultiRZ(double, bool /*adjoint*/, int64_t, /*qubits*/...);
+void __quantum__qis__QFT(bool /*adjoint*/, int64_t, /*qubits*/...);
+void __quantum__qis__ReflectUniform(bool /*adjoint*/, int64_t, /*qubits*/...);
 
 // Struct pointer arguments for these instructions represent real arguments,
 // as passing structs by value is too unreliable / compiler dependant.
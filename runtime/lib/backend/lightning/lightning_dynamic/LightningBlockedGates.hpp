@@ -0,0 +1,118 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+#include <StateVectorLQubitRaw.hpp>
+
+#include "Exception.hpp"
+#include "LightningParallel.hpp"
+
+namespace Catalyst::Runtime::Simulator {
+
+namespace detail {
+/**
+ * @brief Apply the gates of `[begin, end)`, all acting on the wires from
+ * `first_local`, to each block of `2^block_qubits` amplitudes of
+ * `data[first_block * block_size:last_block * block_size]` in turn, with the
+ * kernel of each gate if it has one.
+ */
+template <typename PrecisionT, typename GateIterT>
+void applySegmentToBlocks(std::complex<PrecisionT> *data, size_t first_block, size_t last_block,
+                          size_t block_qubits, size_t first_local, GateIterT begin, GateIterT end)
+{
+    using BlockStateVectorT = Pennylane::LightningQubit::StateVectorLQubitRaw<PrecisionT>;
+
+    const size_t block_size = size_t{1} << block_qubits;
+    std::vector<size_t> local_wires;
+    for (size_t block = first_block; block < last_block; block++) {
+        BlockStateVectorT block_sv(data + block * block_size, block_size);
+        for (auto gate = begin; gate != end; ++gate) {
+            local_wires.resize(gate->wires.size());
+            std::transform(gate->wires.begin(), gate->wires.end(), local_wires.begin(),
+                           [first_local](size_t wire) { return wire - first_local; });
+            if (gate->kernel) {
+                block_sv.applyOperation(*gate->kernel, gate->name, local_wires, gate->inverse,
+                                        gate->params);
+            }
+            else {
+                block_sv.applyOperation(gate->name, local_wires, gate->inverse, gate->params);
+            }
+        }
+    }
+}
+} // namespace detail
+
+/**
+ * @brief Apply a queued sequence of named gates to a state-vector, one
+ * cache-sized block of amplitudes at a time.
+ *
+ * The gates on the last `block_qubits` wires only mix the amplitudes of
+ * contiguous blocks of `2^block_qubits` amplitudes. The sequence is split in
+ * segments of consecutive such gates, and all gates of a segment are applied
+ * to a block while it is in cache, before moving to the next block. The
+ * state-vector is then streamed from memory once per segment, instead of once
+ * per gate. Blocks are independent, and are split between the threads.
+ *
+ * The gates on higher wires, and segments of a single gate, are applied to
+ * the whole state-vector by `apply_full`.
+ *
+ * @param data The amplitudes of the state-vector
+ * @param num_qubits Number of qubits of the state-vector
+ * @param gates The gates, with `name`, device `wires`, `inverse`, `params` and
+ * optional `kernel` members
+ * @param block_qubits Number of qubits of a block
+ * @param num_threads Number of threads applying the segments
+ * @param apply_full The callable applying a gate to the whole state-vector
+ */
+template <typename PrecisionT, typename GateT, typename ApplyFullT>
+void applyGatesBlocked(std::complex<PrecisionT> *data, size_t num_qubits,
+                       const std::vector<GateT> &gates, size_t block_qubits, size_t num_threads,
+                       ApplyFullT &&apply_full)
+{
+    RT_FAIL_IF(!block_qubits || block_qubits > num_qubits, "Invalid number of block qubits");
+
+    const size_t first_local = num_qubits - block_qubits;
+    const size_t num_blocks = size_t{1} << first_local;
+    const size_t num_workers = std::max<size_t>(std::min(num_threads, num_blocks), 1);
+    auto is_local = [first_local](const GateT &gate) {
+        return std::all_of(gate.wires.begin(), gate.wires.end(),
+                           [first_local](size_t wire) { return wire >= first_local; });
+    };
+
+    for (auto begin = gates.begin(); begin != gates.end();) {
+        auto end = std::find_if_not(begin, gates.end(), is_local);
+        if (end - begin < 2) {
+            // A single gate streams the state-vector once either way
+            end = std::max(end, begin + 1);
+            apply_full(*begin);
+            begin = end;
+            continue;
+        }
+
+        const size_t chunk = (num_blocks + num_workers - 1) / num_workers;
+        parallelFor(num_workers, [&](size_t worker_id) {
+            const size_t first_block = std::min(num_blocks, worker_id * chunk);
+            const size_t last_block = std::min(num_blocks, first_block + chunk);
+            detail::applySegmentToBlocks(data, first_block, last_block, block_qubits, first_local,
+                                         begin, end);
+        });
+        begin = end;
+    }
+}
+} // namespace Catalyst::Runtime::Simulator
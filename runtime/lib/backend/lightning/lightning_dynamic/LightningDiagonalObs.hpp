@@ -0,0 +1,196 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <complex>
+#include <utility>
+#include <vector>
+
+#include "Exception.hpp"
+#include "LightningParallel.hpp"
+
+namespace Catalyst::Runtime::Simulator {
+
+/**
+ * @brief An observable diagonal in the computational basis, as a sum of
+ * products of PauliZ and diagonal Hermitian factors, e.g. the products of
+ * PauliZ and Identity observables and the Hamiltonians of Z-strings of QAOA
+ * cost functions.
+ */
+template <typename PrecisionT> struct DiagonalObs {
+    struct Factor {
+        std::vector<size_t> wires;
+        // The diagonal of the matrix, whose index has the first of `wires` as its
+        // most significant bit
+        std::vector<PrecisionT> diagonal;
+    };
+
+    struct Term {
+        PrecisionT coeff{1};
+        // The device wires of the PauliZ factors
+        std::vector<size_t> z_wires{};
+        std::vector<Factor> factors{};
+    };
+
+    std::vector<Term> terms{};
+
+    /**
+     * @brief Get the product of two diagonal observables, e.g. the factors of a
+     * tensor product, by distributing their terms.
+     */
+    static auto product(const DiagonalObs &lhs, const DiagonalObs &rhs) -> DiagonalObs
+    {
+        DiagonalObs result;
+        result.terms.reserve(lhs.terms.size() * rhs.terms.size());
+        for (const Term &lhs_term : lhs.terms) {
+            for (const Term &rhs_term : rhs.terms) {
+                Term term = lhs_term;
+                term.coeff *= rhs_term.coeff;
+                term.z_wires.insert(term.z_wires.end(), rhs_term.z_wires.begin(),
+                                    rhs_term.z_wires.end());
+                term.factors.insert(term.factors.end(), rhs_term.factors.begin(),
+                                    rhs_term.factors.end());
+                result.terms.push_back(std::move(term));
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Add the terms of a diagonal observable scaled by `coeff`, e.g. a
+     * term of a Hamiltonian.
+     */
+    void add(PrecisionT coeff, const DiagonalObs &obs)
+    {
+        for (const Term &term : obs.terms) {
+            terms.push_back(term);
+            terms.back().coeff *= coeff;
+        }
+    }
+};
+
+namespace detail {
+// Below this number of amplitudes, diagonal observables are evaluated by a single thread
+constexpr size_t diagonal_parallel_threshold{size_t{1} << 16}; // tidy: readability-magic-numbers
+
+/**
+ * @brief A term of a diagonal observable, with the bits of its wires in a
+ * basis-state index of the state-vector.
+ */
+template <typename PrecisionT> struct DiagonalTermBits {
+    PrecisionT coeff;
+    // The PauliZ factors contribute the parity of the masked index
+    size_t z_mask;
+    std::vector<std::pair<std::vector<size_t>, const std::vector<PrecisionT> *>> factors;
+};
+
+/**
+ * @brief Accumulate the first and second moments of the diagonal observable of
+ * `terms` over the probabilities of `data[begin:end]`.
+ */
+template <typename PrecisionT>
+void accumulateDiagonalMoments(const std::complex<PrecisionT> *data, size_t begin, size_t end,
+                               const std::vector<DiagonalTermBits<PrecisionT>> &terms,
+                               PrecisionT *moments)
+{
+    PrecisionT first = 0;
+    PrecisionT second = 0;
+    for (size_t idx = begin; idx < end; idx++) {
+        const PrecisionT prob = std::norm(data[idx]);
+        PrecisionT value = 0;
+        for (const auto &term : terms) {
+            PrecisionT term_value = (std::popcount(idx & term.z_mask) & 1U) ? -term.coeff
+                                                                             : term.coeff;
+            for (const auto &[bits, diagonal] : term.factors) {
+                size_t local_idx = 0;
+                for (auto bit : bits) {
+                    local_idx = (local_idx << 1) | ((idx >> bit) & 1U);
+                }
+                term_value *= (*diagonal)[local_idx];
+            }
+            value += term_value;
+        }
+        first += prob * value;
+        second += prob * value * value;
+    }
+    moments[0] += first;
+    moments[1] += second;
+}
+} // namespace detail
+
+/**
+ * @brief Compute the expectation values of a diagonal observable and of its
+ * square in a single read-only pass over the state-vector.
+ *
+ * The value of the observable at a basis state is the sum of all its terms,
+ * weighted by the probability of the basis state, so that neither a copy of
+ * the state-vector nor a matrix application is needed. The amplitudes are
+ * split in contiguous chunks between the threads.
+ *
+ * @param data The amplitudes of the state-vector
+ * @param num_qubits Number of qubits of the state-vector
+ * @param obs The diagonal observable on device wires
+ * @param num_threads The maximum number of threads, or zero for all cores
+ * @return The pair of `<obs>` and `<obs^2>`
+ */
+template <typename PrecisionT>
+auto computeDiagonalMoments(const std::complex<PrecisionT> *data, size_t num_qubits,
+                            const DiagonalObs<PrecisionT> &obs, size_t num_threads = 0)
+    -> std::pair<PrecisionT, PrecisionT>
+{
+    auto to_bit = [num_qubits](size_t wire) {
+        RT_FAIL_IF(wire >= num_qubits, "Invalid given wires to measure");
+        return wireToBit(num_qubits, wire);
+    };
+
+    std::vector<detail::DiagonalTermBits<PrecisionT>> terms;
+    terms.reserve(obs.terms.size());
+    for (const auto &term : obs.terms) {
+        detail::DiagonalTermBits<PrecisionT> term_bits{term.coeff, 0, {}};
+        for (auto wire : term.z_wires) {
+            // Z.Z is the identity
+            term_bits.z_mask ^= size_t{1} << to_bit(wire);
+        }
+        for (const auto &factor : term.factors) {
+            std::vector<size_t> bits(factor.wires.size());
+            std::transform(factor.wires.begin(), factor.wires.end(), bits.begin(), to_bit);
+            term_bits.factors.emplace_back(std::move(bits), &factor.diagonal);
+        }
+        terms.push_back(std::move(term_bits));
+    }
+
+    const size_t size = size_t{1} << num_qubits;
+    const size_t num_workers =
+        size < detail::diagonal_parallel_threshold ? 1 : getNumThreads(num_threads);
+    const size_t chunk = (size + num_workers - 1) / num_workers;
+
+    std::vector<PrecisionT> moments(2 * num_workers, 0);
+    parallelFor(num_workers, [&](size_t worker_id) {
+        const size_t begin = std::min(size, worker_id * chunk);
+        const size_t end = std::min(size, begin + chunk);
+        detail::accumulateDiagonalMoments(data, begin, end, terms,
+                                          moments.data() + 2 * worker_id);
+    });
+
+    std::pair<PrecisionT, PrecisionT> result{0, 0};
+    for (size_t worker_id = 0; worker_id < num_workers; worker_id++) {
+        result.first += moments[2 * worker_id];
+        result.second += moments[2 * worker_id + 1];
+    }
+    return result;
+}
+} // namespace Catalyst::Runtime::Simulator
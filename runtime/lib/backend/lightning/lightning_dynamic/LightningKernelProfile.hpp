@@ -0,0 +1,373 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include "Exception.hpp"
+#include "LightningParallel.hpp"
+
+#include "DynamicDispatcher.hpp"
+#include "KernelType.hpp"
+#include "StateVectorLQubitDynamic.hpp"
+
+namespace Catalyst::Runtime::Simulator {
+
+/**
+ * @brief The LightningKernelProfile maps gates to the fastest Lightning gate
+ * kernel of the host machine.
+ *
+ * Entries are keyed by the gate name, the position class of the target wires
+ * and the range of the number of qubits of the state-vector. In autotuning
+ * mode, missing entries are measured on first use by timing every registered
+ * kernel implementation of the gate, and the profile is written back to disk
+ * with the device, so that later runs on the same machine can load it at
+ * device construction.
+ */
+template <typename PrecisionT> class LightningKernelProfile {
+  private:
+    using StateVectorT = Pennylane::LightningQubit::StateVectorLQubitDynamic<PrecisionT>;
+    using KernelType = Pennylane::Gates::KernelType;
+    using DispatcherT = Pennylane::LightningQubit::DynamicDispatcher<PrecisionT>;
+
+    // Wires whose bit position is below this threshold are permuted within
+    // one SIMD register by vectorized kernels.
+    static constexpr size_t simd_wire_threshold{3}; // tidy: readability-magic-numbers
+
+    // Upper bounds of the qubit-count ranges, roughly matching state-vectors
+    // that fit into the L1, L2, L3 caches and the main memory.
+    static constexpr std::array<size_t, 3> qubit_ranges{10, 16, 20};
+
+    // Number of timed applications of a gate per kernel.
+    static constexpr size_t num_repetitions{4}; // tidy: readability-magic-numbers
+
+    std::string path_;
+    bool autotune_{false};
+    // Whether entries were measured since the profile was loaded
+    bool updated_{false};
+    std::unordered_map<std::string, KernelType> kernels_{};
+
+    // The state-vector the missing entries are timed on, reused across gates
+    std::unique_ptr<StateVectorT> scratch_{};
+
+    [[nodiscard]] static auto getKey(const std::string &name, const std::vector<size_t> &wires,
+                                     size_t num_qubits) -> std::string
+    {
+        const size_t min_bit = wireToBit(num_qubits, *std::max_element(wires.begin(), wires.end()));
+        const size_t wire_class = min_bit < simd_wire_threshold ? 0 : 1;
+        const size_t range = static_cast<size_t>(
+            std::distance(qubit_ranges.begin(),
+                          std::lower_bound(qubit_ranges.begin(), qubit_ranges.end(), num_qubits)));
+
+        std::ostringstream oss;
+        oss << name << ':' << wire_class << ':' << range;
+        return oss.str();
+    }
+
+    [[nodiscard]] static auto getKernelByName(const std::string &kernel_name)
+        -> std::optional<KernelType>
+    {
+        auto &dispatcher = DispatcherT::getInstance();
+        for (auto kernel : dispatcher.registeredKernels()) {
+            if (dispatcher.getKernelName(kernel) == kernel_name) {
+                return kernel;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Get the number of qubits of the scratch state-vector the gates of
+     * a qubit-count range are timed on, bounded by the last range.
+     */
+    [[nodiscard]] static auto getScratchQubits(size_t num_qubits) -> size_t
+    {
+        auto iter = std::lower_bound(qubit_ranges.begin(), qubit_ranges.end(), num_qubits);
+        return iter != qubit_ranges.end() ? *iter : qubit_ranges.back();
+    }
+
+    /**
+     * @brief Map the device wires of a gate to the wires of the scratch
+     * state-vector, keeping the bit positions below the scratch size, such that
+     * the gate keeps its wire class.
+     */
+    [[nodiscard]] static auto getScratchWires(const std::vector<size_t> &wires, size_t num_qubits,
+                                              size_t scratch_qubits) -> std::vector<size_t>
+    {
+        constexpr size_t unmapped = std::numeric_limits<size_t>::max();
+        std::vector<size_t> scratch_wires(wires.size(), unmapped);
+        std::vector<bool> used(scratch_qubits, false);
+        for (size_t idx = 0; idx < wires.size(); idx++) {
+            const size_t bit = wireToBit(num_qubits, wires[idx]);
+            if (bit < scratch_qubits) {
+                scratch_wires[idx] = scratch_qubits - 1 - bit;
+                used[scratch_wires[idx]] = true;
+            }
+        }
+
+        // The wires of the most significant bits go to the first free wires of the scratch
+        size_t next = 0;
+        for (auto &wire : scratch_wires) {
+            if (wire == unmapped) {
+                while (used[next]) {
+                    next++;
+                }
+                wire = next;
+                used[next] = true;
+            }
+        }
+        return scratch_wires;
+    }
+
+    /**
+     * @brief Time every kernel implementing the gate on the scratch state-vector
+     * of the qubit-count range and threading of the given one.
+     *
+     * The state-vector the gate is applied to is left untouched, so that the
+     * timed applications of the gate and of its inverse do not accumulate
+     * rounding errors in the simulated state.
+     */
+    [[nodiscard]] auto benchmark(const StateVectorT &sv, const std::string &name,
+                                 const std::vector<size_t> &wires,
+                                 const std::vector<PrecisionT> &params) -> std::optional<KernelType>
+    {
+        auto &dispatcher = DispatcherT::getInstance();
+        const auto gate_op = dispatcher.strToGateOp(name);
+
+        const size_t scratch_qubits = getScratchQubits(sv.getNumQubits());
+        if (!scratch_ || scratch_->getNumQubits() != scratch_qubits ||
+            scratch_->threading() != sv.threading()) {
+            scratch_ = std::make_unique<StateVectorT>(scratch_qubits, sv.threading(),
+                                                      sv.memoryModel());
+        }
+        const auto scratch_wires = getScratchWires(wires, sv.getNumQubits(), scratch_qubits);
+
+        std::optional<KernelType> best{};
+        auto best_time = std::chrono::nanoseconds::max();
+        for (auto kernel : dispatcher.registeredKernels()) {
+            if (!dispatcher.isRegistered(gate_op, kernel)) {
+                continue;
+            }
+
+            auto elapsed = std::chrono::nanoseconds::zero();
+            for (size_t rep = 0; rep < num_repetitions; rep++) {
+                auto start = std::chrono::steady_clock::now();
+                scratch_->applyOperation(kernel, name, scratch_wires, false, params);
+                elapsed += std::chrono::steady_clock::now() - start;
+            }
+
+            if (elapsed < best_time) {
+                best_time = elapsed;
+                best = kernel;
+            }
+        }
+        return best;
+    }
+
+  public:
+    /**
+     * @brief Create a kernel profile.
+     *
+     * @param path The profile file, loaded if it exists
+     * @param autotune Measure and persist missing entries on first use
+     */
+    LightningKernelProfile(std::string path, bool autotune)
+        : path_{std::move(path)}, autotune_{autotune}
+    {
+        if (!path_.empty() && std::filesystem::exists(path_)) {
+            load();
+        }
+    }
+    LightningKernelProfile() = default;
+
+    /**
+     * @brief Save the entries measured during the lifetime of the profile, once
+     * per device.
+     */
+    ~LightningKernelProfile()
+    {
+        if (!updated_) {
+            return;
+        }
+        try {
+            save();
+        }
+        catch (const std::exception &) {
+            // A profile that cannot be written is measured again by the next device
+        }
+    }
+
+    LightningKernelProfile(const LightningKernelProfile &) = delete;
+    LightningKernelProfile &operator=(const LightningKernelProfile &) = delete;
+    LightningKernelProfile(LightningKernelProfile &&other) noexcept
+        : path_{std::move(other.path_)}, autotune_{other.autotune_},
+          updated_{std::exchange(other.updated_, false)}, kernels_{std::move(other.kernels_)},
+          scratch_{std::move(other.scratch_)}
+    {
+    }
+    LightningKernelProfile &operator=(LightningKernelProfile &&other) noexcept
+    {
+        path_ = std::move(other.path_);
+        autotune_ = other.autotune_;
+        updated_ = std::exchange(other.updated_, false);
+        kernels_ = std::move(other.kernels_);
+        scratch_ = std::move(other.scratch_);
+        return *this;
+    }
+
+    /**
+     * @brief Get the default location of the per-machine profile, defined by
+     * `CATALYST_KERNEL_PROFILE` or otherwise placed in the user cache directory.
+     */
+    [[nodiscard]] static auto getDefaultPath() -> std::string
+    {
+        if (const char *env = std::getenv("CATALYST_KERNEL_PROFILE")) {
+            return env;
+        }
+        if (const char *cache = std::getenv("XDG_CACHE_HOME")) {
+            return std::filesystem::path(cache) / "catalyst" / "lightning_kernels.profile";
+        }
+        if (const char *home = std::getenv("HOME")) {
+            return std::filesystem::path(home) / ".cache" / "catalyst" /
+                   "lightning_kernels.profile";
+        }
+        return {};
+    }
+
+    /**
+     * @brief Read the profile entries, each line holding a key and a kernel name.
+     * Entries of kernels not registered in this build are ignored.
+     */
+    void load()
+    {
+        std::ifstream ifs(path_);
+        RT_FAIL_IF(!ifs.is_open(), "Cannot open the kernel profile file");
+
+        std::string key;
+        std::string kernel_name;
+        while (ifs >> key >> kernel_name) {
+            if (auto kernel = getKernelByName(kernel_name)) {
+                kernels_[key] = *kernel;
+            }
+        }
+    }
+
+    /**
+     * @brief Write the profile entries back to the profile file.
+     *
+     * The entries are written to a temporary file of the same directory, which
+     * then replaces the profile, such that concurrent devices never read a
+     * partially written profile.
+     */
+    void save() const
+    {
+        if (path_.empty()) {
+            return;
+        }
+
+        std::filesystem::path path{path_};
+        if (path.has_parent_path()) {
+            std::error_code ec;
+            std::filesystem::create_directories(path.parent_path(), ec);
+        }
+
+        std::filesystem::path tmp_path{path};
+        tmp_path += ".tmp." + std::to_string(getpid()) + "." +
+                    std::to_string(reinterpret_cast<uintptr_t>(this));
+        {
+            std::ofstream ofs(tmp_path, std::ios::trunc);
+            RT_FAIL_IF(!ofs.is_open(), "Cannot write the kernel profile file");
+
+            auto &dispatcher = DispatcherT::getInstance();
+            for (const auto &[key, kernel] : kernels_) {
+                ofs << key << ' ' << dispatcher.getKernelName(kernel) << '\n';
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmp_path, path, ec);
+        if (ec) {
+            std::filesystem::remove(tmp_path, ec);
+            RT_FAIL("Cannot write the kernel profile file");
+        }
+    }
+
+    [[nodiscard]] auto size() const -> size_t { return kernels_.size(); }
+
+    /**
+     * @brief Check whether the kernel implements the named gate.
+     */
+    [[nodiscard]] static auto implements(KernelType kernel, const std::string &name) -> bool
+    {
+        auto &dispatcher = DispatcherT::getInstance();
+        return dispatcher.hasGateOp(name) &&
+               dispatcher.isRegistered(dispatcher.strToGateOp(name), kernel);
+    }
+
+    /**
+     * @brief Get the kernel to dispatch the gate to, if the profile has one.
+     *
+     * In autotuning mode, a missing entry is measured on a scratch state-vector
+     * of the qubit-count range of the given one. The updated profile is saved
+     * when the profile is destroyed.
+     *
+     * @param sv The state-vector the gate is applied to
+     * @param name The name of the gate
+     * @param wires The device wires of the gate
+     * @param params The parameters of the gate
+     *
+     * @return std::optional<KernelType>
+     */
+    auto getKernel(const StateVectorT &sv, const std::string &name,
+                   const std::vector<size_t> &wires,
+                   const std::vector<PrecisionT> &params) -> std::optional<KernelType>
+    {
+        if ((kernels_.empty() && !autotune_) || wires.empty()) {
+            return std::nullopt;
+        }
+
+        const auto key = getKey(name, wires, sv.getNumQubits());
+        if (auto iter = kernels_.find(key); iter != kernels_.end()) {
+            return iter->second;
+        }
+        if (!autotune_) {
+            return std::nullopt;
+        }
+
+        auto best = benchmark(sv, name, wires, params);
+        if (best) {
+            kernels_[key] = *best;
+            updated_ = true;
+        }
+        return best;
+    }
+};
+} // namespace Catalyst::Runtime::Simulator
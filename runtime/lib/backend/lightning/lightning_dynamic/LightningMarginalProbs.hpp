@@ -0,0 +1,162 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+#include "Exception.hpp"
+#include "LightningParallel.hpp"
+
+namespace Catalyst::Runtime::Simulator {
+
+namespace detail {
+// Below this number of amplitudes, marginal probabilities are computed by a single thread
+constexpr size_t marginal_parallel_threshold{size_t{1} << 16}; // tidy: readability-magic-numbers
+
+/**
+ * @brief Accumulate the squared norms of `data[begin:end]` into bins, one run
+ * of consecutive amplitudes at a time.
+ *
+ * A run holds the amplitudes of a same bin, i.e. the lowest `run_bit` bits of
+ * their indices vary, so that it is summed by a contiguous loop.
+ */
+template <typename PrecisionT, typename BinT>
+void accumulateRuns(const std::complex<PrecisionT> *data, size_t begin, size_t end,
+                    size_t run_bit, BinT &&bin, PrecisionT *bins)
+{
+    const size_t run_mask = (size_t{1} << run_bit) - 1;
+    for (size_t idx = begin; idx < end;) {
+        const size_t run_end = std::min(end, (idx | run_mask) + 1);
+        PrecisionT sum = 0;
+        for (size_t i = idx; i < run_end; i++) {
+            sum += std::norm(data[i]);
+        }
+        bins[bin(idx)] += sum;
+        idx = run_end;
+    }
+}
+
+/**
+ * @brief Accumulate the squared norms of `data[begin:end]` into the bins of
+ * the marginal distribution of the qubits of `bits`, the first one being the
+ * most significant bit of a bin.
+ */
+template <typename PrecisionT>
+void accumulateMarginal(const std::complex<PrecisionT> *data, size_t begin, size_t end,
+                        const std::vector<size_t> &bits, PrecisionT *bins)
+{
+    const size_t run_bit = *std::min_element(bits.begin(), bits.end());
+
+    if (bits.size() == 1) {
+        if (run_bit == 0) {
+            // The bins alternate; `begin` and `end` are even
+            PrecisionT sum0 = 0;
+            PrecisionT sum1 = 0;
+            for (size_t idx = begin; idx < end; idx += 2) {
+                sum0 += std::norm(data[idx]);
+                sum1 += std::norm(data[idx + 1]);
+            }
+            bins[0] += sum0;
+            bins[1] += sum1;
+            return;
+        }
+        const size_t bit = bits[0];
+        accumulateRuns(
+            data, begin, end, run_bit, [bit](size_t idx) { return (idx >> bit) & 1U; }, bins);
+        return;
+    }
+
+    if (bits.size() == 2) {
+        const size_t bit0 = bits[0];
+        const size_t bit1 = bits[1];
+        accumulateRuns(
+            data, begin, end, run_bit,
+            [bit0, bit1](size_t idx) { return (((idx >> bit0) & 1U) << 1) | ((idx >> bit1) & 1U); },
+            bins);
+        return;
+    }
+
+    accumulateRuns(
+        data, begin, end, run_bit,
+        [&bits](size_t idx) {
+            size_t bin = 0;
+            for (auto bit : bits) {
+                bin = (bin << 1) | ((idx >> bit) & 1U);
+            }
+            return bin;
+        },
+        bins);
+}
+} // namespace detail
+
+/**
+ * @brief Compute the marginal probabilities of a set of wires of a
+ * state-vector in a single streaming pass over its amplitudes.
+ *
+ * The amplitudes are split in contiguous chunks, summed in parallel into
+ * thread-local bins, so that no distribution over all qubits is materialized
+ * and the extra memory is `2^k` values per thread for `k` wires.
+ *
+ * @param data The amplitudes of the state-vector
+ * @param num_qubits Number of qubits of the state-vector
+ * @param wires Device wires, the first one being the most significant bit of
+ * the result index
+ * @param num_threads The maximum number of threads, or zero for all cores
+ */
+template <typename PrecisionT>
+auto computeMarginalProbs(const std::complex<PrecisionT> *data, size_t num_qubits,
+                          const std::vector<size_t> &wires, size_t num_threads = 0)
+    -> std::vector<PrecisionT>
+{
+    const size_t num_wires = wires.size();
+    RT_FAIL_IF(num_wires > num_qubits, "Invalid number of wires");
+
+    const size_t num_bins = size_t{1} << num_wires;
+    const size_t size = size_t{1} << num_qubits;
+    if (num_wires == 0) {
+        return {1};
+    }
+
+    std::vector<size_t> bits(num_wires);
+    std::transform(wires.begin(), wires.end(), bits.begin(), [num_qubits](size_t wire) {
+        RT_FAIL_IF(wire >= num_qubits, "Invalid given wires to measure");
+        return wireToBit(num_qubits, wire);
+    });
+
+    const size_t num_workers =
+        size < detail::marginal_parallel_threshold ? 1 : getNumThreads(num_threads);
+    // Chunks are even, for the alternating bins of a single least significant wire
+    const size_t chunk = ((size + num_workers - 1) / num_workers + 1) & ~size_t{1};
+
+    std::vector<PrecisionT> bins(num_workers * num_bins, 0);
+    parallelFor(num_workers, [&](size_t worker_id) {
+        const size_t begin = std::min(size, worker_id * chunk);
+        const size_t end = std::min(size, begin + chunk);
+        if (begin < end) {
+            detail::accumulateMarginal(data, begin, end, bits, bins.data() + worker_id * num_bins);
+        }
+    });
+
+    std::vector<PrecisionT> probs(bins.begin(), bins.begin() + num_bins);
+    for (size_t worker_id = 1; worker_id < num_workers; worker_id++) {
+        for (size_t bin = 0; bin < num_bins; bin++) {
+            probs[bin] += bins[worker_id * num_bins + bin];
+        }
+    }
+    return probs;
+}
+} // namespace Catalyst::Runtime::Simulator
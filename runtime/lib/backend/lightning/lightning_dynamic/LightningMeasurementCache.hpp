@@ -0,0 +1,153 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <numeric>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "LightningParallel.hpp"
+#include "Types.h"
+
+namespace Catalyst::Runtime::Simulator {
+
+/**
+ * @brief The LightningMeasurementCache memoizes the results of measurement
+ * processes on a version of the state of a device.
+ *
+ * The device increments its state version on any change of the state, e.g. a
+ * gate, a mid-circuit measurement or a qubit allocation. Results of an older
+ * version are dropped at the first request on the new version, so that
+ * repeated and overlapping measurements of the same state, e.g. `probs` and
+ * `expval` of a circuit, sweep the state-vector only once.
+ */
+class LightningMeasurementCache {
+  private:
+    size_t version_{0};
+    // Probabilities keyed by their device wires, in order
+    std::map<std::vector<size_t>, std::vector<double>> probs_{};
+    std::unordered_map<ObsIdType, double> expvals_{};
+    std::unordered_map<ObsIdType, double> vars_{};
+    // Samples keyed by their number of shots
+    std::unordered_map<size_t, std::vector<size_t>> samples_{};
+
+    template <typename MapT, typename KeyT, typename ComputeT>
+    static auto memoize(MapT &map, const KeyT &key, ComputeT &&compute) ->
+        typename MapT::mapped_type &
+    {
+        auto iter = map.find(key);
+        if (iter == map.end()) {
+            iter = map.emplace(key, compute()).first;
+        }
+        return iter->second;
+    }
+
+    /**
+     * @brief Get the probabilities of `wires` from the cached probabilities of
+     * all `num_qubits` qubits, if any.
+     */
+    [[nodiscard]] auto marginalize(const std::vector<size_t> &wires, size_t num_qubits) const
+        -> std::optional<std::vector<double>>
+    {
+        std::vector<size_t> all_wires(num_qubits);
+        std::iota(all_wires.begin(), all_wires.end(), 0);
+        auto iter = probs_.find(all_wires);
+        if (iter == probs_.end()) {
+            return std::nullopt;
+        }
+
+        // The first of `wires` is the most significant bit of the marginal probabilities
+        const std::vector<double> &all_probs = iter->second;
+        std::vector<double> probs(size_t{1} << wires.size(), 0);
+        for (size_t index = 0; index < all_probs.size(); index++) {
+            size_t marginal_index = 0;
+            for (auto wire : wires) {
+                marginal_index = (marginal_index << 1) | getWireBit(index, num_qubits, wire);
+            }
+            probs[marginal_index] += all_probs[index];
+        }
+        return probs;
+    }
+
+  public:
+    LightningMeasurementCache() = default;
+    ~LightningMeasurementCache() = default;
+
+    LightningMeasurementCache(const LightningMeasurementCache &) = delete;
+    LightningMeasurementCache &operator=(const LightningMeasurementCache &) = delete;
+    LightningMeasurementCache(LightningMeasurementCache &&) = delete;
+    LightningMeasurementCache &operator=(LightningMeasurementCache &&) = delete;
+
+    /**
+     * @brief Drop the cached results if the state changed since they were computed.
+     *
+     * @param version The current version of the state
+     */
+    void sync(size_t version)
+    {
+        if (version == version_) {
+            return;
+        }
+        version_ = version;
+        probs_.clear();
+        expvals_.clear();
+        vars_.clear();
+        samples_.clear();
+    }
+
+    /**
+     * @brief Get the probabilities of a list of device wires.
+     *
+     * Partial probabilities are marginalized from the cached probabilities of
+     * all qubits when available.
+     *
+     * @param wires The device wires, in the order of the result
+     * @param num_qubits The number of qubits of the state
+     * @param compute The callable computing the probabilities on a cache miss
+     */
+    template <typename ComputeT>
+    auto getProbs(const std::vector<size_t> &wires, size_t num_qubits, ComputeT &&compute)
+        -> const std::vector<double> &
+    {
+        return memoize(probs_, wires, [&]() -> std::vector<double> {
+            if (wires.size() < num_qubits) {
+                if (auto &&probs = marginalize(wires, num_qubits)) {
+                    return std::move(*probs);
+                }
+            }
+            return compute();
+        });
+    }
+
+    template <typename ComputeT> auto getExpval(ObsIdType obsKey, ComputeT &&compute) -> double
+    {
+        return memoize(expvals_, obsKey, std::forward<ComputeT>(compute));
+    }
+
+    template <typename ComputeT> auto getVar(ObsIdType obsKey, ComputeT &&compute) -> double
+    {
+        return memoize(vars_, obsKey, std::forward<ComputeT>(compute));
+    }
+
+    template <typename ComputeT>
+    auto getSamples(size_t shots, ComputeT &&compute) -> const std::vector<size_t> &
+    {
+        return memoize(samples_, shots, std::forward<ComputeT>(compute));
+    }
+};
+} // namespace Catalyst::Runtime::Simulator
@@ -0,0 +1,234 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Exception.hpp"
+#include "LightningParallel.hpp"
+
+namespace Catalyst::Runtime::Simulator {
+
+/**
+ * @brief A counter-based random number generator.
+ *
+ * The n-th number of a stream is the SplitMix64 finalizer applied to the key
+ * of the stream offset by n, so that streams of different keys are
+ * independent and need no shared state between threads.
+ */
+class CounterRNG {
+  private:
+    static constexpr uint64_t golden_gamma{0x9e3779b97f4a7c15ULL};
+
+    uint64_t key_;
+    uint64_t counter_{0};
+
+    [[nodiscard]] static constexpr auto mix(uint64_t z) -> uint64_t
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL; // tidy: readability-magic-numbers
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL; // tidy: readability-magic-numbers
+        return z ^ (z >> 31);
+    }
+
+  public:
+    using result_type = uint64_t;
+
+    CounterRNG(uint64_t seed, uint64_t stream) : key_{mix(seed + mix(stream + golden_gamma))} {}
+
+    static constexpr auto min() -> result_type { return 0; }
+    static constexpr auto max() -> result_type { return std::numeric_limits<result_type>::max(); }
+
+    auto operator()() -> result_type { return mix(key_ + golden_gamma * ++counter_); }
+
+    /**
+     * @brief Draw a double uniformly distributed in [0, 1).
+     */
+    auto uniform() -> double
+    {
+        constexpr double scale = 0x1.0p-53;
+        return static_cast<double>((*this)() >> 11) * scale; // tidy: readability-magic-numbers
+    }
+
+    /**
+     * @brief Draw an integer uniformly distributed in [0, bound).
+     */
+    auto below(size_t bound) -> size_t
+    {
+        return std::min(static_cast<size_t>(uniform() * static_cast<double>(bound)), bound - 1);
+    }
+};
+
+/**
+ * @brief Metropolis-Hastings sampling of the computational basis states of a
+ * state-vector with several independent Markov chains run in parallel.
+ *
+ * Each chain has its own burn-in and random stream, and writes the samples of
+ * its share of the shots directly into the output buffer. Transitions are
+ * proposed by the `Local` kernel, flipping one random qubit, or the
+ * `NonZeroRandom` kernel, drawing a random basis state of non-zero amplitude.
+ * Both proposals are symmetric, so a move is accepted with probability
+ * `min(1, p(proposed) / p(current))`.
+ */
+template <typename PrecisionT> class LightningMetropolisSampler {
+  public:
+    struct Options {
+        std::string kernel_name{"Local"};
+        size_t num_burnin{0};
+        size_t num_chains{1};
+        // Number of transitions between two recorded samples of a chain
+        size_t thinning{1};
+        uint64_t seed{0};
+    };
+
+  private:
+    const std::complex<PrecisionT> *data_;
+    size_t num_qubits_;
+    Options options_;
+    bool local_kernel_;
+    // Basis states of non-zero amplitude, for the NonZeroRandom kernel
+    std::vector<size_t> non_zeros_{};
+
+    [[nodiscard]] auto prob(size_t index) const -> PrecisionT { return std::norm(data_[index]); }
+
+    struct ChainStats {
+        size_t accepted{0};
+        size_t proposed{0};
+    };
+
+    auto propose(size_t current, CounterRNG &rng) const -> size_t
+    {
+        if (local_kernel_) {
+            return current ^ (size_t{1} << rng.below(num_qubits_));
+        }
+        return non_zeros_[rng.below(non_zeros_.size())];
+    }
+
+    auto step(size_t current, CounterRNG &rng, ChainStats &stats) const -> size_t
+    {
+        const size_t proposed = propose(current, rng);
+        const PrecisionT current_prob = prob(current);
+        const PrecisionT ratio = current_prob > 0 ? prob(proposed) / current_prob : 1;
+
+        stats.proposed++;
+        if (ratio >= 1 || rng.uniform() < static_cast<double>(ratio)) {
+            stats.accepted++;
+            return proposed;
+        }
+        return current;
+    }
+
+    auto runChain(size_t chain, std::span<size_t> samples) const -> ChainStats
+    {
+        CounterRNG rng(options_.seed, chain);
+        ChainStats burnin_stats{};
+        ChainStats stats{};
+
+        size_t current = non_zeros_.empty() ? rng.below(size_t{1} << num_qubits_)
+                                            : non_zeros_[rng.below(non_zeros_.size())];
+        for (size_t idx = 0; idx < options_.num_burnin; idx++) {
+            current = step(current, rng, burnin_stats);
+        }
+
+        const size_t num_shots = samples.size() / num_qubits_;
+        for (size_t shot = 0; shot < num_shots; shot++) {
+            for (size_t idx = 0; idx < options_.thinning; idx++) {
+                current = step(current, rng, stats);
+            }
+            for (size_t wire = 0; wire < num_qubits_; wire++) {
+                samples[shot * num_qubits_ + wire] = getWireBit(current, num_qubits_, wire);
+            }
+        }
+        return stats;
+    }
+
+  public:
+    /**
+     * @brief Create a sampler of the given state-vector.
+     *
+     * @param data The amplitudes of the state-vector
+     * @param num_qubits The number of qubits of the state-vector
+     * @param options The kernel, burn-in, number of chains and thinning
+     */
+    LightningMetropolisSampler(const std::complex<PrecisionT> *data, size_t num_qubits,
+                               Options options)
+        : data_{data}, num_qubits_{num_qubits}, options_{std::move(options)},
+          local_kernel_{options_.kernel_name == "Local"}
+    {
+        RT_FAIL_IF(!local_kernel_ && options_.kernel_name != "NonZeroRandom",
+                   "Unsupported kernel for MCMC sampling");
+        RT_FAIL_IF(!options_.num_chains, "Invalid number of MCMC chains");
+        RT_FAIL_IF(!options_.thinning, "Invalid MCMC thinning interval");
+
+        if (!local_kernel_) {
+            const size_t size = size_t{1} << num_qubits_;
+            for (size_t index = 0; index < size; index++) {
+                if (prob(index) > 0) {
+                    non_zeros_.push_back(index);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Sample the basis states of the state-vector.
+     *
+     * @param samples The output buffer of `shots * num_qubits` bits, one row per shot
+     * @param num_threads The maximum number of threads, or zero for all cores
+     *
+     * @return The acceptance rate of the transitions following the burn-in
+     */
+    auto sample(std::span<size_t> samples, size_t num_threads = 0) const -> double
+    {
+        if (num_qubits_ == 0 || samples.empty()) {
+            return 0;
+        }
+
+        const size_t shots = samples.size() / num_qubits_;
+        const size_t num_chains = std::min(options_.num_chains, shots);
+        std::vector<ChainStats> stats(num_chains);
+
+        // The first `shots % num_chains` chains draw one more sample than the others
+        auto chainSamples = [&](size_t chain) {
+            const size_t base = shots / num_chains;
+            const size_t extra = shots % num_chains;
+            const size_t first = chain * base + std::min(chain, extra);
+            const size_t count = base + (chain < extra ? 1 : 0);
+            return samples.subspan(first * num_qubits_, count * num_qubits_);
+        };
+
+        const size_t num_workers = std::min(num_chains, getNumThreads(num_threads));
+        parallelFor(num_workers, [&](size_t first_chain) {
+            for (size_t chain = first_chain; chain < num_chains; chain += num_workers) {
+                stats[chain] = runChain(chain, chainSamples(chain));
+            }
+        });
+
+        ChainStats total{};
+        for (const auto &chain_stats : stats) {
+            total.accepted += chain_stats.accepted;
+            total.proposed += chain_stats.proposed;
+        }
+        return static_cast<double>(total.accepted) / static_cast<double>(total.proposed);
+    }
+};
+} // namespace Catalyst::Runtime::Simulator
@@ -0,0 +1,161 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <span>
+#include <utility>
+
+#include "LightningMetropolisSampler.hpp"
+#include "LightningParallel.hpp"
+
+/**
+ * Single-qubit noise channels applied to a pure state as a stochastic jump,
+ * i.e. a single Kraus operator drawn with the probability it has on the state.
+ * Averaging observables over many trajectories then estimates their value on
+ * the mixed state of the channel.
+ */
+namespace Catalyst::Runtime::Simulator {
+
+/**
+ * @brief Call `func(i0, i1)` for each pair of basis states differing only in the
+ * bit of `wire`, where `i0` has this bit unset.
+ */
+template <typename FuncT> void forEachWirePair(size_t num_qubits, size_t wire, FuncT &&func)
+{
+    const size_t stride = size_t{1} << wireToBit(num_qubits, wire);
+    const size_t size = size_t{1} << num_qubits;
+    for (size_t block = 0; block < size; block += 2 * stride) {
+        for (size_t idx = block; idx < block + stride; idx++) {
+            func(idx, idx + stride);
+        }
+    }
+}
+
+/**
+ * @brief Get the probability of measuring `wire` in the state |1>.
+ */
+template <typename PrecisionT>
+auto getWireProbability(const std::complex<PrecisionT> *data, size_t num_qubits, size_t wire)
+    -> PrecisionT
+{
+    PrecisionT prob = 0;
+    forEachWirePair(num_qubits, wire, [&](size_t, size_t i1) { prob += std::norm(data[i1]); });
+    return prob;
+}
+
+/**
+ * @brief Project `wire` onto a basis state, and normalize the result.
+ *
+ * @return The probability of the outcome before the projection; the state is
+ * left unnormalized if it is zero.
+ */
+template <typename PrecisionT>
+auto projectWire(std::complex<PrecisionT> *data, size_t num_qubits, size_t wire, bool outcome)
+    -> PrecisionT
+{
+    const PrecisionT prob1 = getWireProbability(data, num_qubits, wire);
+    const PrecisionT prob = outcome ? prob1 : 1 - prob1;
+    const PrecisionT scale = prob > 0 ? 1 / std::sqrt(prob) : 0;
+    forEachWirePair(num_qubits, wire, [&](size_t i0, size_t i1) {
+        data[outcome ? i0 : i1] = 0;
+        data[outcome ? i1 : i0] *= scale;
+    });
+    return prob;
+}
+
+/**
+ * @brief Apply the depolarizing channel of probability `prob`, which applies
+ * one of the PauliX, PauliY and PauliZ gates with probability `prob / 3` each.
+ */
+template <typename PrecisionT>
+void applyDepolarizing(std::complex<PrecisionT> *data, size_t num_qubits, size_t wire, double prob,
+                       CounterRNG &rng)
+{
+    const double draw = rng.uniform();
+    if (draw >= prob) {
+        return;
+    }
+
+    const std::complex<PrecisionT> imag{0, 1};
+    const size_t pauli = std::min<size_t>(static_cast<size_t>(3 * draw / prob), 2);
+    forEachWirePair(num_qubits, wire, [&](size_t i0, size_t i1) {
+        switch (pauli) {
+        case 0:
+            std::swap(data[i0], data[i1]);
+            break;
+        case 1: {
+            const std::complex<PrecisionT> amp0 = data[i0];
+            data[i0] = -imag * data[i1];
+            data[i1] = imag * amp0;
+            break;
+        }
+        default:
+            data[i1] = -data[i1];
+        }
+    });
+}
+
+/**
+ * @brief Apply the amplitude damping channel of rate `gamma`, of Kraus
+ * operators K0 = [[1, 0], [0, sqrt(1 - gamma)]] and K1 = [[0, sqrt(gamma)], [0, 0]].
+ *
+ * The decay K1 happens with probability `gamma * p1`, where `p1` is the
+ * probability of measuring the wire in the state |1>.
+ */
+template <typename PrecisionT>
+void applyAmplitudeDamping(std::complex<PrecisionT> *data, size_t num_qubits, size_t wire,
+                           double gamma, CounterRNG &rng)
+{
+    const PrecisionT prob1 = getWireProbability(data, num_qubits, wire);
+    const PrecisionT prob_decay = static_cast<PrecisionT>(gamma) * prob1;
+
+    if (rng.uniform() < static_cast<double>(prob_decay)) {
+        const PrecisionT scale = 1 / std::sqrt(prob1);
+        forEachWirePair(num_qubits, wire, [&](size_t i0, size_t i1) {
+            data[i0] = data[i1] * scale;
+            data[i1] = 0;
+        });
+        return;
+    }
+
+    const PrecisionT damping = std::sqrt(1 - static_cast<PrecisionT>(gamma));
+    const PrecisionT scale = 1 / std::sqrt(1 - prob_decay);
+    forEachWirePair(num_qubits, wire, [&](size_t i0, size_t i1) {
+        data[i0] *= scale;
+        data[i1] *= damping * scale;
+    });
+}
+
+/**
+ * @brief Apply a symmetric readout error of probability `prob` to each wire of
+ * a probability distribution over `2^num_wires` basis states.
+ */
+inline void applyReadoutError(std::span<double> probs, size_t num_wires, double prob)
+{
+    if (prob == 0) {
+        return;
+    }
+    for (size_t wire = 0; wire < num_wires; wire++) {
+        forEachWirePair(num_wires, wire, [&](size_t i0, size_t i1) {
+            const double p0 = probs[i0];
+            const double p1 = probs[i1];
+            probs[i0] = (1 - prob) * p0 + prob * p1;
+            probs[i1] = (1 - prob) * p1 + prob * p0;
+        });
+    }
+}
+} // namespace Catalyst::Runtime::Simulator
@@ -15,11 +15,13 @@
 #pragma once
 
 #include <array>
+#include <optional>
 #include <stdexcept>
 #include <tuple>
 #include <utility>
 
 #include "Exception.hpp"
+#include "LightningDiagonalObs.hpp"
 #include "Types.h"
 #include "Utils.hpp"
 
@@ -40,12 +42,38 @@ namespace Catalyst::Runtime::Simulator {
  * @brief The LightningObsManager caches observables of a program at runtime
  * and maps each one to a const unique index (`int64_t`) in the scope
  * of the global context manager.
+ *
+ * The observables diagonal in the computational basis are also kept in their
+ * diagonal form, for their evaluation from the probabilities of the state.
  */
 template <typename PrecisionT> class LightningObsManager {
   private:
     using VectorStateT = StateVectorLQubitDynamic<PrecisionT>;
     using ObservablePairType = std::pair<std::shared_ptr<Observable<VectorStateT>>, ObsType>;
     std::vector<ObservablePairType> observables_{};
+    std::vector<std::optional<DiagonalObs<PrecisionT>>> diagonals_{};
+
+    /**
+     * @brief Get the product or the weighted sum of the diagonal forms of
+     * observables, if they are all diagonal.
+     */
+    template <typename CombineT>
+    [[nodiscard]] auto combineDiagonals(const std::vector<ObsIdType> &obsKeys,
+                                        CombineT &&combine) const
+        -> std::optional<DiagonalObs<PrecisionT>>
+    {
+        if (!isValidObservables(obsKeys) ||
+            !std::all_of(obsKeys.begin(), obsKeys.end(),
+                         [this](auto key) { return diagonals_[key].has_value(); })) {
+            return std::nullopt;
+        }
+
+        std::optional<DiagonalObs<PrecisionT>> result;
+        for (size_t idx = 0; idx < obsKeys.size(); idx++) {
+            combine(result, idx, *diagonals_[obsKeys[idx]]);
+        }
+        return result;
+    }
 
   public:
     LightningObsManager() = default;
@@ -59,7 +87,11 @@ template <typename PrecisionT> class LightningObsManager {
     /**
      * @brief A helper function to clear constructed observables in the program.
      */
-    void clear() { observables_.clear(); }
+    void clear()
+    {
+        observables_.clear();
+        diagonals_.clear();
+    }
 
     /**
      * @brief Check the validity of observable keys.
@@ -93,6 +125,20 @@ template <typename PrecisionT> class LightningObsManager {
      */
     [[nodiscard]] auto numObservables() const -> size_t { return observables_.size(); }
 
+    /**
+     * @brief Get the diagonal form of an observable, if it is diagonal in the
+     * computational basis.
+     *
+     * @param key The observable key
+     * @return const std::optional<DiagonalObs<PrecisionT>> &
+     */
+    [[nodiscard]] auto getDiagonalObservable(ObsIdType key) const
+        -> const std::optional<DiagonalObs<PrecisionT>> &
+    {
+        RT_FAIL_IF(!isValidObservables({key}), "Invalid observable key");
+        return diagonals_[key];
+    }
+
     /**
      * @brief Create and cache a new NamedObs instance.
      *
@@ -108,6 +154,14 @@ template <typename PrecisionT> class LightningObsManager {
 
         observables_.push_back(std::make_pair(
             std::make_shared<NamedObs<VectorStateT>>(obs_str, wires), ObsType::Basic));
+
+        std::optional<DiagonalObs<PrecisionT>> diagonal;
+        if (obsId == ObsId::Identity || obsId == ObsId::PauliZ) {
+            diagonal.emplace();
+            diagonal->terms.push_back(
+                {1, obsId == ObsId::PauliZ ? wires : std::vector<size_t>{}, {}});
+        }
+        diagonals_.push_back(std::move(diagonal));
         return static_cast<ObsIdType>(observables_.size() - 1);
     }
 
@@ -125,6 +179,28 @@ template <typename PrecisionT> class LightningObsManager {
             std::make_shared<HermitianObs<VectorStateT>>(HermitianObs<VectorStateT>{matrix, wires}),
             ObsType::Basic));
 
+        // A matrix without off-diagonal entries is kept as its diagonal
+        const size_t dim = size_t{1} << wires.size();
+        std::optional<DiagonalObs<PrecisionT>> diagonal;
+        if (matrix.size() == dim * dim) {
+            std::vector<PrecisionT> entries(dim);
+            bool is_diagonal = true;
+            for (size_t row = 0; row < dim && is_diagonal; row++) {
+                for (size_t col = 0; col < dim; col++) {
+                    if (row != col && matrix[row * dim + col] != std::complex<PrecisionT>{0}) {
+                        is_diagonal = false;
+                        break;
+                    }
+                }
+                entries[row] = std::real(matrix[row * dim + row]);
+            }
+            if (is_diagonal) {
+                diagonal.emplace();
+                diagonal->terms.push_back({1, {}, {{wires, std::move(entries)}}});
+            }
+        }
+        diagonals_.push_back(std::move(diagonal));
+
         return static_cast<ObsIdType>(observables_.size() - 1);
     }
 
@@ -151,6 +227,10 @@ template <typename PrecisionT> class LightningObsManager {
 
         observables_.push_back(
             std::make_pair(TensorProdObs<VectorStateT>::create(obs_vec), ObsType::TensorProd));
+        diagonals_.push_back(
+            combineDiagonals(obsKeys, [](auto &result, size_t, const auto &factor) {
+                result = result ? DiagonalObs<PrecisionT>::product(*result, factor) : factor;
+            }));
 
         return static_cast<ObsIdType>(obs_size);
     }
@@ -187,6 +267,13 @@ template <typename PrecisionT> class LightningObsManager {
                 Pennylane::LightningQubit::Observables::Hamiltonian<VectorStateT>(
                     coeffs, std::move(obs_vec))),
             ObsType::Hamiltonian));
+        diagonals_.push_back(combineDiagonals(
+            obsKeys, [&coeffs](auto &result, size_t idx, const auto &term) {
+                if (!result) {
+                    result.emplace();
+                }
+                result->add(coeffs[idx], term);
+            }));
 
         return static_cast<ObsIdType>(obs_size);
     }
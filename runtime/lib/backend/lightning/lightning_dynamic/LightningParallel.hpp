@@ -0,0 +1,86 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace Catalyst::Runtime::Simulator {
+
+/**
+ * @brief Get the position of the bit of a basis-state index that holds the
+ * value of a wire.
+ *
+ * Lightning wire 0 is the most significant bit of a basis-state index.
+ */
+constexpr auto wireToBit(size_t num_qubits, size_t wire) -> size_t { return num_qubits - 1 - wire; }
+
+/**
+ * @brief Get the value of a wire in a basis-state index.
+ */
+constexpr auto getWireBit(size_t index, size_t num_qubits, size_t wire) -> size_t
+{
+    return (index >> wireToBit(num_qubits, wire)) & 1U;
+}
+
+/**
+ * @brief Get the number of threads to run on, all cores if `num_threads` is 0.
+ */
+inline auto getNumThreads(size_t num_threads) -> size_t
+{
+    return num_threads ? num_threads : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+/**
+ * @brief Run `worker(worker_id)` for each worker id below `num_workers`, the
+ * worker 0 on the calling thread and each other one on its own thread.
+ *
+ * The first exception thrown by a worker is rethrown once all the workers are
+ * joined.
+ */
+template <typename WorkerT> void parallelFor(size_t num_workers, WorkerT &&worker)
+{
+    std::vector<std::exception_ptr> errors(num_workers);
+    auto run = [&](size_t worker_id) {
+        try {
+            worker(worker_id);
+        }
+        catch (...) {
+            errors[worker_id] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_workers > 0 ? num_workers - 1 : 0);
+    for (size_t worker_id = 1; worker_id < num_workers; worker_id++) {
+        threads.emplace_back(run, worker_id);
+    }
+    if (num_workers > 0) {
+        run(0);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (const auto &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+} // namespace Catalyst::Runtime::Simulator
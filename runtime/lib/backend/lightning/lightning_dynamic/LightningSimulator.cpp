@@ -19,11 +19,96 @@
 #include "LinearAlgebra.hpp"
 #include "MeasurementsLQubit.hpp"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace Catalyst::Runtime::Simulator {
 
+void LightningSimulator::setNumThreads()
+{
+    // The multithreaded Lightning kernels run on the persistent OpenMP thread team
+#ifdef _OPENMP
+    if (this->num_threads) {
+        omp_set_num_threads(static_cast<int>(this->num_threads));
+    }
+#endif
+}
+
+auto LightningSimulator::getNumWorkers() const -> size_t
+{
+    if (!this->IsMultithreaded()) {
+        return 1;
+    }
+    return getNumThreads(this->num_threads);
+}
+
+void LightningSimulator::updateThreading()
+{
+    // Switching the kernels copies the state-vector, once per crossing of the threshold
+    const ThreadingT threading = getThreading(this->GetNumQubits());
+    if (this->device_sv->threading() != threading) {
+        this->device_sv = std::make_unique<StateVectorT>(this->device_sv->getData(),
+                                                         this->device_sv->getLength(), threading);
+    }
+}
+
+void LightningSimulator::applyQueuedGate(const QueuedGate &gate)
+{
+    auto kernel = gate.kernel ? gate.kernel
+                              : this->kernel_profile.getKernel(*this->device_sv, gate.name,
+                                                               gate.wires, gate.params);
+    if (kernel) {
+        this->device_sv->applyOperation(*kernel, gate.name, gate.wires, gate.inverse, gate.params);
+    }
+    else {
+        this->device_sv->applyOperation(gate.name, gate.wires, gate.inverse, gate.params);
+    }
+}
+
+void LightningSimulator::queueGate(QueuedGate &&gate)
+{
+    // The gate is validated now rather than when the queue is flushed, so that an invalid gate
+    // fails at the operation that applies it
+    auto &&[op_num_wires, op_num_params] =
+        Lightning::lookup_gates(Lightning::simulator_gate_info, gate.name);
+    RT_FAIL_IF(gate.wires.empty() || (op_num_wires && gate.wires.size() != op_num_wires),
+               "Invalid number of qubits");
+    RT_FAIL_IF(gate.params.size() != op_num_params, "Invalid number of parameters");
+    const size_t num_qubits = this->GetNumQubits();
+    RT_FAIL_IF(std::any_of(gate.wires.begin(), gate.wires.end(),
+                           [num_qubits](size_t wire) { return wire >= num_qubits; }) ||
+                   std::set<size_t>(gate.wires.begin(), gate.wires.end()).size() !=
+                       gate.wires.size(),
+               "Invalid given wires");
+    RT_FAIL_IF(gate.kernel && !LightningKernelProfile<double>::implements(*gate.kernel, gate.name),
+               "The kernel does not implement the gate");
+
+    this->gate_queue.push_back(std::move(gate));
+    if (this->gate_queue.size() >= max_queued_gates) {
+        flushGates();
+    }
+}
+
+void LightningSimulator::flushGates()
+{
+    if (this->gate_queue.empty()) {
+        return;
+    }
+
+    // The queue is emptied first, so that a failing gate does not leave it applied twice
+    std::vector<QueuedGate> gates;
+    std::swap(gates, this->gate_queue);
+    applyGatesBlocked(this->device_sv->getData(), this->GetNumQubits(), gates, this->block_qubits,
+                      getNumWorkers(), [this](const QueuedGate &gate) { applyQueuedGate(gate); });
+}
+
 auto LightningSimulator::AllocateQubit() -> QubitIdType
 {
+    flushGates();
+    this->state_version++;
     size_t sv_id = this->device_sv->allocateWire();
+    updateThreading();
     return this->qubit_manager.Allocate(sv_id);
 }
 
@@ -33,9 +118,15 @@ auto LightningSimulator::AllocateQubits(size_t num_qubits) -> std::vector<QubitI
         return {};
     }
 
+    flushGates();
+
     // at the first call when num_qubits == 0
     if (this->GetNumQubits() == 0U) {
-        this->device_sv = std::make_unique<StateVectorT>(num_qubits);
+        // The OpenMP thread count is a setting of the calling thread, and a pooled or
+        // prefetched device may have been constructed on another thread
+        setNumThreads();
+        this->state_version++;
+        this->device_sv = std::make_unique<StateVectorT>(num_qubits, getThreading(num_qubits));
         return this->qubit_manager.AllocateRange(0, num_qubits);
     }
 
@@ -46,14 +137,20 @@ auto LightningSimulator::AllocateQubits(size_t num_qubits) -> std::vector<QubitI
 
 void LightningSimulator::ReleaseAllQubits()
 {
+    this->state_version++;
+    this->gate_queue.clear();
     this->device_sv->clearData();
+    updateThreading();
     this->qubit_manager.ReleaseAll();
 }
 
 void LightningSimulator::ReleaseQubit(QubitIdType q)
 {
     if (this->qubit_manager.isValidQubitId(q)) {
+        flushGates();
+        this->state_version++;
         this->device_sv->releaseWire(this->qubit_manager.getDeviceId(q));
+        updateThreading();
     }
     this->qubit_manager.Release(q);
 }
@@ -81,7 +178,12 @@ auto LightningSimulator::CacheManagerInfo()
             this->cache_manager.getObservablesKeys()};
 }
 
-void LightningSimulator::SetDeviceShots(size_t shots) { this->device_shots = shots; }
+void LightningSimulator::SetDeviceShots(size_t shots)
+{
+    // Results estimated from samples depend on the number of shots
+    this->state_version++;
+    this->device_shots = shots;
+}
 
 auto LightningSimulator::GetDeviceShots() const -> size_t { return this->device_shots; }
 
@@ -90,6 +192,8 @@ void LightningSimulator::PrintState()
     using std::cout;
     using std::endl;
 
+    flushGates();
+
     const size_t num_qubits = this->device_sv->getNumQubits();
     const size_t size = Pennylane::Util::exp2(num_qubits);
     size_t idx = 0;
@@ -126,13 +230,28 @@ void LightningSimulator::NamedOperation(const std::string &name, const std::vect
     // Convert wires to device wires
     auto &&dev_wires = getDeviceWires(wires);
 
-    // Update the state-vector
-    this->device_sv->applyOperation(name, dev_wires, inverse, params);
+    // Update the state-vector, with the kernel of the machine profile if there is one, or queue
+    // the gate for its blocked application to large states
+    this->state_version++;
+    if (isBlocking()) {
+        queueGate({name, dev_wires, inverse, params,
+                   this->kernel_profile.getKernel(*this->device_sv, name, dev_wires, params)});
+    }
+    else if (auto kernel =
+                 this->kernel_profile.getKernel(*this->device_sv, name, dev_wires, params)) {
+        this->device_sv->applyOperation(*kernel, name, dev_wires, inverse, params);
+    }
+    else {
+        this->device_sv->applyOperation(name, dev_wires, inverse, params);
+    }
 
     // Update tape caching if required
     if (this->tape_recording) {
         this->cache_manager.addOperation(name, params, dev_wires, inverse);
     }
+    if (this->template_id.has_value()) {
+        this->template_cache.addOperation(name, params, dev_wires, inverse);
+    }
 }
 
 void LightningSimulator::MatrixOperation(const std::vector<std::complex<double>> &matrix,
@@ -143,7 +262,119 @@ void LightningSimulator::MatrixOperation(const std::vector<std::complex<double>>
     auto &&dev_wires = getDeviceWires(wires);
 
     // Update the state-vector
+    flushGates();
+    this->state_version++;
     this->device_sv->applyMatrix(matrix.data(), dev_wires, inverse);
+
+    // Templates only hold named gates
+    this->template_replayable = false;
+}
+
+void LightningSimulator::QFT(const std::vector<QubitIdType> &wires, bool inverse)
+{
+    // The adjoint-Jacobian tape and templates only hold named gates
+    if (this->tape_recording || this->template_id.has_value()) {
+        QuantumDevice::QFT(wires, inverse);
+        return;
+    }
+
+    auto &&dev_wires = getDeviceWires(wires);
+    flushGates();
+    this->state_version++;
+    applyQFT(this->device_sv->getData(), this->GetNumQubits(), dev_wires, inverse);
+}
+
+void LightningSimulator::ReflectUniform(const std::vector<QubitIdType> &wires, bool inverse)
+{
+    // The adjoint-Jacobian tape and templates only hold named gates
+    if (this->tape_recording || this->template_id.has_value()) {
+        QuantumDevice::ReflectUniform(wires, inverse);
+        return;
+    }
+
+    auto &&dev_wires = getDeviceWires(wires);
+    flushGates();
+    this->state_version++;
+    applyReflectUniform(this->device_sv->getData(), this->GetNumQubits(), dev_wires);
+}
+
+void LightningSimulator::StartTemplateRecording(int64_t id)
+{
+    RT_FAIL_IF(this->template_id.has_value(), "Cannot re-activate the template recorder");
+    this->template_id = id;
+    this->template_replayable = true;
+    this->template_cache.Reset();
+}
+
+void LightningSimulator::StopTemplateRecording()
+{
+    RT_FAIL_IF(!this->template_id.has_value(), "Cannot stop an already stopped template recorder");
+    const int64_t id = *this->template_id;
+    this->template_id.reset();
+
+    // Circuits with matrices or mid-circuit measurements are always executed
+    if (!this->template_replayable) {
+        this->templates.erase(id);
+        return;
+    }
+
+    auto &&ops_names = this->template_cache.getOperationsNames();
+    auto &&ops_params = this->template_cache.getOperationsParameters();
+    auto &&ops_wires = this->template_cache.getOperationsWires();
+    auto &&ops_inverses = this->template_cache.getOperationsInverses();
+    const size_t num_ops = ops_names.size();
+
+    GateTemplate gate_template{this->GetNumQubits(), ops_names, ops_wires, ops_inverses, {0}, {}};
+    gate_template.offsets.reserve(num_ops + 1);
+    gate_template.kernels.reserve(num_ops);
+    for (size_t idx = 0; idx < num_ops; idx++) {
+        gate_template.offsets.push_back(gate_template.offsets.back() + ops_params[idx].size());
+        // Decode the kernel of each gate once, instead of at every replay
+        gate_template.kernels.push_back(this->kernel_profile.getKernel(
+            *this->device_sv, ops_names[idx], ops_wires[idx], ops_params[idx]));
+    }
+
+    this->templates.insert_or_assign(id, std::move(gate_template));
+}
+
+auto LightningSimulator::Replay(int64_t id, const std::vector<double> &params) -> bool
+{
+    // A template recorded on a different number of qubits or parameters must be recorded again
+    auto iter = this->templates.find(id);
+    if (iter == this->templates.end() || iter->second.num_qubits != this->GetNumQubits() ||
+        iter->second.offsets.back() != params.size()) {
+        return false;
+    }
+
+    const GateTemplate &gate_template = iter->second;
+    this->state_version++;
+    std::vector<double> gate_params;
+    for (size_t idx = 0; idx < gate_template.names.size(); idx++) {
+        const auto &name = gate_template.names[idx];
+        const auto &dev_wires = gate_template.wires[idx];
+        const bool inverse = gate_template.inverses[idx];
+        gate_params.assign(params.begin() + gate_template.offsets[idx],
+                           params.begin() + gate_template.offsets[idx + 1]);
+
+        if (isBlocking()) {
+            queueGate({name, dev_wires, inverse, gate_params, gate_template.kernels[idx]});
+        }
+        else if (auto &&kernel = gate_template.kernels[idx]) {
+            this->device_sv->applyOperation(*kernel, name, dev_wires, inverse, gate_params);
+        }
+        else {
+            this->device_sv->applyOperation(name, dev_wires, inverse, gate_params);
+        }
+
+        if (this->tape_recording) {
+            this->cache_manager.addOperation(name, gate_params, dev_wires, inverse);
+        }
+        if (this->template_id.has_value()) {
+            this->template_cache.addOperation(name, gate_params, dev_wires, inverse);
+        }
+    }
+
+    return true;
 }
 
 auto LightningSimulator::Observable(ObsId id, const std::vector<std::complex<double>> &matrix,
@@ -183,9 +414,19 @@ auto LightningSimulator::Expval(ObsIdType obsKey) -> double
         this->cache_manager.addObservable(obsKey, MeasurementsT::Expval);
     }
 
-    Pennylane::LightningQubit::Measures::Measurements<StateVectorT> m{*(this->device_sv)};
-
-    return device_shots ? m.expval(*obs, device_shots, {}) : m.expval(*obs);
+    flushGates();
+    this->measurement_cache.sync(this->state_version);
+    return this->measurement_cache.getExpval(obsKey, [&]() {
+        // Diagonal observables are evaluated from the probabilities, in a single read-only pass
+        auto &&diagonal = this->obs_manager.getDiagonalObservable(obsKey);
+        if (diagonal && !device_shots) {
+            return computeDiagonalMoments(this->device_sv->getData(), this->GetNumQubits(),
+                                          *diagonal, getNumWorkers())
+                .first;
+        }
+        Pennylane::LightningQubit::Measures::Measurements<StateVectorT> m{*(this->device_sv)};
+        return device_shots ? m.expval(*obs, device_shots, {}) : m.expval(*obs);
+    });
 }
 
 auto LightningSimulator::Var(ObsIdType obsKey) -> double
@@ -199,13 +440,23 @@ auto LightningSimulator::Var(ObsIdType obsKey) -> double
         this->cache_manager.addObservable(obsKey, MeasurementsT::Var);
     }
 
-    Pennylane::LightningQubit::Measures::Measurements<StateVectorT> m{*(this->device_sv)};
-
-    return device_shots ? m.var(*obs, device_shots) : m.var(*obs);
+    flushGates();
+    this->measurement_cache.sync(this->state_version);
+    return this->measurement_cache.getVar(obsKey, [&]() {
+        auto &&diagonal = this->obs_manager.getDiagonalObservable(obsKey);
+        if (diagonal && !device_shots) {
+            auto &&[mean, square] = computeDiagonalMoments(
+                this->device_sv->getData(), this->GetNumQubits(), *diagonal, getNumWorkers());
+            return std::max(square - mean * mean, 0.0);
+        }
+        Pennylane::LightningQubit::Measures::Measurements<StateVectorT> m{*(this->device_sv)};
+        return device_shots ? m.var(*obs, device_shots) : m.var(*obs);
+    });
 }
 
 void LightningSimulator::State(DataView<std::complex<double>, 1> &state)
 {
+    flushGates();
     auto &&dv_state = this->device_sv->getDataVector();
     RT_FAIL_IF(state.size() != dv_state.size(), "Invalid size for the pre-allocated state vector");
 
@@ -214,12 +465,20 @@ void LightningSimulator::State(DataView<std::complex<double>, 1> &state)
 
 void LightningSimulator::Probs(DataView<double, 1> &probs)
 {
-    Pennylane::LightningQubit::Measures::Measurements<StateVectorT> m{*(this->device_sv)};
-    auto &&dv_probs = device_shots ? m.probs(device_shots) : m.probs();
+    const size_t numQubits = this->GetNumQubits();
+    std::vector<size_t> dev_wires(numQubits);
+    std::iota(dev_wires.begin(), dev_wires.end(), 0);
+
+    flushGates();
+    this->measurement_cache.sync(this->state_version);
+    auto &&dv_probs = this->measurement_cache.getProbs(dev_wires, numQubits, [&]() {
+        Pennylane::LightningQubit::Measures::Measurements<StateVectorT> m{*(this->device_sv)};
+        return device_shots ? m.probs(device_shots) : m.probs();
+    });
 
     RT_FAIL_IF(probs.size() != dv_probs.size(), "Invalid size for the pre-allocated probabilities");
 
-    std::move(dv_probs.begin(), dv_probs.end(), probs.begin());
+    std::copy(dv_probs.begin(), dv_probs.end(), probs.begin());
 }
 
 void LightningSimulator::PartialProbs(DataView<double, 1> &probs,
@@ -232,28 +491,44 @@ void LightningSimulator::PartialProbs(DataView<double, 1> &probs,
     RT_FAIL_IF(!isValidQubits(wires), "Invalid given wires to measure");
 
     auto dev_wires = getDeviceWires(wires);
-    Pennylane::LightningQubit::Measures::Measurements<StateVectorT> m{*(this->device_sv)};
-    auto &&dv_probs = device_shots ? m.probs(dev_wires, device_shots) : m.probs(dev_wires);
+
+    // Partial probabilities are marginalized from the cached probabilities of all qubits, if any
+    flushGates();
+    this->measurement_cache.sync(this->state_version);
+    auto &&dv_probs = this->measurement_cache.getProbs(dev_wires, numQubits, [&]() {
+        if (!device_shots) {
+            // A single sweep of the amplitudes, without the distribution over all qubits
+            return computeMarginalProbs(this->device_sv->getData(), numQubits, dev_wires,
+                                        getNumWorkers());
+        }
+        Pennylane::LightningQubit::Measures::Measurements<StateVectorT> m{*(this->device_sv)};
+        return m.probs(dev_wires, device_shots);
+    });
 
     RT_FAIL_IF(probs.size() != dv_probs.size(),
                "Invalid size for the pre-allocated partial-probabilities");
 
-    std::move(dv_probs.begin(), dv_probs.end(), probs.begin());
+    std::copy(dv_probs.begin(), dv_probs.end(), probs.begin());
 }
 
 std::vector<size_t> LightningSimulator::GenerateSamplesMetropolis(size_t shots)
 {
-    // generate_samples_metropolis is a member function of the Measures class.
-    Pennylane::LightningQubit::Measures::Measurements<StateVectorT> m{*(this->device_sv)};
+    // The samples are layed out as a single vector of size shots*qubits, where
+    // each element represents a single bit. Each Markov chain writes the rows of
+    // its shots in place.
+    flushGates();
+    const size_t num_qubits = this->GetNumQubits();
+    std::vector<size_t> samples(shots * num_qubits);
+
+    std::random_device rd;
+    LightningMetropolisSampler<double> sampler(
+        this->device_sv->getData(), num_qubits,
+        {this->kernel_name, this->num_burnin, this->num_chains, this->thinning,
+         (static_cast<uint64_t>(rd()) << 32) | rd()}); // tidy: readability-magic-numbers
+    this->acceptance_rate = sampler.sample(samples, getNumWorkers());
 
-    // PL-Lightning generates samples using the alias method.
-    // Reference: https://en.wikipedia.org/wiki/Alias_method
-    // Given the number of samples, returns 1-D vector of samples
-    // in binary, each sample is separated by a stride equal to
-    // the number of qubits.
-    //
     // Return Value Optimization (RVO)
-    return m.generate_samples_metropolis(this->kernel_name, this->num_burnin, shots);
+    return samples;
 }
 
 std::vector<size_t> LightningSimulator::GenerateSamples(size_t shots)
@@ -261,6 +536,7 @@ std::vector<size_t> LightningSimulator::GenerateSamples(size_t shots)
     if (this->mcmc) {
         return this->GenerateSamplesMetropolis(shots);
     }
+    flushGates();
     // generate_samples is a member function of the Measures class.
     Pennylane::LightningQubit::Measures::Measurements<StateVectorT> m{*(this->device_sv)};
 
@@ -274,9 +550,16 @@ std::vector<size_t> LightningSimulator::GenerateSamples(size_t shots)
     return m.generate_samples(shots);
 }
 
+auto LightningSimulator::getCachedSamples(size_t shots) -> const std::vector<size_t> &
+{
+    this->measurement_cache.sync(this->state_version);
+    return this->measurement_cache.getSamples(shots,
+                                              [&]() { return this->GenerateSamples(shots); });
+}
+
 void LightningSimulator::Sample(DataView<double, 2> &samples, size_t shots)
 {
-    auto li_samples = this->GenerateSamples(shots);
+    auto &&li_samples = this->getCachedSamples(shots);
 
     RT_FAIL_IF(samples.size() != li_samples.size(), "Invalid size for the pre-allocated samples");
 
@@ -308,7 +591,7 @@ void LightningSimulator::PartialSample(DataView<double, 2> &samples,
     // get device wires
     auto &&dev_wires = getDeviceWires(wires);
 
-    auto li_samples = this->GenerateSamples(shots);
+    auto &&li_samples = this->getCachedSamples(shots);
 
     // The lightning samples are layed out as a single vector of size
     // shots*qubits, where each element represents a single bit. The
@@ -331,7 +614,7 @@ void LightningSimulator::Counts(DataView<double, 1> &eigvals, DataView<int64_t,
     RT_FAIL_IF(eigvals.size() != numElements || counts.size() != numElements,
                "Invalid size for the pre-allocated counts");
 
-    auto li_samples = this->GenerateSamples(shots);
+    auto &&li_samples = this->getCachedSamples(shots);
 
     // Fill the eigenvalues with the integer representation of the corresponding
     // computational basis bitstring. In the future, eigenvalues can also be
@@ -369,7 +652,7 @@ void LightningSimulator::PartialCounts(DataView<double, 1> &eigvals, DataView<in
     // get device wires
     auto &&dev_wires = getDeviceWires(wires);
 
-    auto li_samples = this->GenerateSamples(shots);
+    auto &&li_samples = this->getCachedSamples(shots);
 
     // Fill the eigenvalues with the integer representation of the corresponding
     // computational basis bitstring. In the future, eigenvalues can also be
@@ -394,6 +677,9 @@ void LightningSimulator::PartialCounts(DataView<double, 1> &eigvals, DataView<in
 
 auto LightningSimulator::Measure(QubitIdType wire) -> Result
 {
+    // The gates following a mid-circuit measurement may depend on its outcome
+    this->template_replayable = false;
+
     // get a measurement
     std::vector<QubitIdType> wires = {reinterpret_cast<QubitIdType>(wire)};
 
@@ -409,6 +695,8 @@ auto LightningSimulator::Measure(QubitIdType wire) -> Result
 
     const size_t numQubits = this->GetNumQubits();
 
+    flushGates();
+    this->state_version++;
     auto &&state = this->device_sv->getDataVector();
 
     auto &&dev_wires = this->getDeviceWires(wires);
@@ -467,6 +755,7 @@ void LightningSimulator::Gradient(std::vector<DataView<double, 1>> &gradients,
                "Unsupported measurements to compute gradient; "
                "Adjoint differentiation method only supports expectation return type");
 
+    flushGates();
     auto &&state = this->device_sv->getDataVector();
 
     // create OpsData
@@ -16,28 +16,42 @@
 
 #define __device_lightning
 
+#include <algorithm>
 #include <bitset>
 #include <cmath>
 #include <cstdint>
 #include <iostream>
 #include <limits>
 #include <numeric>
+#include <optional>
 #include <random>
+#include <set>
 #include <span>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
 
 #include "StateVectorLQubitDynamic.hpp"
 
 #include "CacheManager.hpp"
 #include "Exception.hpp"
+#include "LightningBlockedGates.hpp"
+#include "LightningKernelProfile.hpp"
+#include "LightningMarginalProbs.hpp"
+#include "LightningMeasurementCache.hpp"
+#include "LightningMetropolisSampler.hpp"
 #include "LightningObsManager.hpp"
+#include "LightningParallel.hpp"
 #include "QuantumDevice.hpp"
 #include "QubitManager.hpp"
+#include "StructuredGateKernels.hpp"
 #include "Utils.hpp"
 
 namespace Catalyst::Runtime::Simulator {
 class LightningSimulator final : public Catalyst::Runtime::QuantumDevice {
   private:
     using StateVectorT = Pennylane::LightningQubit::StateVectorLQubitDynamic<double>;
+    using ThreadingT = std::remove_cvref_t<decltype(std::declval<StateVectorT>().threading())>;
 
     // static constants for RESULT values
     static constexpr bool GLOBAL_RESULT_TRUE_CONST = true;
@@ -46,18 +60,69 @@ class LightningSimulator final : public Catalyst::Runtime::QuantumDevice {
     static constexpr size_t default_num_burnin{100}; // tidy: readability-magic-numbers
     static constexpr std::string_view default_kernel_name{
         "Local"}; // tidy: readability-magic-numbers
+    static constexpr size_t default_multithreading_threshold{20}; // tidy: readability-magic-numbers
+    // Blocks of 2^14 amplitudes (256 KiB) fit in the L2 cache
+    static constexpr size_t default_block_qubits{14};       // tidy: readability-magic-numbers
+    static constexpr size_t default_blocking_threshold{24}; // tidy: readability-magic-numbers
+    static constexpr size_t max_queued_gates{256};          // tidy: readability-magic-numbers
 
     Catalyst::Runtime::QubitManager<QubitIdType, size_t> qubit_manager{};
     Catalyst::Runtime::CacheManager cache_manager{};
     bool tape_recording{false};
     size_t device_shots;
 
+    // A gate sequence recorded once, and replayed with new gate parameters
+    // without the dispatch of each gate through the QIR runtime.
+    struct GateTemplate {
+        size_t num_qubits;
+        std::vector<std::string> names;
+        std::vector<std::vector<size_t>> wires;
+        std::vector<bool> inverses;
+        // The parameters of gate `i` are params[offsets[i]:offsets[i + 1]]
+        std::vector<size_t> offsets;
+        std::vector<std::optional<Pennylane::Gates::KernelType>> kernels;
+    };
+
+    // A named gate whose application is deferred to the next access to the state-vector
+    struct QueuedGate {
+        std::string name;
+        std::vector<size_t> wires;
+        bool inverse;
+        std::vector<double> params;
+        std::optional<Pennylane::Gates::KernelType> kernel;
+    };
+
+    // States of at least `blocking_threshold` qubits queue the named gates, and
+    // apply them in segments to blocks of `2^block_qubits` amplitudes
+    std::vector<QueuedGate> gate_queue{};
+    size_t block_qubits{default_block_qubits};
+    size_t blocking_threshold{default_blocking_threshold};
+
+    std::unordered_map<int64_t, GateTemplate> templates{};
+    Catalyst::Runtime::CacheManager template_cache{};
+    std::optional<int64_t> template_id{};
+    bool template_replayable{false};
+
     bool mcmc{false};
     size_t num_burnin{0};
     std::string kernel_name;
+    size_t num_chains{1};
+    size_t thinning{1};
+    double acceptance_rate{0};
+
+    // States of at least `multithreading_threshold` qubits use the multithreaded
+    // kernels, with `num_threads` threads or all cores if zero
+    size_t num_threads{0};
+    size_t multithreading_threshold{default_multithreading_threshold};
 
     std::unique_ptr<StateVectorT> device_sv = std::make_unique<StateVectorT>(0);
     LightningObsManager<double> obs_manager{};
+    LightningKernelProfile<double> kernel_profile{};
+
+    // Incremented on any change of the state-vector, to invalidate the cached
+    // results of measurement processes
+    size_t state_version{0};
+    LightningMeasurementCache measurement_cache{};
 
     inline auto isValidQubit(QubitIdType wire) -> bool
     {
@@ -85,6 +150,27 @@ class LightningSimulator final : public Catalyst::Runtime::QuantumDevice {
         return res;
     }
 
+    auto getCachedSamples(size_t shots) -> const std::vector<size_t> &;
+
+    [[nodiscard]] auto getThreading(size_t num_qubits) const -> ThreadingT
+    {
+        return num_qubits < this->multithreading_threshold ? ThreadingT::SingleThread
+                                                           : ThreadingT::MultiThread;
+    }
+    [[nodiscard]] auto getNumWorkers() const -> size_t;
+    void updateThreading();
+
+    void setNumThreads();
+
+    [[nodiscard]] auto isBlocking() const -> bool
+    {
+        const size_t num_qubits = this->GetNumQubits();
+        return num_qubits >= this->blocking_threshold && num_qubits > this->block_qubits;
+    }
+    void applyQueuedGate(const QueuedGate &gate);
+    void queueGate(QueuedGate &&gate);
+    void flushGates();
+
   public:
     explicit LightningSimulator(const std::string &kwargs = "{}")
     {
@@ -95,6 +181,38 @@ class LightningSimulator final : public Catalyst::Runtime::QuantumDevice {
                          ? static_cast<size_t>(std::stoll(args["num_burnin"]))
                          : default_num_burnin;
         kernel_name = args.contains("kernel_name") ? args["kernel_name"] : default_kernel_name;
+        num_chains =
+            args.contains("num_chains") ? static_cast<size_t>(std::stoll(args["num_chains"])) : 1;
+        thinning =
+            args.contains("thinning") ? static_cast<size_t>(std::stoll(args["thinning"])) : 1;
+        num_threads = args.contains("num_threads")
+                          ? static_cast<size_t>(std::stoll(args["num_threads"]))
+                          : 0;
+        // The concurrent shot batches of a dynamic circuit share the cores
+        const size_t shot_batches =
+            args.contains("shot_batches") ? static_cast<size_t>(std::stoll(args["shot_batches"]))
+                                          : 1;
+        if (!num_threads && shot_batches > 1) {
+            num_threads = std::max<size_t>(std::thread::hardware_concurrency() / shot_batches, 1);
+        }
+        multithreading_threshold =
+            args.contains("multithreading_threshold")
+                ? static_cast<size_t>(std::stoll(args["multithreading_threshold"]))
+                : default_multithreading_threshold;
+        setNumThreads();
+        block_qubits = args.contains("block_qubits")
+                           ? static_cast<size_t>(std::stoll(args["block_qubits"]))
+                           : default_block_qubits;
+        blocking_threshold = args.contains("blocking_threshold")
+                                 ? static_cast<size_t>(std::stoll(args["blocking_threshold"]))
+                                 : default_blocking_threshold;
+        RT_FAIL_IF(!block_qubits, "Invalid number of block qubits");
+
+        const bool autotune = args.contains("autotune") ? args["autotune"] == "True" : false;
+        const std::string profile_path =
+            args.contains("kernel_profile") ? args["kernel_profile"]
+                                            : LightningKernelProfile<double>::getDefaultPath();
+        kernel_profile = LightningKernelProfile<double>(profile_path, autotune);
     }
     ~LightningSimulator() override = default;
 
@@ -103,9 +221,22 @@ class LightningSimulator final : public Catalyst::Runtime::QuantumDevice {
     QUANTUM_DEVICE_RT_DECLARATIONS;
     QUANTUM_DEVICE_QIS_DECLARATIONS;
 
+    void QFT(const std::vector<QubitIdType> &wires, bool inverse) override;
+    void ReflectUniform(const std::vector<QubitIdType> &wires, bool inverse) override;
+
+    void StartTemplateRecording(int64_t id) override;
+    void StopTemplateRecording() override;
+    auto Replay(int64_t id, const std::vector<double> &params) -> bool override;
+
     auto CacheManagerInfo()
         -> std::tuple<size_t, size_t, size_t, std::vector<std::string>, std::vector<ObsIdType>>;
     auto GenerateSamplesMetropolis(size_t shots) -> std::vector<size_t>;
+    [[nodiscard]] auto GetAcceptanceRate() const -> double { return this->acceptance_rate; }
+    [[nodiscard]] auto GetStateVersion() const -> size_t { return this->state_version; }
+    [[nodiscard]] auto IsMultithreaded() const -> bool
+    {
+        return this->device_sv->threading() == ThreadingT::MultiThread;
+    }
     auto GenerateSamples(size_t shots) -> std::vector<size_t>;
 };
 } // namespace Catalyst::Runtime::Simulator
@@ -0,0 +1,564 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "LightningTrajectorySimulator.hpp"
+
+#include <bitset>
+#include <iostream>
+#include <numeric>
+
+#include "LightningParallel.hpp"
+#include "MeasurementsLQubit.hpp"
+
+namespace Catalyst::Runtime::Simulator {
+
+LightningTrajectorySimulator::LightningTrajectorySimulator(const std::string &kwargs)
+{
+    auto &&args = Catalyst::Runtime::parse_kwargs(kwargs);
+    device_shots = args.contains("shots") ? static_cast<size_t>(std::stoll(args["shots"])) : 0;
+    num_trajectories = args.contains("num_trajectories")
+                           ? static_cast<size_t>(std::stoll(args["num_trajectories"]))
+                           : default_num_trajectories;
+    depolarizing = args.contains("depolarizing") ? std::stod(args["depolarizing"]) : 0;
+    amplitude_damping =
+        args.contains("amplitude_damping") ? std::stod(args["amplitude_damping"]) : 0;
+    readout_error = args.contains("readout_error") ? std::stod(args["readout_error"]) : 0;
+    num_threads =
+        args.contains("num_threads") ? static_cast<size_t>(std::stoll(args["num_threads"])) : 0;
+    trajectory_memory = args.contains("trajectory_memory")
+                            ? static_cast<size_t>(std::stoll(args["trajectory_memory"]))
+                            : default_trajectory_memory;
+    if (args.contains("seed")) {
+        fixed_seed = static_cast<uint64_t>(std::stoull(args["seed"]));
+    }
+
+    RT_FAIL_IF(!num_trajectories, "Invalid number of trajectories");
+    for (double prob : {depolarizing, amplitude_damping, readout_error}) {
+        RT_FAIL_IF(prob < 0 || prob > 1, "Invalid probability of a noise channel");
+    }
+
+    resetExecution();
+}
+
+void LightningTrajectorySimulator::resetExecution()
+{
+    this->ops.clear();
+    clearTrajectories();
+
+    // The trajectories of an execution are drawn again by each measurement process
+    // from the same seed, so that all of its results are consistent.
+    if (this->fixed_seed.has_value()) {
+        this->seed = *this->fixed_seed;
+    }
+    else {
+        std::random_device rd;
+        this->seed = (static_cast<uint64_t>(rd()) << 32) | rd(); // tidy: readability-magic-numbers
+    }
+    this->rng.seed(this->seed);
+}
+
+void LightningTrajectorySimulator::clearTrajectories()
+{
+    this->trajectories.clear();
+    this->num_applied_ops = 0;
+}
+
+auto LightningTrajectorySimulator::getNumWorkers(bool cached) const -> size_t
+{
+    const size_t num_workers = getNumThreads(this->num_threads);
+    if (cached) {
+        return std::min(this->num_trajectories, num_workers);
+    }
+
+    // Each worker simulates its trajectories on its own state-vector
+    const size_t state_bytes = sizeof(std::complex<double>) << this->num_qubits;
+    const size_t max_workers = std::max<size_t>(this->trajectory_memory / state_bytes, 1);
+    return std::min({this->num_trajectories, num_workers, max_workers});
+}
+
+auto LightningTrajectorySimulator::advanceTrajectory(StateVectorT &sv, CounterRNG &rng,
+                                                     double weight, size_t first_op) const
+    -> double
+{
+    for (size_t idx = first_op; idx < this->ops.size(); idx++) {
+        const auto &op = this->ops[idx];
+        switch (op.kind) {
+        case TrajectoryOp::Kind::Gate:
+            sv.applyOperation(op.name, op.wires, op.inverse, op.params);
+            break;
+        case TrajectoryOp::Kind::Matrix:
+            sv.applyMatrix(op.matrix.data(), op.wires, op.inverse);
+            break;
+        case TrajectoryOp::Kind::Projection:
+            weight *= projectWire(sv.getData(), this->num_qubits, op.wires[0], op.outcome);
+            if (weight == 0) {
+                return 0;
+            }
+            continue;
+        }
+
+        for (auto wire : op.wires) {
+            if (this->depolarizing > 0) {
+                applyDepolarizing(sv.getData(), this->num_qubits, wire, this->depolarizing, rng);
+            }
+            if (this->amplitude_damping > 0) {
+                applyAmplitudeDamping(sv.getData(), this->num_qubits, wire,
+                                      this->amplitude_damping, rng);
+            }
+        }
+    }
+    return weight;
+}
+
+auto LightningTrajectorySimulator::runTrajectory(StateVectorT &sv, size_t trajectory) const
+    -> double
+{
+    auto &&state = sv.getDataVector();
+    std::fill(state.begin(), state.end(), std::complex<double>{0, 0});
+    state[0] = 1;
+
+    CounterRNG trajectory_rng(this->seed, trajectory);
+    return advanceTrajectory(sv, trajectory_rng, 1, 0);
+}
+
+auto LightningTrajectorySimulator::averageTrajectories(size_t num_results,
+                                                       const TrajectoryMeasure &measure)
+    -> std::vector<double>
+{
+    // The trajectories are kept when all of their states fit in the memory budget, and
+    // are then only advanced by the operations recorded since the last measurement process.
+    // Both paths draw the same random stream for each trajectory.
+    const size_t state_bytes = sizeof(std::complex<double>) << this->num_qubits;
+    const bool cached = this->trajectory_memory / state_bytes >= this->num_trajectories;
+    if (cached && this->trajectories.empty()) {
+        this->trajectories.reserve(this->num_trajectories);
+        for (size_t trajectory = 0; trajectory < this->num_trajectories; trajectory++) {
+            StateVectorT sv(this->num_qubits);
+            sv.getDataVector()[0] = 1;
+            this->trajectories.push_back({std::move(sv), CounterRNG(this->seed, trajectory), 1});
+        }
+    }
+
+    // Each worker sums the weighted results of its trajectories separately from the other
+    // workers.
+    const size_t num_workers = getNumWorkers(cached);
+    std::vector<std::vector<double>> sums(num_workers, std::vector<double>(num_results, 0));
+    std::vector<double> weights(num_workers, 0);
+
+    parallelFor(num_workers, [&](size_t worker_id) {
+        std::optional<StateVectorT> scratch_sv{};
+        if (!cached) {
+            scratch_sv.emplace(this->num_qubits);
+        }
+        std::vector<double> results(num_results);
+        for (size_t trajectory = worker_id; trajectory < this->num_trajectories;
+             trajectory += num_workers) {
+            StateVectorT *sv = nullptr;
+            double weight = 0;
+            if (cached) {
+                auto &cached_trajectory = this->trajectories[trajectory];
+                if (cached_trajectory.weight != 0) {
+                    cached_trajectory.weight =
+                        advanceTrajectory(cached_trajectory.sv, cached_trajectory.rng,
+                                          cached_trajectory.weight, this->num_applied_ops);
+                }
+                sv = &cached_trajectory.sv;
+                weight = cached_trajectory.weight;
+            }
+            else {
+                sv = &*scratch_sv;
+                weight = runTrajectory(*sv, trajectory);
+            }
+            if (weight == 0) {
+                continue;
+            }
+            measure(*sv, results);
+            for (size_t idx = 0; idx < num_results; idx++) {
+                sums[worker_id][idx] += weight * results[idx];
+            }
+            weights[worker_id] += weight;
+        }
+    });
+    if (cached) {
+        this->num_applied_ops = this->ops.size();
+    }
+
+    const double total_weight = std::accumulate(weights.begin(), weights.end(), 0.0);
+    RT_FAIL_IF(total_weight == 0, "No trajectory is consistent with the mid-circuit measurements");
+
+    std::vector<double> averages(num_results, 0);
+    for (const auto &worker_sums : sums) {
+        for (size_t idx = 0; idx < num_results; idx++) {
+            averages[idx] += worker_sums[idx] / total_weight;
+        }
+    }
+    return averages;
+}
+
+auto LightningTrajectorySimulator::averageProbs(const std::vector<size_t> &dev_wires)
+    -> std::vector<double>
+{
+    auto measure = [&dev_wires](StateVectorT &sv, std::span<double> results) {
+        Pennylane::LightningQubit::Measures::Measurements<StateVectorT> m{sv};
+        auto &&sv_probs = m.probs(dev_wires);
+        std::copy(sv_probs.begin(), sv_probs.end(), results.begin());
+    };
+
+    auto &&probs = averageTrajectories(size_t{1} << dev_wires.size(), measure);
+    applyReadoutError(probs, dev_wires.size(), this->readout_error);
+    return probs;
+}
+
+auto LightningTrajectorySimulator::AllocateQubit() -> QubitIdType
+{
+    // The kept trajectories are simulated again on the new number of qubits
+    clearTrajectories();
+    return this->qubit_manager.Allocate(this->num_qubits++);
+}
+
+auto LightningTrajectorySimulator::AllocateQubits(size_t num_qubits) -> std::vector<QubitIdType>
+{
+    if (num_qubits == 0U) {
+        return {};
+    }
+
+    std::vector<QubitIdType> result(num_qubits);
+    std::generate_n(result.begin(), num_qubits, [this]() { return AllocateQubit(); });
+    return result;
+}
+
+void LightningTrajectorySimulator::ReleaseAllQubits()
+{
+    this->num_qubits = 0;
+    this->qubit_manager.ReleaseAll();
+    resetExecution();
+}
+
+void LightningTrajectorySimulator::ReleaseQubit(QubitIdType q)
+{
+    // The wire of a released qubit stays in the recorded circuit
+    this->qubit_manager.Release(q);
+}
+
+auto LightningTrajectorySimulator::GetNumQubits() const -> size_t { return this->num_qubits; }
+
+void LightningTrajectorySimulator::StartTapeRecording() { RT_FAIL("Unsupported functionality"); }
+
+void LightningTrajectorySimulator::StopTapeRecording() { RT_FAIL("Unsupported functionality"); }
+
+void LightningTrajectorySimulator::SetDeviceShots(size_t shots) { this->device_shots = shots; }
+
+auto LightningTrajectorySimulator::GetDeviceShots() const -> size_t { return this->device_shots; }
+
+void LightningTrajectorySimulator::PrintState()
+{
+    using std::cout;
+    using std::endl;
+
+    std::vector<size_t> dev_wires(this->num_qubits);
+    std::iota(dev_wires.begin(), dev_wires.end(), 0);
+    auto &&probs = averageProbs(dev_wires);
+
+    size_t idx = 0;
+    cout << "*** Trajectory-Averaged Probabilities of Size " << probs.size() << " ***" << endl;
+    cout << "[";
+    for (; idx < probs.size() - 1; idx++) {
+        cout << probs[idx] << ", ";
+    }
+    cout << probs[idx] << "]" << endl;
+}
+
+auto LightningTrajectorySimulator::Zero() const -> Result
+{
+    return const_cast<Result>(&GLOBAL_RESULT_FALSE_CONST);
+}
+
+auto LightningTrajectorySimulator::One() const -> Result
+{
+    return const_cast<Result>(&GLOBAL_RESULT_TRUE_CONST);
+}
+
+void LightningTrajectorySimulator::NamedOperation(const std::string &name,
+                                                  const std::vector<double> &params,
+                                                  const std::vector<QubitIdType> &wires,
+                                                  bool inverse)
+{
+    // First, check if operation `name` is supported by the simulator
+    auto &&[op_num_wires, op_num_params] =
+        Lightning::lookup_gates(Lightning::simulator_gate_info, name);
+
+    // Check the validity of number of qubits and parameters
+    RT_FAIL_IF((!wires.size() && wires.size() != op_num_wires), "Invalid number of qubits");
+    RT_FAIL_IF(params.size() != op_num_params, "Invalid number of parameters");
+    RT_FAIL_IF(!isValidQubits(wires), "Invalid given wires");
+
+    this->ops.push_back(
+        {TrajectoryOp::Kind::Gate, name, params, getDeviceWires(wires), inverse, {}, false});
+}
+
+void LightningTrajectorySimulator::MatrixOperation(const std::vector<std::complex<double>> &matrix,
+                                                   const std::vector<QubitIdType> &wires,
+                                                   bool inverse)
+{
+    RT_FAIL_IF(!isValidQubits(wires), "Invalid given wires");
+    RT_FAIL_IF(matrix.size() != (size_t{1} << (2 * wires.size())), "Invalid size of the matrix");
+
+    this->ops.push_back(
+        {TrajectoryOp::Kind::Matrix, {}, {}, getDeviceWires(wires), inverse, matrix, false});
+}
+
+auto LightningTrajectorySimulator::Observable(ObsId id,
+                                              const std::vector<std::complex<double>> &matrix,
+                                              const std::vector<QubitIdType> &wires) -> ObsIdType
+{
+    RT_FAIL_IF(wires.size() > this->GetNumQubits(), "Invalid number of wires");
+    RT_FAIL_IF(!isValidQubits(wires), "Invalid given wires");
+
+    auto &&dev_wires = getDeviceWires(wires);
+
+    if (id == ObsId::Hermitian) {
+        return this->obs_manager.createHermitianObs(matrix, dev_wires);
+    }
+
+    return this->obs_manager.createNamedObs(id, dev_wires);
+}
+
+auto LightningTrajectorySimulator::TensorObservable(const std::vector<ObsIdType> &obs)
+    -> ObsIdType
+{
+    return this->obs_manager.createTensorProdObs(obs);
+}
+
+auto LightningTrajectorySimulator::HamiltonianObservable(const std::vector<double> &coeffs,
+                                                         const std::vector<ObsIdType> &obs)
+    -> ObsIdType
+{
+    return this->obs_manager.createHamiltonianObs(coeffs, obs);
+}
+
+auto LightningTrajectorySimulator::Expval(ObsIdType obsKey) -> double
+{
+    RT_FAIL_IF(!this->obs_manager.isValidObservables({obsKey}),
+               "Invalid key for cached observables");
+    auto &&obs = this->obs_manager.getObservable(obsKey);
+
+    auto &&expval = averageTrajectories(1, [&obs](StateVectorT &sv, std::span<double> results) {
+        Pennylane::LightningQubit::Measures::Measurements<StateVectorT> m{sv};
+        results[0] = m.expval(*obs);
+    });
+    return expval[0];
+}
+
+auto LightningTrajectorySimulator::Var(ObsIdType obsKey) -> double
+{
+    RT_FAIL_IF(!this->obs_manager.isValidObservables({obsKey}),
+               "Invalid key for cached observables");
+    auto &&obs = this->obs_manager.getObservable(obsKey);
+
+    // The variance on the mixed state is E[<O^2>] - E[<O>]^2 over the trajectories
+    auto &&moments = averageTrajectories(2, [&obs](StateVectorT &sv, std::span<double> results) {
+        Pennylane::LightningQubit::Measures::Measurements<StateVectorT> m{sv};
+        const double expval = m.expval(*obs);
+        results[0] = expval;
+        results[1] = m.var(*obs) + expval * expval;
+    });
+    return moments[1] - moments[0] * moments[0];
+}
+
+void LightningTrajectorySimulator::State(DataView<std::complex<double>, 1> &)
+{
+    // The state of a noisy circuit is mixed
+    RT_FAIL("Unsupported functionality");
+}
+
+void LightningTrajectorySimulator::Probs(DataView<double, 1> &probs)
+{
+    std::vector<size_t> dev_wires(this->num_qubits);
+    std::iota(dev_wires.begin(), dev_wires.end(), 0);
+    auto &&dv_probs = averageProbs(dev_wires);
+
+    RT_FAIL_IF(probs.size() != dv_probs.size(), "Invalid size for the pre-allocated probabilities");
+
+    std::move(dv_probs.begin(), dv_probs.end(), probs.begin());
+}
+
+void LightningTrajectorySimulator::PartialProbs(DataView<double, 1> &probs,
+                                                const std::vector<QubitIdType> &wires)
+{
+    const size_t numWires = wires.size();
+    const size_t numQubits = this->GetNumQubits();
+
+    RT_FAIL_IF(numWires > numQubits, "Invalid number of wires");
+    RT_FAIL_IF(!isValidQubits(wires), "Invalid given wires to measure");
+
+    auto &&dv_probs = averageProbs(getDeviceWires(wires));
+
+    RT_FAIL_IF(probs.size() != dv_probs.size(),
+               "Invalid size for the pre-allocated partial-probabilities");
+
+    std::move(dv_probs.begin(), dv_probs.end(), probs.begin());
+}
+
+std::vector<size_t> LightningTrajectorySimulator::GenerateSamples(size_t shots)
+{
+    // Each shot is an independent trajectory, so that drawing the shots from the
+    // averaged probabilities, including the readout error, samples the noisy circuit.
+    const size_t numQubits = this->GetNumQubits();
+    std::vector<size_t> dev_wires(numQubits);
+    std::iota(dev_wires.begin(), dev_wires.end(), 0);
+    auto &&probs = averageProbs(dev_wires);
+
+    // The samples are layed out as a single vector of size shots*qubits, where
+    // each element represents a single bit.
+    std::vector<size_t> samples(shots * numQubits);
+    std::discrete_distribution<size_t> distribution(probs.begin(), probs.end());
+    for (size_t shot = 0; shot < shots; shot++) {
+        const size_t basis_state = distribution(this->rng);
+        for (size_t wire = 0; wire < numQubits; wire++) {
+            samples[shot * numQubits + wire] = getWireBit(basis_state, numQubits, wire);
+        }
+    }
+
+    // Return Value Optimization (RVO)
+    return samples;
+}
+
+void LightningTrajectorySimulator::Sample(DataView<double, 2> &samples, size_t shots)
+{
+    auto li_samples = this->GenerateSamples(shots);
+
+    RT_FAIL_IF(samples.size() != li_samples.size(), "Invalid size for the pre-allocated samples");
+
+    const size_t numQubits = this->GetNumQubits();
+
+    auto samplesIter = samples.begin();
+    for (size_t shot = 0; shot < shots; shot++) {
+        for (size_t wire = 0; wire < numQubits; wire++) {
+            *(samplesIter++) = static_cast<double>(li_samples[shot * numQubits + wire]);
+        }
+    }
+}
+
+void LightningTrajectorySimulator::PartialSample(DataView<double, 2> &samples,
+                                                 const std::vector<QubitIdType> &wires,
+                                                 size_t shots)
+{
+    const size_t numWires = wires.size();
+    const size_t numQubits = this->GetNumQubits();
+
+    RT_FAIL_IF(numWires > numQubits, "Invalid number of wires");
+    RT_FAIL_IF(!isValidQubits(wires), "Invalid given wires to measure");
+    RT_FAIL_IF(samples.size() != shots * numWires,
+               "Invalid size for the pre-allocated partial-samples");
+
+    // get device wires
+    auto &&dev_wires = getDeviceWires(wires);
+
+    auto li_samples = this->GenerateSamples(shots);
+
+    auto samplesIter = samples.begin();
+    for (size_t shot = 0; shot < shots; shot++) {
+        for (auto wire : dev_wires) {
+            *(samplesIter++) = static_cast<double>(li_samples[shot * numQubits + wire]);
+        }
+    }
+}
+
+void LightningTrajectorySimulator::Counts(DataView<double, 1> &eigvals,
+                                          DataView<int64_t, 1> &counts, size_t shots)
+{
+    const size_t numQubits = this->GetNumQubits();
+    const size_t numElements = 1U << numQubits;
+
+    RT_FAIL_IF(eigvals.size() != numElements || counts.size() != numElements,
+               "Invalid size for the pre-allocated counts");
+
+    auto li_samples = this->GenerateSamples(shots);
+
+    std::iota(eigvals.begin(), eigvals.end(), 0);
+    std::fill(counts.begin(), counts.end(), 0);
+
+    for (size_t shot = 0; shot < shots; shot++) {
+        std::bitset<CHAR_BIT * sizeof(double)> basisState;
+        size_t idx = 0;
+        for (size_t wire = 0; wire < numQubits; wire++) {
+            basisState[idx++] = li_samples[shot * numQubits + wire];
+        }
+        counts(static_cast<size_t>(basisState.to_ulong())) += 1;
+    }
+}
+
+void LightningTrajectorySimulator::PartialCounts(DataView<double, 1> &eigvals,
+                                                 DataView<int64_t, 1> &counts,
+                                                 const std::vector<QubitIdType> &wires,
+                                                 size_t shots)
+{
+    const size_t numWires = wires.size();
+    const size_t numQubits = this->GetNumQubits();
+    const size_t numElements = 1U << numWires;
+
+    RT_FAIL_IF(numWires > numQubits, "Invalid number of wires");
+    RT_FAIL_IF(!isValidQubits(wires), "Invalid given wires to measure");
+    RT_FAIL_IF((eigvals.size() != numElements || counts.size() != numElements),
+               "Invalid size for the pre-allocated partial-counts");
+
+    // get device wires
+    auto &&dev_wires = getDeviceWires(wires);
+
+    auto li_samples = this->GenerateSamples(shots);
+
+    std::iota(eigvals.begin(), eigvals.end(), 0);
+    std::fill(counts.begin(), counts.end(), 0);
+
+    for (size_t shot = 0; shot < shots; shot++) {
+        std::bitset<CHAR_BIT * sizeof(double)> basisState;
+        size_t idx = 0;
+        for (auto wire : dev_wires) {
+            basisState[idx++] = li_samples[shot * numQubits + wire];
+        }
+        counts(static_cast<size_t>(basisState.to_ulong())) += 1;
+    }
+}
+
+auto LightningTrajectorySimulator::Measure(QubitIdType wire) -> Result
+{
+    RT_FAIL_IF(!isValidQubit(wire), "Invalid given wires to measure");
+    const size_t dev_wire = this->qubit_manager.getDeviceId(wire);
+
+    // Draw the outcome from the probability averaged over the trajectories, and
+    // project the following trajectories onto it
+    auto &&prob = averageTrajectories(1, [this, dev_wire](StateVectorT &sv,
+                                                          std::span<double> results) {
+        results[0] = getWireProbability(sv.getData(), this->num_qubits, dev_wire);
+    });
+
+    std::uniform_real_distribution<double> dis(0., 1.);
+    const bool outcome = dis(this->rng) < prob[0];
+    this->ops.push_back({TrajectoryOp::Kind::Projection, {}, {}, {dev_wire}, false, {}, outcome});
+
+    // The readout error only changes the reported outcome
+    const bool flipped = dis(this->rng) < this->readout_error;
+    return (outcome != flipped) ? this->One() : this->Zero();
+}
+
+void LightningTrajectorySimulator::Gradient(std::vector<DataView<double, 1>> &,
+                                            const std::vector<size_t> &)
+{
+    RT_FAIL("Unsupported functionality");
+}
+
+} // namespace Catalyst::Runtime::Simulator
+
+GENERATE_DEVICE_FACTORY(LightningTrajectorySimulator,
+                        Catalyst::Runtime::Simulator::LightningTrajectorySimulator);
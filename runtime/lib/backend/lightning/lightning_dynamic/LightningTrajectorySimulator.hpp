@@ -0,0 +1,156 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <complex>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "StateVectorLQubitDynamic.hpp"
+
+#include "Exception.hpp"
+#include "LightningMetropolisSampler.hpp"
+#include "LightningNoiseChannels.hpp"
+#include "LightningObsManager.hpp"
+#include "QuantumDevice.hpp"
+#include "QubitManager.hpp"
+#include "Utils.hpp"
+
+namespace Catalyst::Runtime::Simulator {
+
+/**
+ * A noisy simulator of quantum trajectories.
+ *
+ * The operations of an execution are recorded, and each measurement process
+ * runs `num_trajectories` independent trajectories of the circuit on pure
+ * states. After every gate, the depolarizing and amplitude damping channels
+ * configured in the device kwargs are applied to each of its wires as a
+ * stochastic jump. Trajectories run in parallel, each with its own random
+ * stream, and their results are averaged. The readout error is applied to the
+ * averaged computational-basis probabilities, and to mid-circuit measurements.
+ *
+ * All measurement processes of an execution share the same trajectories. A
+ * mid-circuit measurement projects every trajectory onto its outcome, and the
+ * following results are weighted by the probability of this outcome in each
+ * trajectory.
+ *
+ * When the states of all trajectories fit in `trajectory_memory` bytes, they
+ * are kept between measurement processes and only advanced by the operations
+ * recorded since the last one. Otherwise, each measurement process simulates
+ * the trajectories again, with at most `num_threads` workers (all cores if
+ * zero) whose state-vectors fit in this budget.
+ */
+class LightningTrajectorySimulator final : public Catalyst::Runtime::QuantumDevice {
+  private:
+    using StateVectorT = Pennylane::LightningQubit::StateVectorLQubitDynamic<double>;
+
+    // static constants for RESULT values
+    static constexpr bool GLOBAL_RESULT_TRUE_CONST = true;
+    static constexpr bool GLOBAL_RESULT_FALSE_CONST = false;
+
+    static constexpr size_t default_num_trajectories{1000}; // tidy: readability-magic-numbers
+    static constexpr size_t default_trajectory_memory{size_t{1} << 28}; // 256 MiB
+
+    // An operation of the recorded circuit
+    struct TrajectoryOp {
+        enum class Kind { Gate, Matrix, Projection };
+        Kind kind;
+        std::string name{};
+        std::vector<double> params{};
+        std::vector<size_t> wires{};
+        bool inverse{false};
+        std::vector<std::complex<double>> matrix{};
+        // The outcome of a projection
+        bool outcome{false};
+    };
+
+    // A trajectory advanced up to the first `num_applied_ops` recorded operations
+    struct Trajectory {
+        StateVectorT sv;
+        CounterRNG rng;
+        double weight{1};
+    };
+
+    // Compute the results of a trajectory from its final state
+    using TrajectoryMeasure = std::function<void(StateVectorT &, std::span<double>)>;
+
+    Catalyst::Runtime::QubitManager<QubitIdType, size_t> qubit_manager{};
+    size_t num_qubits{0};
+    size_t device_shots;
+
+    size_t num_trajectories;
+    size_t num_threads{0};
+    size_t trajectory_memory{default_trajectory_memory};
+    double depolarizing;
+    double amplitude_damping;
+    double readout_error;
+
+    std::optional<uint64_t> fixed_seed{};
+    uint64_t seed{0};
+    std::mt19937_64 rng{};
+
+    std::vector<TrajectoryOp> ops{};
+    LightningObsManager<double> obs_manager{};
+
+    std::vector<Trajectory> trajectories{};
+    size_t num_applied_ops{0};
+
+    inline auto isValidQubit(QubitIdType wire) -> bool
+    {
+        return this->qubit_manager.isValidQubitId(wire);
+    }
+
+    inline auto isValidQubits(const std::vector<QubitIdType> &wires) -> bool
+    {
+        return std::all_of(wires.begin(), wires.end(),
+                           [this](QubitIdType w) { return this->isValidQubit(w); });
+    }
+
+    inline auto getDeviceWires(const std::vector<QubitIdType> &wires) -> std::vector<size_t>
+    {
+        std::vector<size_t> res;
+        res.reserve(wires.size());
+        std::transform(wires.begin(), wires.end(), std::back_inserter(res),
+                       [this](auto w) { return this->qubit_manager.getDeviceId(w); });
+        return res;
+    }
+
+    void resetExecution();
+    void clearTrajectories();
+    [[nodiscard]] auto getNumWorkers(bool cached) const -> size_t;
+    auto advanceTrajectory(StateVectorT &sv, CounterRNG &rng, double weight,
+                           size_t first_op) const -> double;
+    auto runTrajectory(StateVectorT &sv, size_t trajectory) const -> double;
+    auto averageTrajectories(size_t num_results, const TrajectoryMeasure &measure)
+        -> std::vector<double>;
+    auto averageProbs(const std::vector<size_t> &dev_wires) -> std::vector<double>;
+
+  public:
+    explicit LightningTrajectorySimulator(const std::string &kwargs = "{}");
+    ~LightningTrajectorySimulator() override = default;
+
+    QUANTUM_DEVICE_DEL_DECLARATIONS(LightningTrajectorySimulator);
+
+    QUANTUM_DEVICE_RT_DECLARATIONS;
+    QUANTUM_DEVICE_QIS_DECLARATIONS;
+
+    auto GenerateSamples(size_t shots) -> std::vector<size_t>;
+};
+} // namespace Catalyst::Runtime::Simulator
@@ -0,0 +1,161 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+#include "Exception.hpp"
+#include "LightningParallel.hpp"
+
+namespace Catalyst::Runtime::Simulator {
+
+/**
+ * @brief Visit the sub-vectors of a state-vector spanned by a set of wires.
+ *
+ * For every assignment of the remaining wires, the visitor is called with the
+ * index of the sub-vector's first amplitude. The offsets of the sub-vector's
+ * amplitudes, with the first wire as the most significant bit of the
+ * sub-index, are computed once.
+ *
+ * @param num_qubits Number of qubits of the state-vector
+ * @param wires Device wires spanning the sub-vectors
+ * @param visitor Callable taking the base index and the vector of offsets
+ */
+template <typename VisitorT>
+void forEachSubvector(size_t num_qubits, const std::vector<size_t> &wires, VisitorT &&visitor)
+{
+    const size_t num_wires = wires.size();
+    RT_FAIL_IF(num_wires > num_qubits, "Invalid number of wires");
+
+    std::vector<size_t> bits(num_wires);
+    std::transform(wires.begin(), wires.end(), bits.begin(),
+                   [num_qubits](size_t wire) { return wireToBit(num_qubits, wire); });
+
+    const size_t dim = 1UL << num_wires;
+    std::vector<size_t> offsets(dim, 0);
+    for (size_t k = 0; k < dim; k++) {
+        for (size_t t = 0; t < num_wires; t++) {
+            if ((k >> (num_wires - 1 - t)) & 1UL) {
+                offsets[k] |= 1UL << bits[t];
+            }
+        }
+    }
+
+    std::vector<size_t> sorted_bits{bits};
+    std::sort(sorted_bits.begin(), sorted_bits.end());
+
+    const size_t num_blocks = 1UL << (num_qubits - num_wires);
+    for (size_t block = 0; block < num_blocks; block++) {
+        // Insert zero bits at the positions of the wires.
+        size_t base = block;
+        for (auto bit : sorted_bits) {
+            const size_t low = base & ((1UL << bit) - 1);
+            base = ((base >> bit) << (bit + 1)) | low;
+        }
+        visitor(base, offsets);
+    }
+}
+
+/**
+ * @brief Apply the quantum Fourier transform to a set of wires of a
+ * state-vector, as an in-place radix-2 FFT over each sub-vector.
+ *
+ * @param data The amplitudes of the state-vector
+ * @param num_qubits Number of qubits of the state-vector
+ * @param wires Device wires, the first one being the most significant bit
+ * @param inverse Indicates whether to apply the inverse transform
+ */
+template <typename PrecisionT>
+void applyQFT(std::complex<PrecisionT> *data, size_t num_qubits, const std::vector<size_t> &wires,
+              bool inverse)
+{
+    using ComplexT = std::complex<PrecisionT>;
+
+    const size_t num_wires = wires.size();
+    const size_t dim = 1UL << num_wires;
+    const PrecisionT sign = inverse ? -1 : 1;
+    const PrecisionT scale = 1 / std::sqrt(static_cast<PrecisionT>(dim));
+
+    // Twiddle factors exp(sign * 2 pi i k / dim) for k < dim / 2.
+    std::vector<ComplexT> twiddles(dim / 2);
+    for (size_t k = 0; k < dim / 2; k++) {
+        const PrecisionT angle = sign * 2 * std::numbers::pi_v<PrecisionT> *
+                                 static_cast<PrecisionT>(k) / static_cast<PrecisionT>(dim);
+        twiddles[k] = std::polar(PrecisionT{1}, angle);
+    }
+
+    std::vector<ComplexT> buffer(dim);
+    forEachSubvector(num_qubits, wires, [&](size_t base, const std::vector<size_t> &offsets) {
+        // Gather the sub-vector in bit-reversed order.
+        for (size_t k = 0; k < dim; k++) {
+            size_t rev = 0;
+            for (size_t t = 0; t < num_wires; t++) {
+                rev |= ((k >> t) & 1UL) << (num_wires - 1 - t);
+            }
+            buffer[rev] = data[base + offsets[k]];
+        }
+
+        for (size_t len = 2; len <= dim; len <<= 1) {
+            const size_t half = len / 2;
+            const size_t stride = dim / len;
+            for (size_t start = 0; start < dim; start += len) {
+                for (size_t k = 0; k < half; k++) {
+                    const ComplexT even = buffer[start + k];
+                    const ComplexT odd = buffer[start + k + half] * twiddles[k * stride];
+                    buffer[start + k] = even + odd;
+                    buffer[start + k + half] = even - odd;
+                }
+            }
+        }
+
+        for (size_t k = 0; k < dim; k++) {
+            data[base + offsets[k]] = buffer[k] * scale;
+        }
+    });
+}
+
+/**
+ * @brief Apply the reflection `I - 2|s><s|` about the uniform superposition of
+ * a set of wires of a state-vector, which subtracts twice the mean amplitude
+ * of each sub-vector.
+ *
+ * @param data The amplitudes of the state-vector
+ * @param num_qubits Number of qubits of the state-vector
+ * @param wires Device wires
+ */
+template <typename PrecisionT>
+void applyReflectUniform(std::complex<PrecisionT> *data, size_t num_qubits,
+                         const std::vector<size_t> &wires)
+{
+    using ComplexT = std::complex<PrecisionT>;
+
+    const size_t dim = 1UL << wires.size();
+    forEachSubvector(num_qubits, wires, [&](size_t base, const std::vector<size_t> &offsets) {
+        ComplexT sum{0};
+        for (auto offset : offsets) {
+            sum += data[base + offset];
+        }
+        const ComplexT shift = sum * (PrecisionT{2} / static_cast<PrecisionT>(dim));
+        for (auto offset : offsets) {
+            data[base + offset] -= shift;
+        }
+    });
+}
+} // namespace Catalyst::Runtime::Simulator
@@ -22,6 +22,7 @@
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -36,6 +37,7 @@ enum class BuilderType : uint8_t {
     Common, // = 0
     BraketRemote,
     BraketLocal,
+    Native,
 };
 
 /**
@@ -620,6 +622,11 @@ class QasmHamiltonianObs final : public QasmObs {
  * @note Only one user-specified quantum register is currently supported.
  * @note User-specified measurement results registers are supported.
  *
+ * In parametric mode, the parameter values of gates are bound to `input float`
+ * variables instead of being serialized into the program, so that the program text
+ * does not change with the parameters and the values are passed per execution.
+ *
+ * @param vars Input variables
  * @param qregs Quantum registers
  * @param bregs Measurement results registers
  * @param gates Quantum gates
@@ -635,10 +642,51 @@ class OpenQasmBuilder {
     size_t num_qubits;
     size_t num_bits;
 
+    bool parametric{false};
+    std::unordered_map<std::string, double> inputs{};
+
+    // The serialized gates, extended with the gates added since the last serialization
+    mutable std::string gates_cache{};
+    mutable size_t gates_cache_size{0};
+    mutable size_t gates_cache_precision{0};
+    mutable std::string gates_cache_version{};
+
+    [[nodiscard]] auto serializeGates(size_t precision, const std::string &version) const
+        -> const std::string &
+    {
+        RT_ASSERT(!qregs.empty());
+
+        if (precision != gates_cache_precision || version != gates_cache_version) {
+            gates_cache.clear();
+            gates_cache_size = 0;
+            gates_cache_precision = precision;
+            gates_cache_version = version;
+        }
+
+        for (; gates_cache_size < gates.size(); gates_cache_size++) {
+            gates_cache += gates[gates_cache_size].toOpenQasm(qregs[0], precision, version);
+        }
+        return gates_cache;
+    }
+
   public:
     explicit OpenQasmBuilder() : num_qubits(0), num_bits(0) {}
     virtual ~OpenQasmBuilder() = default;
 
+    /**
+     * @brief Bind the parameter values of the gates added from now on to input variables.
+     */
+    void setParametric(bool _parametric) { parametric = _parametric; }
+    [[nodiscard]] auto isParametric() const -> bool { return parametric; }
+
+    /**
+     * @brief Get the values of the input variables bound to gate parameters.
+     */
+    [[nodiscard]] auto getInputs() const -> const std::unordered_map<std::string, double> &
+    {
+        return inputs;
+    }
+
     [[nodiscard]] auto getNumQubits() const -> size_t { return num_qubits; }
     [[nodiscard]] auto getNumBits() const -> size_t { return num_bits; }
     [[nodiscard]] auto getQubits() const -> std::vector<QasmRegister> { return qregs; }
@@ -647,6 +695,9 @@ class OpenQasmBuilder {
     {
         switch (type) {
         case RegisterType::Qubit:
+            // gates are serialized with the first quantum register
+            gates_cache_size = 0;
+            gates_cache.clear();
             qregs.emplace_back(type, name, size);
             num_qubits += size;
             break;
@@ -663,6 +714,18 @@ class OpenQasmBuilder {
               const std::vector<std::string> &params_str, const std::vector<size_t> &wires,
               [[maybe_unused]] bool inverse)
     {
+        if (parametric && !params_val.empty()) {
+            std::vector<std::string> names;
+            names.reserve(params_val.size());
+            for (auto value : params_val) {
+                auto &&param = "param_" + std::to_string(inputs.size());
+                inputs.emplace(param, value);
+                names.push_back(param);
+            }
+            Gate(name, {}, names, wires, inverse);
+            return;
+        }
+
         gates.emplace_back(name, params_val, params_str, wires, inverse);
 
         for (auto &param : params_str) {
@@ -707,9 +770,7 @@ class OpenQasmBuilder {
         }
 
         // quantum gates assuming qregs.size() == 1
-        for (auto &gate : gates) {
-            oss << gate.toOpenQasm(qregs[0], precision);
-        }
+        oss << serializeGates(precision, version);
 
         // quantum measures assuming qregs.size() == 1, bregs.size() <= 1
         for (auto &m : measures) {
@@ -781,9 +842,7 @@ class BraketBuilder : public OpenQasmBuilder {
         oss << braket_mresults.toOpenQasm(RegisterMode::Alloc, {}, version);
 
         // quantum gates assuming qregs.size() == 1
-        for (auto &gate : gates) {
-            oss << gate.toOpenQasm(qregs[0], precision, version);
-        }
+        oss << serializeGates(precision, version);
 
         // quantum measures assuming bregs[0].size() == qregs[0].size()
         // and "mresults" isn't a user-specified register.
@@ -811,13 +870,16 @@ class BraketBuilder : public OpenQasmBuilder {
         // header
         oss << "OPENQASM " << version << ";\n";
 
+        // variables
+        for (auto &var : vars) {
+            oss << var.toOpenQasm();
+        }
+
         // quantum registers
         oss << qregs[0].toOpenQasm(RegisterMode::Alloc, {}, version);
 
         // quantum gates assuming qregs.size() == 1
-        for (auto &gate : gates) {
-            oss << gate.toOpenQasm(qregs[0], precision, version);
-        }
+        oss << serializeGates(precision, version);
 
         oss << serialized_instructions;
 
@@ -31,7 +31,7 @@ auto OpenQasmDevice::AllocateQubits(size_t num_qubits) -> std::vector<QubitIdTyp
     const size_t cur_num_qubits = builder->getNumQubits();
     const size_t new_num_qubits = cur_num_qubits + num_qubits;
     if (cur_num_qubits) {
-        builder = std::make_unique<OpenQasm::OpenQasmBuilder>();
+        builder = makeBuilder();
     }
 
     builder->Register(OpenQasm::RegisterType::Qubit, "qubits", new_num_qubits);
@@ -41,13 +41,10 @@ auto OpenQasmDevice::AllocateQubits(size_t num_qubits) -> std::vector<QubitIdTyp
 
 void OpenQasmDevice::ReleaseAllQubits()
 {
+    measurement_batch.reset();
+
     // refresh the builder for device re-use.
-    if (builder_type != OpenQasm::BuilderType::Common) {
-        builder = std::make_unique<OpenQasm::BraketBuilder>();
-    }
-    else {
-        builder = std::make_unique<OpenQasm::OpenQasmBuilder>();
-    }
+    builder = makeBuilder();
 }
 
 void OpenQasmDevice::ReleaseQubit([[maybe_unused]] QubitIdType q)
@@ -176,21 +173,15 @@ auto OpenQasmDevice::HamiltonianObservable([[maybe_unused]] const std::vector<do
     return obs_manager.createHamiltonianObs(coeffs, obs);
 }
 
-auto OpenQasmDevice::Expval([[maybe_unused]] ObsIdType obsKey) -> double
+void OpenQasmDevice::RunMeasurement(const std::string &request)
 {
-    RT_ASSERT(builder->getQubits().size());
-    RT_FAIL_IF(!obs_manager.isValidObservables({obsKey}), "Invalid key for cached observables");
-    auto &&obs = obs_manager.getObservable(obsKey);
-    RT_FAIL_IF(obs->getName() == "QasmHamiltonianObs",
-               "Unsupported observable: QasmHamiltonianObs");
-
-    std::ostringstream oss;
-    oss << "#pragma braket result expectation " << obs->toOpenQasm(builder->getQubits()[0]);
-    auto &&circuit = builder->toOpenQasmWithCustomInstructions(oss.str(), 9);
+    constexpr size_t precision{9}; // tidy: readability-magic-numbers
 
-    // update tape caching
-    if (tape_recording) {
-        cache_manager.addObservable(obsKey, Catalyst::Runtime::MeasurementsT::Expval);
+    auto &&circuit = builder->toOpenQasmWithCustomInstructions("", precision);
+    auto &&pending = measurement_batch.request(circuit, request, GetNumQubits(), device_shots,
+                                               builder->getInputs());
+    if (pending.empty()) {
+        return;
     }
 
     std::string s3_folder_str{};
@@ -206,10 +197,17 @@ auto OpenQasmDevice::Expval([[maybe_unused]] ObsIdType obsKey) -> double
         device_info = device_kwargs["backend"];
     }
 
-    return runner->Expval(circuit, device_info, device_shots, s3_folder_str);
+    // Submit without blocking; the results are waited for when consumed
+    measurement_batch.submit(pending, [runner = runner.get(), circuit, device_info,
+                                       shots = device_shots, s3_folder_str,
+                                       inputs = builder->getInputs()](
+                                          const std::vector<std::string> &requests) {
+        return runner->Submit(circuit + OpenQasm::MeasurementBatch::toPragmas(requests),
+                              device_info, shots, s3_folder_str, inputs);
+    });
 }
 
-auto OpenQasmDevice::Var([[maybe_unused]] ObsIdType obsKey) -> double
+auto OpenQasmDevice::Expval([[maybe_unused]] ObsIdType obsKey) -> double
 {
     RT_ASSERT(builder->getQubits().size());
     RT_FAIL_IF(!obs_manager.isValidObservables({obsKey}), "Invalid key for cached observables");
@@ -218,28 +216,35 @@ auto OpenQasmDevice::Var([[maybe_unused]] ObsIdType obsKey) -> double
                "Unsupported observable: QasmHamiltonianObs");
 
     std::ostringstream oss;
-    oss << "#pragma braket result variance " << obs->toOpenQasm(builder->getQubits()[0]);
-    auto &&circuit = builder->toOpenQasmWithCustomInstructions(oss.str(), 9);
+    oss << "expectation " << obs->toOpenQasm(builder->getQubits()[0]);
 
     // update tape caching
     if (tape_recording) {
-        cache_manager.addObservable(obsKey, Catalyst::Runtime::MeasurementsT::Var);
+        cache_manager.addObservable(obsKey, Catalyst::Runtime::MeasurementsT::Expval);
     }
 
-    std::string s3_folder_str{};
-    if (device_kwargs.contains("s3_destination_folder")) {
-        s3_folder_str = device_kwargs["s3_destination_folder"];
-    }
+    RunMeasurement(oss.str());
+    return measurement_batch.getValues(oss.str())[0];
+}
 
-    std::string device_info{};
-    if (builder_type == OpenQasm::BuilderType::BraketRemote) {
-        device_info = device_kwargs["device_arn"];
-    }
-    else if (builder_type == OpenQasm::BuilderType::BraketLocal) {
-        device_info = device_kwargs["backend"];
+auto OpenQasmDevice::Var([[maybe_unused]] ObsIdType obsKey) -> double
+{
+    RT_ASSERT(builder->getQubits().size());
+    RT_FAIL_IF(!obs_manager.isValidObservables({obsKey}), "Invalid key for cached observables");
+    auto &&obs = obs_manager.getObservable(obsKey);
+    RT_FAIL_IF(obs->getName() == "QasmHamiltonianObs",
+               "Unsupported observable: QasmHamiltonianObs");
+
+    std::ostringstream oss;
+    oss << "variance " << obs->toOpenQasm(builder->getQubits()[0]);
+
+    // update tape caching
+    if (tape_recording) {
+        cache_manager.addObservable(obsKey, Catalyst::Runtime::MeasurementsT::Var);
     }
 
-    return runner->Var(circuit, device_info, device_shots, s3_folder_str);
+    RunMeasurement(oss.str());
+    return measurement_batch.getValues(oss.str())[0];
 }
 
 void OpenQasmDevice::State([[maybe_unused]] DataView<std::complex<double>, 1> &state)
@@ -270,25 +275,13 @@ void OpenQasmDevice::State([[maybe_unused]] DataView<std::complex<double>, 1> &s
 
 void OpenQasmDevice::Probs(DataView<double, 1> &probs)
 {
-    std::string s3_folder_str{};
-    if (device_kwargs.contains("s3_destination_folder")) {
-        s3_folder_str = device_kwargs["s3_destination_folder"];
-    }
-
-    std::string device_info{};
-    if (builder_type == OpenQasm::BuilderType::BraketRemote) {
-        device_info = device_kwargs["device_arn"];
-    }
-    else if (builder_type == OpenQasm::BuilderType::BraketLocal) {
-        device_info = device_kwargs["backend"];
-    }
-
-    auto &&dv_probs = runner->Probs(builder->toOpenQasm(), device_info, device_shots,
-                                    GetNumQubits(), s3_folder_str);
+    const std::string request{"probability"};
+    RunMeasurement(request);
 
+    auto &&dv_probs = measurement_batch.getValues(request);
     RT_FAIL_IF(probs.size() != dv_probs.size(), "Invalid size for the pre-allocated probabilities");
 
-    std::move(dv_probs.begin(), dv_probs.end(), probs.begin());
+    std::copy(dv_probs.begin(), dv_probs.end(), probs.begin());
 }
 
 void OpenQasmDevice::PartialProbs([[maybe_unused]] DataView<double, 1> &probs,
@@ -298,48 +291,20 @@ void OpenQasmDevice::PartialProbs([[maybe_unused]] DataView<double, 1> &probs,
     auto &&dev_wires = getDeviceWires(wires);
 
     std::ostringstream oss;
-    oss << "#pragma braket result probability "
+    oss << "probability "
         << builder->getQubits()[0].toOpenQasm(OpenQasm::RegisterMode::Slice, dev_wires);
-    auto &&circuit = builder->toOpenQasmWithCustomInstructions(oss.str());
-
-    std::string s3_folder_str{};
-    if (device_kwargs.contains("s3_destination_folder")) {
-        s3_folder_str = device_kwargs["s3_destination_folder"];
-    }
-
-    std::string device_info{};
-    if (builder_type == OpenQasm::BuilderType::BraketRemote) {
-        device_info = device_kwargs["device_arn"];
-    }
-    else if (builder_type == OpenQasm::BuilderType::BraketLocal) {
-        device_info = device_kwargs["backend"];
-    }
-
-    auto &&dv_probs =
-        runner->Probs(circuit, device_info, device_shots, wires.size(), s3_folder_str);
+    RunMeasurement(oss.str());
 
+    auto &&dv_probs = measurement_batch.getValues(oss.str());
     RT_FAIL_IF(probs.size() != dv_probs.size(), "Invalid size for the pre-allocated probabilities");
 
-    std::move(dv_probs.begin(), dv_probs.end(), probs.begin());
+    std::copy(dv_probs.begin(), dv_probs.end(), probs.begin());
 }
 
 void OpenQasmDevice::Sample(DataView<double, 2> &samples, size_t shots)
 {
-    std::string s3_folder_str{};
-    if (device_kwargs.contains("s3_destination_folder")) {
-        s3_folder_str = device_kwargs["s3_destination_folder"];
-    }
-
-    std::string device_info{};
-    if (builder_type == OpenQasm::BuilderType::BraketRemote) {
-        device_info = device_kwargs["device_arn"];
-    }
-    else if (builder_type == OpenQasm::BuilderType::BraketLocal) {
-        device_info = device_kwargs["backend"];
-    }
-
-    auto &&li_samples = runner->Sample(builder->toOpenQasm(), device_info, device_shots,
-                                       GetNumQubits(), s3_folder_str);
+    RunMeasurement(std::string{OpenQasm::MeasurementBatch::samples_request});
+    auto &&li_samples = measurement_batch.getSamples();
     RT_FAIL_IF(samples.size() != li_samples.size(), "Invalid size for the pre-allocated samples");
 
     const size_t numQubits = GetNumQubits();
@@ -366,21 +331,8 @@ void OpenQasmDevice::PartialSample(DataView<double, 2> &samples,
     // // get device wires
     auto &&dev_wires = getDeviceWires(wires);
 
-    std::string s3_folder_str{};
-    if (device_kwargs.contains("s3_destination_folder")) {
-        s3_folder_str = device_kwargs["s3_destination_folder"];
-    }
-
-    std::string device_info{};
-    if (builder_type == OpenQasm::BuilderType::BraketRemote) {
-        device_info = device_kwargs["device_arn"];
-    }
-    else if (builder_type == OpenQasm::BuilderType::BraketLocal) {
-        device_info = device_kwargs["backend"];
-    }
-
-    auto &&li_samples = runner->Sample(builder->toOpenQasm(), device_info, device_shots,
-                                       GetNumQubits(), s3_folder_str);
+    RunMeasurement(std::string{OpenQasm::MeasurementBatch::samples_request});
+    auto &&li_samples = measurement_batch.getSamples();
 
     auto samplesIter = samples.begin();
     for (size_t shot = 0; shot < shots; shot++) {
@@ -399,21 +351,8 @@ void OpenQasmDevice::Counts(DataView<double, 1> &eigvals, DataView<int64_t, 1> &
     RT_FAIL_IF(eigvals.size() != numElements || counts.size() != numElements,
                "Invalid size for the pre-allocated counts");
 
-    std::string s3_folder_str{};
-    if (device_kwargs.contains("s3_destination_folder")) {
-        s3_folder_str = device_kwargs["s3_destination_folder"];
-    }
-
-    std::string device_info{};
-    if (builder_type == OpenQasm::BuilderType::BraketRemote) {
-        device_info = device_kwargs["device_arn"];
-    }
-    else if (builder_type == OpenQasm::BuilderType::BraketLocal) {
-        device_info = device_kwargs["backend"];
-    }
-
-    auto &&li_samples = runner->Sample(builder->toOpenQasm(), device_info, device_shots,
-                                       GetNumQubits(), s3_folder_str);
+    RunMeasurement(std::string{OpenQasm::MeasurementBatch::samples_request});
+    auto &&li_samples = measurement_batch.getSamples();
 
     std::iota(eigvals.begin(), eigvals.end(), 0);
     std::fill(counts.begin(), counts.end(), 0);
@@ -442,21 +381,8 @@ void OpenQasmDevice::PartialCounts(DataView<double, 1> &eigvals, DataView<int64_
 
     auto &&dev_wires = getDeviceWires(wires);
 
-    std::string s3_folder_str{};
-    if (device_kwargs.contains("s3_destination_folder")) {
-        s3_folder_str = device_kwargs["s3_destination_folder"];
-    }
-
-    std::string device_info{};
-    if (builder_type == OpenQasm::BuilderType::BraketRemote) {
-        device_info = device_kwargs["device_arn"];
-    }
-    else if (builder_type == OpenQasm::BuilderType::BraketLocal) {
-        device_info = device_kwargs["backend"];
-    }
-
-    auto &&li_samples = runner->Sample(builder->toOpenQasm(), device_info, device_shots,
-                                       GetNumQubits(), s3_folder_str);
+    RunMeasurement(std::string{OpenQasm::MeasurementBatch::samples_request});
+    auto &&li_samples = measurement_batch.getSamples();
 
     std::iota(eigvals.begin(), eigvals.end(), 0);
     std::fill(counts.begin(), counts.end(), 0);
@@ -34,6 +34,7 @@
 #include <pybind11/embed.h>
 
 #include "OpenQasmBuilder.hpp"
+#include "OpenQasmMeasurementBatch.hpp"
 #include "OpenQasmObsManager.hpp"
 #include "OpenQasmRunner.hpp" // <pybind11/embed.h>
 
@@ -53,9 +54,25 @@ class OpenQasmDevice final : public Catalyst::Runtime::QuantumDevice {
     size_t device_shots;
 
     OpenQasm::OpenQasmObsManager obs_manager{};
+    OpenQasm::MeasurementBatch measurement_batch{};
     OpenQasm::BuilderType builder_type;
+    bool parametric{false};
     std::unordered_map<std::string, std::string> device_kwargs;
 
+    // Create an empty builder of the device type
+    [[nodiscard]] auto makeBuilder() const -> std::unique_ptr<OpenQasm::OpenQasmBuilder>
+    {
+        std::unique_ptr<OpenQasm::OpenQasmBuilder> new_builder;
+        if (builder_type != OpenQasm::BuilderType::Common) {
+            new_builder = std::make_unique<OpenQasm::BraketBuilder>();
+        }
+        else {
+            new_builder = std::make_unique<OpenQasm::OpenQasmBuilder>();
+        }
+        new_builder->setParametric(parametric);
+        return new_builder;
+    }
+
     inline auto getDeviceWires(const std::vector<QubitIdType> &wires) -> std::vector<size_t>
     {
         std::vector<size_t> res;
@@ -65,6 +82,11 @@ class OpenQasmDevice final : public Catalyst::Runtime::QuantumDevice {
         return res;
     }
 
+    // Submit the circuit for a measurement process, batched with the other
+    // measurements of the execution, unless its results are already available
+    // or submitted
+    void RunMeasurement(const std::string &request);
+
     inline auto isValidQubits(const std::vector<QubitIdType> &wires) -> bool
     {
         return std::all_of(wires.begin(), wires.end(),
@@ -94,20 +116,30 @@ class OpenQasmDevice final : public Catalyst::Runtime::QuantumDevice {
                     device_kwargs["backend"] = "default";
                 }
             }
+            else if (device_kwargs["device_type"] == "openqasm.local.qubit") {
+                builder_type = OpenQasm::BuilderType::Native;
+            }
             else {
                 RT_ASSERT("Invalid OpenQasm device type");
             }
         }
         else {
             builder_type = OpenQasm::BuilderType::Common;
-            builder = std::make_unique<OpenQasm::OpenQasmBuilder>();
             runner = std::make_unique<OpenQasm::OpenQasmRunner>();
         }
 
-        if (builder_type != OpenQasm::BuilderType::Common) {
-            builder = std::make_unique<OpenQasm::BraketBuilder>();
+        if (builder_type == OpenQasm::BuilderType::Native) {
+            // Braket programs executed in-process, without the Python interpreter
+            runner = std::make_unique<OpenQasm::NativeRunner>();
+        }
+        else if (builder_type != OpenQasm::BuilderType::Common) {
             runner = std::make_unique<OpenQasm::BraketRunner>();
         }
+
+        // Bind gate parameters to program inputs rather than serializing their values
+        parametric =
+            device_kwargs.contains("parametric") ? device_kwargs["parametric"] == "True" : false;
+        builder = makeBuilder();
     }
     ~OpenQasmDevice() = default;
 
@@ -0,0 +1,648 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <numbers>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Exception.hpp"
+
+namespace Catalyst::Runtime::Device::OpenQasm {
+
+/**
+ * The state-vector of the native OpenQasm executor.
+ *
+ * Qubit 0 is the most significant bit of a basis-state index, and the first
+ * wire of a gate is the most significant bit of the gate matrix, as in the
+ * results of Braket devices.
+ */
+class QasmStateVector {
+  private:
+    size_t num_qubits;
+    std::vector<std::complex<double>> data;
+
+  public:
+    explicit QasmStateVector(size_t _num_qubits)
+        : num_qubits(_num_qubits), data(1UL << _num_qubits, {0, 0})
+    {
+        data[0] = {1, 0};
+    }
+    ~QasmStateVector() = default;
+
+    QasmStateVector(const QasmStateVector &) = default;
+    QasmStateVector &operator=(const QasmStateVector &) = default;
+    QasmStateVector(QasmStateVector &&) = default;
+    QasmStateVector &operator=(QasmStateVector &&) = default;
+
+    [[nodiscard]] auto getNumQubits() const -> size_t { return num_qubits; }
+    [[nodiscard]] auto getData() const -> const std::vector<std::complex<double>> &
+    {
+        return data;
+    }
+
+    /**
+     * @brief Apply a row-major matrix to a list of wires.
+     */
+    void apply(const std::vector<std::complex<double>> &matrix, const std::vector<size_t> &wires)
+    {
+        const size_t num_wires = wires.size();
+        const size_t dim = 1UL << num_wires;
+        RT_FAIL_IF(matrix.size() != dim * dim, "Invalid size of the gate matrix");
+
+        std::vector<size_t> bits(num_wires);
+        for (size_t t = 0; t < num_wires; t++) {
+            RT_FAIL_IF(wires[t] >= num_qubits, "Invalid wire");
+            RT_FAIL_IF(std::count(wires.begin(), wires.end(), wires[t]) != 1,
+                       "Invalid list of wires; All wires must be distinct.");
+            bits[t] = num_qubits - 1 - wires[t];
+        }
+
+        // Offsets of the amplitudes of a sub-vector, the first wire being the most significant.
+        std::vector<size_t> offsets(dim, 0);
+        for (size_t k = 0; k < dim; k++) {
+            for (size_t t = 0; t < num_wires; t++) {
+                if ((k >> (num_wires - 1 - t)) & 1UL) {
+                    offsets[k] |= 1UL << bits[t];
+                }
+            }
+        }
+
+        std::vector<size_t> sorted_bits{bits};
+        std::sort(sorted_bits.begin(), sorted_bits.end());
+
+        std::vector<std::complex<double>> buffer(dim);
+        const size_t num_blocks = 1UL << (num_qubits - num_wires);
+        for (size_t block = 0; block < num_blocks; block++) {
+            // Insert zero bits at the positions of the wires.
+            size_t base = block;
+            for (auto bit : sorted_bits) {
+                const size_t low = base & ((1UL << bit) - 1);
+                base = ((base >> bit) << (bit + 1)) | low;
+            }
+
+            for (size_t k = 0; k < dim; k++) {
+                buffer[k] = data[base + offsets[k]];
+            }
+            for (size_t row = 0; row < dim; row++) {
+                std::complex<double> sum{0, 0};
+                for (size_t col = 0; col < dim; col++) {
+                    sum += matrix[row * dim + col] * buffer[col];
+                }
+                data[base + offsets[row]] = sum;
+            }
+        }
+    }
+
+    /**
+     * @brief Get the probabilities of the basis states of a list of wires.
+     */
+    [[nodiscard]] auto probs(const std::vector<size_t> &wires) const -> std::vector<double>
+    {
+        std::vector<double> probs(1UL << wires.size(), 0);
+        for (size_t idx = 0; idx < data.size(); idx++) {
+            size_t sub_idx = 0;
+            for (auto wire : wires) {
+                sub_idx = (sub_idx << 1) | ((idx >> (num_qubits - 1 - wire)) & 1UL);
+            }
+            probs[sub_idx] += std::norm(data[idx]);
+        }
+        return probs;
+    }
+
+    [[nodiscard]] auto innerProduct(const QasmStateVector &other) const -> std::complex<double>
+    {
+        std::complex<double> sum{0, 0};
+        for (size_t idx = 0; idx < data.size(); idx++) {
+            sum += std::conj(data[idx]) * other.data[idx];
+        }
+        return sum;
+    }
+};
+
+/**
+ * The results of executing an OpenQasm program with the native executor.
+ *
+ * @param state The state-vector after the gates of the program
+ * @param values The flattened values of the result pragmas, in order
+ * @param samples The flattened measured bits of all qubits of all shots
+ */
+struct QasmExecutionResults {
+    QasmStateVector state;
+    std::vector<std::vector<double>> values{};
+    std::vector<size_t> samples{};
+};
+
+/**
+ * The native OpenQasm executor, which runs programs on an in-process
+ * state-vector without the Python interpreter.
+ *
+ * It supports the subset of OpenQasm 3 emitted by `OpenQasmBuilder` and
+ * `BraketBuilder`: one statement per line, `input float` variables, a single
+ * quantum register, bit registers, the gates of `rt_qasm_gate_map`,
+ * `#pragma braket unitary` custom unitaries, terminal `measure` and `reset`
+ * statements, and the `expectation`, `variance`, `probability` and
+ * `state_vector` result pragmas.
+ *
+ * @note Result types are computed exactly from the final state, as with zero
+ * shots; shots only determine the number of sampled measurements.
+ */
+class QasmExecutor {
+  private:
+    using ComplexT = std::complex<double>;
+    using MatrixT = std::vector<ComplexT>;
+
+    const std::unordered_map<std::string, double> &inputs;
+    std::unordered_map<std::string, double> variables{};
+    std::string qreg_name{};
+    std::optional<QasmStateVector> state{};
+    // Set by the first measure or reset statement; no gate may follow
+    bool terminated{false};
+
+    [[nodiscard]] static auto trim(std::string_view str) -> std::string_view
+    {
+        const auto begin = str.find_first_not_of(" \t\r");
+        if (begin == std::string_view::npos) {
+            return {};
+        }
+        const auto end = str.find_last_not_of(" \t\r");
+        return str.substr(begin, end - begin + 1);
+    }
+
+    [[nodiscard]] static auto split(std::string_view str, char delim) -> std::vector<std::string>
+    {
+        std::vector<std::string> tokens;
+        size_t begin = 0;
+        while (true) {
+            const auto end = str.find(delim, begin);
+            tokens.emplace_back(trim(str.substr(begin, end - begin)));
+            if (end == std::string_view::npos) {
+                return tokens;
+            }
+            begin = end + 1;
+        }
+    }
+
+    [[nodiscard]] static auto parseSize(std::string_view str) -> size_t
+    {
+        const std::string token{trim(str)};
+        RT_FAIL_IF(token.empty() || token.find_first_not_of("0123456789") != std::string::npos,
+                   "Invalid OpenQasm program; Expected an integer");
+        return std::stoul(token);
+    }
+
+    [[nodiscard]] auto getState() -> QasmStateVector &
+    {
+        RT_FAIL_IF(!state.has_value(), "Invalid OpenQasm program; Missing quantum register");
+        return *state;
+    }
+
+    /**
+     * @brief Parse a list of qubits, e.g. `q[0], q[1]`, or the whole register `q`.
+     */
+    [[nodiscard]] auto parseTargets(std::string_view str) -> std::vector<size_t>
+    {
+        const size_t num_qubits = getState().getNumQubits();
+
+        std::vector<size_t> wires;
+        for (const auto &target : split(str, ',')) {
+            const auto bracket = target.find('[');
+            RT_FAIL_IF(target.substr(0, bracket) != qreg_name,
+                       "Invalid OpenQasm program; Unknown quantum register");
+
+            if (bracket == std::string::npos) {
+                for (size_t wire = 0; wire < num_qubits; wire++) {
+                    wires.push_back(wire);
+                }
+                continue;
+            }
+
+            RT_FAIL_IF(target.back() != ']', "Invalid OpenQasm program; Invalid qubit");
+            const size_t wire = parseSize(
+                std::string_view{target}.substr(bracket + 1, target.size() - bracket - 2));
+            RT_FAIL_IF(wire >= num_qubits, "Invalid OpenQasm program; Qubit out of range");
+            wires.push_back(wire);
+        }
+        return wires;
+    }
+
+    /**
+     * @brief Parse a gate parameter, either a number or an (optionally negated) input variable.
+     */
+    [[nodiscard]] auto parseParam(const std::string &token) const -> double
+    {
+        const char *begin = token.c_str();
+        char *end = nullptr;
+        const double value = std::strtod(begin, &end);
+        if (end != begin && *end == '\0') {
+            return value;
+        }
+
+        const bool negate = !token.empty() && token.front() == '-';
+        const std::string name{trim(std::string_view{token}.substr(negate ? 1 : 0))};
+        auto iter = variables.find(name);
+        RT_FAIL_IF(iter == variables.end(), "Invalid OpenQasm program; Unknown gate parameter");
+        return negate ? -iter->second : iter->second;
+    }
+
+    /**
+     * @brief Parse a matrix serialized by `MatrixBuilder`, e.g. `[[0, 1+0im], [1+0im, 0]]`.
+     */
+    [[nodiscard]] static auto parseMatrix(std::string_view str) -> MatrixT
+    {
+        std::string flat{str};
+        flat.erase(std::remove_if(flat.begin(), flat.end(),
+                                  [](char c) { return c == '[' || c == ']'; }),
+                   flat.end());
+
+        MatrixT matrix;
+        for (const auto &token : split(flat, ',')) {
+            const char *ptr = token.c_str();
+            char *end = nullptr;
+            const double real = std::strtod(ptr, &end);
+            RT_FAIL_IF(end == ptr, "Invalid OpenQasm program; Invalid matrix element");
+
+            std::string_view rest{end};
+            if (rest.empty()) {
+                matrix.emplace_back(real, 0);
+                continue;
+            }
+            if (rest == "im") {
+                matrix.emplace_back(0, real);
+                continue;
+            }
+
+            ptr = end;
+            const double imag = std::strtod(ptr, &end);
+            RT_FAIL_IF(end == ptr || std::string_view{end} != "im",
+                       "Invalid OpenQasm program; Invalid matrix element");
+            matrix.emplace_back(real, imag);
+        }
+        return matrix;
+    }
+
+    /**
+     * @brief Extend a matrix with control wires placed before its wires.
+     */
+    [[nodiscard]] static auto controlled(const MatrixT &matrix, size_t num_controls) -> MatrixT
+    {
+        const size_t dim = static_cast<size_t>(std::sqrt(matrix.size()));
+        const size_t full_dim = dim << num_controls;
+        const size_t offset = full_dim - dim;
+
+        MatrixT full(full_dim * full_dim, {0, 0});
+        for (size_t idx = 0; idx < offset; idx++) {
+            full[idx * full_dim + idx] = {1, 0};
+        }
+        for (size_t row = 0; row < dim; row++) {
+            for (size_t col = 0; col < dim; col++) {
+                full[(offset + row) * full_dim + offset + col] = matrix[row * dim + col];
+            }
+        }
+        return full;
+    }
+
+    /**
+     * @brief Get the matrix of a gate or a named observable of `rt_qasm_gate_map`.
+     */
+    [[nodiscard]] static auto getGateMatrix(std::string_view name,
+                                            const std::vector<double> &params) -> MatrixT
+    {
+        using namespace std::complex_literals;
+
+        const std::vector<std::tuple<std::string_view, size_t>> num_params = {
+            {"phaseshift", 1}, {"rx", 1}, {"ry", 1}, {"rz", 1}, {"pswap", 1}};
+        size_t expected = 0;
+        for (auto &&[gate, count] : num_params) {
+            expected = gate == name ? count : expected;
+        }
+        RT_FAIL_IF(params.size() != expected, "Invalid OpenQasm program; Invalid parameters");
+
+        const MatrixT pauli_x{0, 1, 1, 0};
+        const MatrixT pauli_y{0, -1i, 1i, 0};
+        const MatrixT pauli_z{1, 0, 0, -1};
+        const MatrixT swap{1, 0, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0, 0, 0, 0, 1};
+        const double inv_sqrt2 = 1 / std::numbers::sqrt2;
+
+        if (name == "i") {
+            return {1, 0, 0, 1};
+        }
+        if (name == "x") {
+            return pauli_x;
+        }
+        if (name == "y") {
+            return pauli_y;
+        }
+        if (name == "z") {
+            return pauli_z;
+        }
+        if (name == "h") {
+            return {inv_sqrt2, inv_sqrt2, inv_sqrt2, -inv_sqrt2};
+        }
+        if (name == "s") {
+            return {1, 0, 0, 1i};
+        }
+        if (name == "t") {
+            return {1, 0, 0, std::polar(1.0, std::numbers::pi / 4)};
+        }
+        if (name == "cnot") {
+            return controlled(pauli_x, 1);
+        }
+        if (name == "cy") {
+            return controlled(pauli_y, 1);
+        }
+        if (name == "cz") {
+            return controlled(pauli_z, 1);
+        }
+        if (name == "swap") {
+            return swap;
+        }
+        if (name == "cswap") {
+            return controlled(swap, 1);
+        }
+        if (name == "ccnot") {
+            return controlled(pauli_x, 2);
+        }
+        if (name == "iswap") {
+            return {1, 0, 0, 0, 0, 0, 1i, 0, 0, 1i, 0, 0, 0, 0, 0, 1};
+        }
+        if (name == "pswap") {
+            const ComplexT phase = std::polar(1.0, params[0]);
+            return {1, 0, 0, 0, 0, 0, phase, 0, 0, phase, 0, 0, 0, 0, 0, 1};
+        }
+        if (name == "phaseshift") {
+            return {1, 0, 0, std::polar(1.0, params[0])};
+        }
+
+        if (name == "rx") {
+            const double c = std::cos(params[0] / 2);
+            const double s = std::sin(params[0] / 2);
+            return {c, -1i * s, -1i * s, c};
+        }
+        if (name == "ry") {
+            const double c = std::cos(params[0] / 2);
+            const double s = std::sin(params[0] / 2);
+            return {c, -s, s, c};
+        }
+        if (name == "rz") {
+            return {std::polar(1.0, -params[0] / 2), 0, 0, std::polar(1.0, params[0] / 2)};
+        }
+
+        RT_FAIL("Invalid OpenQasm program; Unsupported gate");
+    }
+
+    /**
+     * @brief Parse an observable, e.g. `z(q[0]) @ hermitian([[...]]) q[1]`, as a list of
+     * factors acting on disjoint wires.
+     */
+    [[nodiscard]] auto parseObservable(std::string_view str)
+        -> std::vector<std::pair<MatrixT, std::vector<size_t>>>
+    {
+        std::vector<std::pair<MatrixT, std::vector<size_t>>> factors;
+        for (const auto &factor : split(str, '@')) {
+            const auto open = factor.find('(');
+            const auto close = factor.rfind(')');
+            RT_FAIL_IF(open == std::string::npos || close == std::string::npos || close < open,
+                       "Invalid OpenQasm program; Invalid observable");
+
+            const std::string name = factor.substr(0, open);
+            const std::string_view args{factor.data() + open + 1, close - open - 1};
+            if (name == "hermitian") {
+                auto &&wires = parseTargets(factor.substr(close + 1));
+                auto &&matrix = parseMatrix(args);
+                RT_FAIL_IF(matrix.size() != (1UL << (2 * wires.size())),
+                           "Invalid OpenQasm program; Invalid size of the hermitian matrix");
+                factors.emplace_back(std::move(matrix), std::move(wires));
+                continue;
+            }
+
+            RT_FAIL_IF(!trim(factor.substr(close + 1)).empty(),
+                       "Invalid OpenQasm program; Invalid observable");
+            auto &&wires = parseTargets(args);
+            RT_FAIL_IF(wires.size() != 1, "Invalid OpenQasm program; Invalid observable wires");
+            factors.emplace_back(getGateMatrix(name, {}), std::move(wires));
+        }
+        return factors;
+    }
+
+    /**
+     * @brief Compute the value of a result pragma, e.g. `expectation z(q[0])`.
+     */
+    [[nodiscard]] auto computeResult(std::string_view result) -> std::optional<std::vector<double>>
+    {
+        const auto space = result.find(' ');
+        const std::string_view type = result.substr(0, space);
+        const std::string_view args =
+            space == std::string_view::npos ? std::string_view{} : trim(result.substr(space));
+
+        QasmStateVector &psi = getState();
+        if (type == "state_vector") {
+            return std::nullopt;
+        }
+        if (type == "probability") {
+            if (args.empty()) {
+                std::vector<size_t> wires(psi.getNumQubits());
+                std::iota(wires.begin(), wires.end(), 0);
+                return psi.probs(wires);
+            }
+            return psi.probs(parseTargets(args));
+        }
+        if (type == "expectation" || type == "variance") {
+            QasmStateVector phi{psi};
+            for (auto &&[matrix, wires] : parseObservable(args)) {
+                phi.apply(matrix, wires);
+            }
+            const double expval = psi.innerProduct(phi).real();
+            if (type == "expectation") {
+                return std::vector<double>{expval};
+            }
+            return std::vector<double>{phi.innerProduct(phi).real() - expval * expval};
+        }
+
+        RT_FAIL("Invalid OpenQasm program; Unsupported result type");
+    }
+
+    void executeStatement(std::string_view statement, QasmExecutionResults &results)
+    {
+        static constexpr std::string_view unitary_pragma{"#pragma braket unitary("};
+        static constexpr std::string_view result_pragma{"#pragma braket result "};
+
+        if (statement.starts_with("OPENQASM")) {
+            return;
+        }
+        if (statement.starts_with(result_pragma)) {
+            auto &&value = computeResult(trim(statement.substr(result_pragma.size())));
+            if (value.has_value()) {
+                results.values.push_back(std::move(*value));
+            }
+            return;
+        }
+        if (statement.starts_with(unitary_pragma)) {
+            RT_FAIL_IF(terminated, "Unsupported OpenQasm program; Gate after measure or reset");
+            const auto close = statement.find(')');
+            RT_FAIL_IF(close == std::string_view::npos,
+                       "Invalid OpenQasm program; Invalid unitary pragma");
+            auto &&wires = parseTargets(statement.substr(close + 1));
+            getState().apply(parseMatrix(statement.substr(unitary_pragma.size(),
+                                                          close - unitary_pragma.size())),
+                             wires);
+            return;
+        }
+        RT_FAIL_IF(statement.starts_with("#"), "Unsupported OpenQasm pragma");
+
+        RT_FAIL_IF(!statement.ends_with(';'), "Invalid OpenQasm program; Missing semicolon");
+        statement = trim(statement.substr(0, statement.size() - 1));
+
+        if (statement.starts_with("input float ")) {
+            const std::string name{trim(statement.substr(12))};
+            auto iter = inputs.find(name);
+            RT_FAIL_IF(iter == inputs.end(), "Missing value of the OpenQasm input variable");
+            variables[name] = iter->second;
+            return;
+        }
+        if (statement.starts_with("qubit[")) {
+            RT_FAIL_IF(state.has_value(), "Unsupported OpenQasm program; Only one quantum "
+                                          "register is currently supported.");
+            const auto close = statement.find(']');
+            RT_FAIL_IF(close == std::string_view::npos,
+                       "Invalid OpenQasm program; Invalid quantum register");
+            state.emplace(parseSize(statement.substr(6, close - 6)));
+            qreg_name = trim(statement.substr(close + 1));
+            return;
+        }
+        if (statement.starts_with("bit[")) {
+            return;
+        }
+        if (statement.starts_with("reset ")) {
+            static_cast<void>(parseTargets(statement.substr(6)));
+            terminated = true;
+            return;
+        }
+        if (const auto pos = statement.find("measure "); pos != std::string_view::npos) {
+            static_cast<void>(parseTargets(statement.substr(pos + 8)));
+            terminated = true;
+            return;
+        }
+
+        // name(param_1, ..., param_n) qubit_1, ..., qubit_m
+        RT_FAIL_IF(terminated, "Unsupported OpenQasm program; Gate after measure or reset");
+        const auto open = statement.find('(');
+        const auto space = statement.find(' ');
+        RT_FAIL_IF(space == std::string_view::npos, "Invalid OpenQasm program; Invalid gate");
+
+        std::vector<double> params;
+        std::string_view targets = statement.substr(space + 1);
+        if (open != std::string_view::npos && open < space) {
+            const auto close = statement.find(')', open);
+            RT_FAIL_IF(close == std::string_view::npos, "Invalid OpenQasm program; Invalid gate");
+            for (const auto &token : split(statement.substr(open + 1, close - open - 1), ',')) {
+                params.push_back(parseParam(token));
+            }
+            targets = statement.substr(close + 1);
+        }
+
+        const std::string_view name = statement.substr(0, std::min(open, space));
+        auto &&wires = parseTargets(targets);
+        auto &&matrix = getGateMatrix(name, params);
+        RT_FAIL_IF(matrix.size() != (1UL << (2 * wires.size())),
+                   "Invalid OpenQasm program; Invalid number of qubits");
+        getState().apply(matrix, wires);
+    }
+
+    /**
+     * @brief Sample the measured bits of all qubits from the final state.
+     */
+    [[nodiscard]] static auto sample(const QasmStateVector &psi, size_t shots,
+                                     std::mt19937_64 &engine) -> std::vector<size_t>
+    {
+        const size_t num_qubits = psi.getNumQubits();
+        std::vector<size_t> wires(num_qubits);
+        std::iota(wires.begin(), wires.end(), 0);
+
+        auto &&probs = psi.probs(wires);
+        std::discrete_distribution<size_t> distribution(probs.begin(), probs.end());
+
+        std::vector<size_t> samples(shots * num_qubits);
+        for (size_t shot = 0; shot < shots; shot++) {
+            const size_t idx = distribution(engine);
+            for (size_t wire = 0; wire < num_qubits; wire++) {
+                samples[shot * num_qubits + wire] = (idx >> (num_qubits - 1 - wire)) & 1UL;
+            }
+        }
+        return samples;
+    }
+
+  public:
+    explicit QasmExecutor(const std::unordered_map<std::string, double> &_inputs)
+        : inputs(_inputs)
+    {
+    }
+    ~QasmExecutor() = default;
+
+    QasmExecutor(const QasmExecutor &) = delete;
+    QasmExecutor &operator=(const QasmExecutor &) = delete;
+    QasmExecutor(QasmExecutor &&) = delete;
+    QasmExecutor &operator=(QasmExecutor &&) = delete;
+
+    /**
+     * @brief Execute an OpenQasm program.
+     *
+     * @param circuit The OpenQasm program
+     * @param shots The number of shots to sample the measured bits of
+     * @param seed Optional seed of the random number generator of the samples
+     *
+     * @return The final state, the values of the result pragmas and the samples
+     */
+    [[nodiscard]] auto run(const std::string &circuit, size_t shots,
+                           std::optional<size_t> seed = std::nullopt) -> QasmExecutionResults
+    {
+        variables.clear();
+        qreg_name.clear();
+        state.reset();
+        terminated = false;
+
+        QasmExecutionResults results{QasmStateVector{0}};
+
+        std::istringstream iss{circuit};
+        std::string line;
+        while (std::getline(iss, line)) {
+            std::string_view statement = trim(line);
+            if (statement.empty() || statement.starts_with("//")) {
+                continue;
+            }
+            executeStatement(statement, results);
+        }
+
+        results.state = std::move(getState());
+        if (shots != 0) {
+            std::mt19937_64 engine{seed.has_value() ? *seed : std::random_device{}()};
+            results.samples = sample(results.state, shots, engine);
+        }
+        return results;
+    }
+};
+} // namespace Catalyst::Runtime::Device::OpenQasm
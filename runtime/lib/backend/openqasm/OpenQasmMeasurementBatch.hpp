@@ -0,0 +1,309 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Exception.hpp"
+
+#include "OpenQasmRunner.hpp"
+
+namespace Catalyst::Runtime::Device::OpenQasm {
+
+/**
+ * The MeasurementBatch class collects the measurements of one execution of a
+ * circuit so that they are submitted as a single program with several result
+ * types, sharing one circuit run and one shot budget.
+ *
+ * Measurement processes are requested one at a time by the runtime, so the
+ * measurements of an execution are only known once it completes. They are
+ * recorded as a plan, shared by all devices of the process and keyed by the
+ * structure of the circuit, i.e. its program without the gate parameters, and
+ * the first measurement of the execution. When a later execution requests a
+ * measurement that is not cached yet, all pending measurements of the plan are
+ * run together, and their results are served to the following requests as
+ * long as the circuit, its input values and the number of shots do not change.
+ *
+ * Runs are submitted without blocking; the batch waits for their results only
+ * when they are consumed.
+ */
+class MeasurementBatch {
+  public:
+    // The request of the measured bits of all shots, which needs no result pragma.
+    static constexpr std::string_view samples_request{"measurements"};
+
+  private:
+    struct Plan {
+        std::vector<std::string> requests{};
+        bool batchable{true};
+    };
+
+  public:
+    // Submit a run of a list of requests
+    using Submitter = std::function<std::future<BatchResults>(const std::vector<std::string> &)>;
+
+  private:
+    // A submitted run whose results have not been consumed yet
+    struct Job {
+        std::vector<std::string> requests;
+        std::future<BatchResults> results;
+        Submitter submitter;
+    };
+
+    // Plans learned from previous executions, shared by all devices
+    inline static std::unordered_map<std::string, Plan> plans{};
+    inline static std::mutex plans_mu;
+
+    std::string circuit_{};
+    size_t structure_{0};
+    std::unordered_map<std::string, double> inputs_{};
+    size_t shots_{0};
+    size_t num_qubits_{0};
+    std::vector<std::string> requests_{};
+    std::optional<Job> job_{};
+    std::unordered_map<std::string, std::vector<double>> values_{};
+    std::optional<std::vector<size_t>> samples_{};
+
+    [[nodiscard]] auto getPlanKey(size_t num_qubits) const -> std::string
+    {
+        std::ostringstream oss;
+        oss << structure_ << '|' << requests_.front() << '|' << num_qubits << '|' << shots_;
+        return oss.str();
+    }
+
+  public:
+    /**
+     * @brief Get the hash of the structure of a circuit, i.e. of its program
+     * without the parenthesized gate parameters, which is shared by the
+     * executions of a circuit with different parameter values.
+     */
+    [[nodiscard]] static auto hashStructure(const std::string &circuit) -> size_t
+    {
+        std::string structure;
+        structure.reserve(circuit.size());
+        size_t depth = 0;
+        for (char c : circuit) {
+            if (c == ')' && depth) {
+                depth--;
+            }
+            if (!depth) {
+                structure.push_back(c);
+            }
+            if (c == '(') {
+                depth++;
+            }
+        }
+        return std::hash<std::string>{}(structure);
+    }
+
+    MeasurementBatch() = default;
+    ~MeasurementBatch() = default;
+
+    MeasurementBatch(const MeasurementBatch &) = delete;
+    MeasurementBatch &operator=(const MeasurementBatch &) = delete;
+    MeasurementBatch(MeasurementBatch &&) = delete;
+    MeasurementBatch &operator=(MeasurementBatch &&) = delete;
+
+    /**
+     * @brief Drop the results of the current execution.
+     */
+    void reset()
+    {
+        job_.reset();
+        circuit_.clear();
+        inputs_.clear();
+        requests_.clear();
+        values_.clear();
+        samples_.reset();
+    }
+
+    /**
+     * @brief Check whether the results of a request are available or submitted.
+     */
+    [[nodiscard]] auto isCached(const std::string &request) const -> bool
+    {
+        if (job_.has_value() && std::find(job_->requests.begin(), job_->requests.end(),
+                                          request) != job_->requests.end()) {
+            return true;
+        }
+        return request == samples_request ? samples_.has_value() : values_.contains(request);
+    }
+
+    /**
+     * @brief Record the request of a measurement process of a circuit.
+     *
+     * A different circuit, input values or number of shots than the ones of
+     * the previous request starts a new execution.
+     *
+     * @param circuit The program of the circuit without result pragmas
+     * @param request The result type, e.g. `expectation z(q[0])`, or `samples_request`
+     * @param num_qubits The number of qubits of the circuit
+     * @param shots The number of shots
+     * @param inputs The values of the input variables of the program
+     *
+     * @return The requests to run, starting with the given one, or an empty
+     * vector if its results are already available.
+     */
+    auto request(const std::string &circuit, const std::string &request, size_t num_qubits,
+                 size_t shots, const std::unordered_map<std::string, double> &inputs = {})
+        -> std::vector<std::string>
+    {
+        if (circuit != circuit_ || shots != shots_ || inputs != inputs_) {
+            reset();
+            circuit_ = circuit;
+            structure_ = hashStructure(circuit);
+            inputs_ = inputs;
+            shots_ = shots;
+        }
+        num_qubits_ = num_qubits;
+
+        if (std::find(requests_.begin(), requests_.end(), request) == requests_.end()) {
+            requests_.push_back(request);
+        }
+
+        std::lock_guard<std::mutex> lock(plans_mu);
+        Plan &plan = plans[getPlanKey(num_qubits)];
+        const std::vector<std::string> learned = std::exchange(plan.requests, requests_);
+
+        if (isCached(request)) {
+            return {};
+        }
+
+        std::vector<std::string> pending{request};
+        if (!plan.batchable) {
+            return pending;
+        }
+        for (const auto &entry : learned) {
+            if (entry == request || isCached(entry) ||
+                (entry == samples_request && shots_ == 0)) {
+                continue;
+            }
+            pending.push_back(entry);
+        }
+        return pending;
+    }
+
+    /**
+     * @brief Exclude the plan of the current execution from batching, e.g.
+     * after the device rejected the combination of its result types.
+     */
+    void disableBatching(size_t num_qubits)
+    {
+        std::lock_guard<std::mutex> lock(plans_mu);
+        plans[getPlanKey(num_qubits)].batchable = false;
+    }
+
+    /**
+     * @brief Submit the run of a list of requests without waiting for its results.
+     *
+     * @param requests The requests returned by `request`
+     * @param submitter The callable submitting a run of a list of requests, also
+     * used to run the first request alone if the batch is rejected
+     */
+    void submit(const std::vector<std::string> &requests, Submitter submitter)
+    {
+        resolve();
+        auto &&results = submitter(requests);
+        job_.emplace(Job{requests, std::move(results), std::move(submitter)});
+    }
+
+    /**
+     * @brief Wait for the results of the submitted run, if any, and store them.
+     */
+    void resolve()
+    {
+        if (!job_.has_value()) {
+            return;
+        }
+
+        Job job = std::move(*job_);
+        job_.reset();
+
+        if (job.requests.size() == 1) {
+            store(job.requests, job.results.get());
+            return;
+        }
+
+        try {
+            store(job.requests, job.results.get());
+        }
+        catch (const RuntimeException &) {
+            // The device may reject some combinations of result types, e.g. observables
+            // that do not commute qubit-wise when sampling; run the first request alone.
+            disableBatching(num_qubits_);
+            const std::vector<std::string> single{job.requests.front()};
+            store(single, job.submitter(single).get());
+        }
+    }
+
+    /**
+     * @brief Get the result pragmas of a list of requests.
+     */
+    [[nodiscard]] static auto toPragmas(const std::vector<std::string> &requests) -> std::string
+    {
+        std::ostringstream oss;
+        for (const auto &request : requests) {
+            if (request != samples_request) {
+                oss << "#pragma braket result " << request << "\n";
+            }
+        }
+        return oss.str();
+    }
+
+    /**
+     * @brief Store the results of running a list of requests.
+     */
+    void store(const std::vector<std::string> &requests, BatchResults &&results)
+    {
+        auto value = results.values.begin();
+        for (const auto &request : requests) {
+            if (request == samples_request) {
+                continue;
+            }
+            RT_FAIL_IF(value == results.values.end(), "Invalid number of result values");
+            values_[request] = std::move(*value++);
+        }
+
+        if (shots_ != 0) {
+            samples_ = std::move(results.samples);
+        }
+    }
+
+    [[nodiscard]] auto getValues(const std::string &request) -> const std::vector<double> &
+    {
+        resolve();
+        auto iter = values_.find(request);
+        RT_FAIL_IF(iter == values_.end(), "Missing results of the requested measurement");
+        return iter->second;
+    }
+
+    [[nodiscard]] auto getSamples() -> const std::vector<size_t> &
+    {
+        resolve();
+        RT_FAIL_IF(!samples_.has_value(), "Missing samples of the requested measurement");
+        return *samples_;
+    }
+};
+} // namespace Catalyst::Runtime::Device::OpenQasm
@@ -14,23 +14,43 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <complex>
+#include <exception>
+#include <future>
+#include <memory>
 #include <mutex>
+#include <numeric>
 #include <optional>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "Exception.hpp"
+#include "OpenQasmExecutor.hpp"
 
 #include <pybind11/embed.h>
+#include <pybind11/numpy.h>
 
 namespace Catalyst::Runtime::Device::OpenQasm {
 
 // To protect the py::exec calls concurrently
 std::mutex runner_mu;
 
+/**
+ * The results of a circuit run with several result types.
+ */
+struct BatchResults {
+    // The flattened values of the result types, in the order of the result pragmas
+    std::vector<std::vector<double>> values{};
+    // The flattened measured bits of all shots; empty when running without shots
+    std::vector<size_t> samples{};
+};
+
 /**
  * The OpenQasm circuit runner interface.
  */
@@ -87,6 +107,30 @@ struct OpenQasmRunner {
         RT_FAIL("Not implemented method");
         return {};
     }
+    [[nodiscard]] virtual auto
+    Results([[maybe_unused]] const std::string &circuit, [[maybe_unused]] const std::string &device,
+            [[maybe_unused]] size_t shots, [[maybe_unused]] const std::string &kwargs = "",
+            [[maybe_unused]] const std::unordered_map<std::string, double> &inputs = {}) const
+        -> BatchResults
+    {
+        RT_FAIL("Not implemented method");
+        return {};
+    }
+    /**
+     * @brief Submit a circuit with several result types without blocking.
+     *
+     * The returned future blocks until the results are available when they are
+     * consumed. By default, the circuit is run by `Results` at that point.
+     */
+    [[nodiscard]] virtual auto Submit(const std::string &circuit, const std::string &device,
+                                      size_t shots, const std::string &kwargs = "",
+                                      const std::unordered_map<std::string, double> &inputs = {})
+        const -> std::future<BatchResults>
+    {
+        return std::async(std::launch::deferred, [this, circuit, device, shots, kwargs, inputs]() {
+            return Results(circuit, device, shots, kwargs, inputs);
+        });
+    }
     [[nodiscard]] virtual auto Gradient([[maybe_unused]] const std::string &circuit,
                                         [[maybe_unused]] const std::string &device,
                                         [[maybe_unused]] size_t shots,
@@ -102,29 +146,29 @@ struct OpenQasmRunner {
 /**
  * The OpenQasm circuit runner to execute an OpenQasm circuit on Braket Devices backed by
  * Amazon Braket Python SDK.
+ *
+ * The Braket modules, the device objects and the callables running the circuits are created
+ * once per Python interpreter in a session module, so that every call only pays for the
+ * circuit run itself. Numerical results are transferred through the buffer protocol.
  */
 struct BraketRunner : public OpenQasmRunner {
-    [[nodiscard]] auto runCircuit(const std::string &circuit, const std::string &device,
-                                  size_t shots, const std::string &kwargs = "") const
-        -> std::string override
-    {
-        std::lock_guard<std::mutex> lock(runner_mu);
-
-        namespace py = pybind11;
-        using namespace py::literals;
+  private:
+    static constexpr const char *session_name = "_catalyst_braket_session";
 
-        RT_FAIL_IF(!Py_IsInitialized(), "The Python interpreter is not initialized");
+    // The session module; devices are cached per backend name or ARN.
+    static constexpr char session_source[] = R"(
+        from concurrent.futures import ThreadPoolExecutor
 
-        auto locals = py::dict("circuit"_a = circuit, "braket_device"_a = device,
-                               "kwargs"_a = kwargs, "shots"_a = shots, "msg"_a = "");
+        import numpy as np
+        from braket.aws import AwsDevice
+        from braket.devices import LocalSimulator
+        from braket.ir.openqasm import Program as OpenQasmProgram
 
-        py::exec(
-            R"(
-            from braket.aws import AwsDevice
-            from braket.devices import LocalSimulator
-            from braket.ir.openqasm import Program as OpenQasmProgram
+        devices = {}
 
-            try:
+        def get_device(braket_device):
+            device = devices.get(braket_device)
+            if device is None:
                 if braket_device in ["default", "braket_sv", "braket_dm"]:
                     device = LocalSimulator(braket_device)
                 elif "arn:aws:braket" in braket_device:
@@ -133,274 +177,499 @@ struct BraketRunner : public OpenQasmRunner {
                     raise ValueError(
                         "device must be either 'braket.devices.LocalSimulator' or 'braket.aws.AwsDevice'"
                     )
-                if kwargs != "":
-                    kwargs = kwargs.replace("'", "")
-                    kwargs = kwargs[1:-1].split(", ") if kwargs[0] == "(" else kwargs.split(", ")
-                    if len(kwargs) != 2:
-                        raise ValueError(
-                            "s3_destination_folder must be of size 2 with a 'bucket' and 'key' respectively."
-                        )
-                    result = device.run(
-                        OpenQasmProgram(source=circuit),
-                        shots=int(shots),
-                        s3_destination_folder=tuple(kwargs),
-                    ).result()
-                else:
-                    result = device.run(OpenQasmProgram(source=circuit), shots=int(shots)).result()
-                result = str(result)
-            except Exception as e:
+                devices[braket_device] = device
+            return device
+
+        def get_run_kwargs(shots, kwargs):
+            run_kwargs = {"shots": int(shots)}
+            if kwargs != "":
+                kwargs = kwargs.replace("'", "")
+                kwargs = kwargs[1:-1].split(", ") if kwargs[0] == "(" else kwargs.split(", ")
+                if len(kwargs) != 2:
+                    raise ValueError(
+                        "s3_destination_folder must be of size 2 with a 'bucket' and 'key' respectively."
+                    )
+                run_kwargs["s3_destination_folder"] = tuple(kwargs)
+            return run_kwargs
+
+        def run(circuit, braket_device, shots, kwargs, inputs=None):
+            try:
+                device = get_device(braket_device)
+                program = OpenQasmProgram(source=circuit, inputs=inputs or None)
+                return device.run(program, **get_run_kwargs(shots, kwargs)).result()
+            except Exception:
                 print(f"circuit: {circuit}")
-                msg = str(e)
-              )",
-            py::globals(), locals);
+                raise
+
+        def run_circuit(circuit, braket_device, shots, kwargs):
+            return str(run(circuit, braket_device, shots, kwargs))
+
+        def probs(circuit, braket_device, shots, kwargs, num_qubits):
+            result = run(circuit, braket_device, shots, kwargs)
+            probs = np.zeros(2 ** int(num_qubits))
+            for state, prob in result.measurement_probabilities.items():
+                probs[int(state, 2)] = prob
+            return probs
+
+        def sample(circuit, braket_device, shots, kwargs):
+            result = run(circuit, braket_device, shots, kwargs)
+            return np.asarray(result.measurements, dtype=np.uint64).flatten()
+
+        def value(circuit, braket_device, shots, kwargs):
+            result = run(circuit, braket_device, shots, kwargs)
+            return float(result.values[0])
+
+        def to_results(result, shots):
+            values = [np.asarray(v, dtype=np.float64).flatten() for v in result.values]
+            if int(shots):
+                samples = np.asarray(result.measurements, dtype=np.uint64).flatten()
+            else:
+                samples = np.zeros(0, dtype=np.uint64)
+            return values, samples
+
+        def results(circuit, braket_device, shots, kwargs, inputs):
+            return to_results(run(circuit, braket_device, shots, kwargs, inputs), shots)
+
+        # The local simulations run in the background on a pool of threads, and
+        # their futures are wrapped with the interface of the Braket tasks.
+        executor = ThreadPoolExecutor(thread_name_prefix="catalyst_braket")
+
+        def run_local(device, program, run_kwargs):
+            return device.run(program, **run_kwargs).result()
+
+        class LocalTask:
+            def __init__(self, future):
+                self._future = future
+
+            def state(self):
+                if not self._future.done():
+                    return "RUNNING"
+                return "FAILED" if self._future.exception() else "COMPLETED"
+
+            def result(self):
+                return self._future.result()
+
+        # Submitted tasks by id
+        tasks = {}
+        task_ids = iter(range(2**63))
+
+        def submit_batch(circuits, braket_device, shots, kwargs, inputs):
+            device = get_device(braket_device)
+            programs = [
+                OpenQasmProgram(source=circuit, inputs=circuit_inputs or None)
+                for circuit, circuit_inputs in zip(circuits, inputs)
+            ]
+            run_kwargs = get_run_kwargs(shots, kwargs)
+            if isinstance(device, LocalSimulator):
+                handles = [
+                    LocalTask(executor.submit(run_local, device, program, run_kwargs))
+                    for program in programs
+                ]
+            else:
+                handles = device.run_batch(programs, **run_kwargs).tasks
+
+            ids = []
+            for handle in handles:
+                task_id = next(task_ids)
+                tasks[task_id] = handle
+                ids.append(task_id)
+            return ids
+
+        def done(task_id):
+            return tasks[task_id].state() in ["COMPLETED", "FAILED", "CANCELLED"]
+
+        def collect(task_id, shots):
+            return to_results(tasks.pop(task_id).result(), shots)
+        )";
+
+    /**
+     * @brief Lock `runner_mu` without holding the GIL while waiting for it.
+     *
+     * The GIL is dropped within the Python calls made under `runner_mu`, e.g. while
+     * waiting for the network or switching to the threads of the local simulations,
+     * so a thread blocking on `runner_mu` with the GIL would deadlock with them.
+     */
+    [[nodiscard]] static auto lockRunner() -> std::unique_lock<std::mutex>
+    {
+        if (Py_IsInitialized() && PyGILState_Check()) {
+            pybind11::gil_scoped_release release;
+            return std::unique_lock<std::mutex>(runner_mu);
+        }
+        return std::unique_lock<std::mutex>(runner_mu);
+    }
 
-        auto &&msg = locals["msg"].cast<std::string>();
-        RT_FAIL_IF(!msg.empty(), msg.c_str());
+    /**
+     * The lock of the session, which takes `runner_mu` and then the GIL, always
+     * in this order.
+     */
+    struct SessionLock {
+        const bool initialized = []() {
+            RT_FAIL_IF(!Py_IsInitialized(), "The Python interpreter is not initialized");
+            return true;
+        }();
+        std::unique_lock<std::mutex> lock{lockRunner()};
+        pybind11::gil_scoped_acquire gil{};
+    };
+
+    /**
+     * @brief Get the session module of the running interpreter, creating it on first use.
+     */
+    [[nodiscard]] static auto getSession() -> pybind11::object
+    {
+        namespace py = pybind11;
 
-        return locals["result"].cast<std::string>();
+        py::dict modules = py::module_::import("sys").attr("modules");
+        if (!modules.contains(session_name)) {
+            py::object session = py::module_::import("types").attr("ModuleType")(session_name);
+            py::exec(session_source, session.attr("__dict__"));
+            modules[session_name] = session;
+        }
+        return modules[session_name];
     }
 
-    [[nodiscard]] auto Probs(const std::string &circuit, const std::string &device, size_t shots,
-                             size_t num_qubits, const std::string &kwargs = "") const
-        -> std::vector<double> override
+    /**
+     * @brief Call a function of the session module, turning Python errors into runtime errors.
+     */
+    template <typename... ArgsT>
+    [[nodiscard]] static auto call(const char *name, ArgsT &&...args) -> pybind11::object
     {
-        std::lock_guard<std::mutex> lock(runner_mu);
         namespace py = pybind11;
-        using namespace py::literals;
 
         RT_FAIL_IF(!Py_IsInitialized(), "The Python interpreter is not initialized");
 
-        auto locals =
-            py::dict("circuit"_a = circuit, "braket_device"_a = device, "kwargs"_a = kwargs,
-                     "shots"_a = shots, "num_qubits"_a = num_qubits, "msg"_a = "");
-
-        py::exec(
-            R"(
-            from braket.aws import AwsDevice
-            from braket.devices import LocalSimulator
-            from braket.ir.openqasm import Program as OpenQasmProgram
+        try {
+            return getSession().attr(name)(std::forward<ArgsT>(args)...);
+        }
+        catch (py::error_already_set &e) {
+            RT_FAIL(e.what());
+        }
+        return {};
+    }
 
-            try:
-                if braket_device in ["default", "braket_sv", "braket_dm"]:
-                    device = LocalSimulator(braket_device)
-                elif "arn:aws:braket" in braket_device:
-                    device = AwsDevice(braket_device)
-                else:
-                    raise ValueError(
-                        "device must be either 'braket.devices.LocalSimulator' or 'braket.aws.AwsDevice'"
-                    )
-                if kwargs != "":
-                    kwargs = kwargs.replace("'", "")
-                    kwargs = kwargs[1:-1].split(", ") if kwargs[0] == "(" else kwargs.split(", ")
-                    if len(kwargs) != 2:
-                        raise ValueError(
-                            "s3_destination_folder must be of size 2 with a 'bucket' and 'key' respectively."
-                        )
-                    result = device.run(
-                        OpenQasmProgram(source=circuit),
-                        shots=int(shots),
-                        s3_destination_folder=tuple(kwargs),
-                    ).result()
-                else:
-                    result = device.run(OpenQasmProgram(source=circuit), shots=int(shots)).result()
-                probs_dict = {int(s, 2): p for s, p in result.measurement_probabilities.items()}
-                probs_list = []
-                for i in range(2 ** int(num_qubits)):
-                    probs_list.append(probs_dict[i] if i in probs_dict else 0)
-            except Exception as e:
-                print(f"circuit: {circuit}")
-                msg = str(e)
-              )",
-            py::globals(), locals);
+    template <typename T> [[nodiscard]] static auto toVector(pybind11::handle obj) -> std::vector<T>
+    {
+        namespace py = pybind11;
 
-        auto &&msg = locals["msg"].cast<std::string>();
-        RT_FAIL_IF(!msg.empty(), msg.c_str());
+        auto array = py::array_t<T, py::array::c_style | py::array::forcecast>::ensure(obj);
+        RT_FAIL_IF(!array, "Invalid result array");
+        return std::vector<T>(array.data(), array.data() + array.size());
+    }
 
-        py::list results = locals["probs_list"];
+    [[nodiscard]] static auto toDict(const std::unordered_map<std::string, double> &inputs)
+        -> pybind11::dict
+    {
+        namespace py = pybind11;
 
-        std::vector<double> probs;
-        probs.reserve(std::pow(2, num_qubits));
-        for (py::handle item : results) {
-            probs.push_back(item.cast<double>());
+        py::dict py_inputs;
+        for (const auto &[name, value] : inputs) {
+            py_inputs[py::str(name)] = value;
         }
-
-        return probs;
+        return py_inputs;
     }
 
-    [[nodiscard]] auto Sample(const std::string &circuit, const std::string &device, size_t shots,
-                              size_t num_qubits, const std::string &kwargs = "") const
-        -> std::vector<size_t> override
+    [[nodiscard]] static auto toBatchResults(pybind11::handle output) -> BatchResults
     {
-        std::lock_guard<std::mutex> lock(runner_mu);
         namespace py = pybind11;
-        using namespace py::literals;
 
-        RT_FAIL_IF(!Py_IsInitialized(), "The Python interpreter is not initialized");
+        auto &&tuple = output.cast<py::tuple>();
 
-        auto locals = py::dict("circuit"_a = circuit, "braket_device"_a = device,
-                               "kwargs"_a = kwargs, "shots"_a = shots, "msg"_a = "");
+        BatchResults results;
+        for (py::handle value : tuple[0].cast<py::list>()) {
+            results.values.push_back(toVector<double>(value));
+        }
+        results.samples = toVector<size_t>(tuple[1]);
+        return results;
+    }
 
-        py::exec(
-            R"(
-            import numpy as np
-            from braket.aws import AwsDevice
-            from braket.devices import LocalSimulator
-            from braket.ir.openqasm import Program as OpenQasmProgram
+    /**
+     * A circuit submitted to a Braket device. The job is queued until a
+     * consumer of its results, or of the results of any other queued job,
+     * flushes the queue; the task id or the submission error is then set.
+     */
+    struct Job {
+        const std::string circuit;
+        const std::string device;
+        const size_t shots;
+        const std::string kwargs;
+        const std::unordered_map<std::string, double> inputs;
+        std::optional<size_t> task{};
+        std::exception_ptr error{};
+    };
+
+    // The jobs submitted since the last flush, guarded by runner_mu
+    inline static std::vector<std::shared_ptr<Job>> queue{};
+
+    // The time between two checks of the state of a submitted task
+    static constexpr std::chrono::milliseconds poll_interval{10};
+
+    /**
+     * @brief Submit the queued jobs in batches of the same device, shots and
+     * kwargs, so that the jobs of concurrent executions are sent together.
+     *
+     * @note It must be called with a `SessionLock`.
+     */
+    static void flush()
+    {
+        namespace py = pybind11;
 
-            try:
-                if braket_device in ["default", "braket_sv", "braket_dm"]:
-                    device = LocalSimulator(braket_device)
-                elif "arn:aws:braket" in braket_device:
-                    device = AwsDevice(braket_device)
-                else:
-                    raise ValueError(
-                        "device must be either 'braket.devices.LocalSimulator' or 'braket.aws.AwsDevice'"
-                    )
-                if kwargs != "":
-                    kwargs = kwargs.replace("'", "")
-                    kwargs = kwargs[1:-1].split(", ") if kwargs[0] == "(" else kwargs.split(", ")
-                    if len(kwargs) != 2:
-                        raise ValueError(
-                            "s3_destination_folder must be of size 2 with a 'bucket' and 'key' respectively."
-                        )
-                    result = device.run(
-                        OpenQasmProgram(source=circuit),
-                        shots=int(shots),
-                        s3_destination_folder=tuple(kwargs),
-                    ).result()
-                else:
-                    result = device.run(OpenQasmProgram(source=circuit), shots=int(shots)).result()
-                samples = np.array(result.measurements).flatten()
-            except Exception as e:
-                print(f"circuit: {circuit}")
-                msg = str(e)
-              )",
-            py::globals(), locals);
+        while (!queue.empty()) {
+            const auto head = queue.front();
+            auto &&batch_end =
+                std::stable_partition(queue.begin(), queue.end(), [&head](const auto &job) {
+                    return job->device == head->device && job->shots == head->shots &&
+                           job->kwargs == head->kwargs;
+                });
+            std::vector<std::shared_ptr<Job>> batch(queue.begin(), batch_end);
+            queue.erase(queue.begin(), batch_end);
+
+            try {
+                py::list circuits;
+                py::list inputs;
+                for (const auto &job : batch) {
+                    circuits.append(job->circuit);
+                    inputs.append(toDict(job->inputs));
+                }
+
+                auto &&ids =
+                    call("submit_batch", circuits, head->device, head->shots, head->kwargs, inputs)
+                        .cast<py::list>();
+                RT_FAIL_IF(ids.size() != batch.size(), "Invalid number of submitted tasks");
+                for (size_t idx = 0; idx < batch.size(); idx++) {
+                    batch[idx]->task = ids[idx].cast<size_t>();
+                }
+            }
+            catch (...) {
+                for (const auto &job : batch) {
+                    job->error = std::current_exception();
+                }
+            }
+        }
+    }
 
-        auto &&msg = locals["msg"].cast<std::string>();
-        RT_FAIL_IF(!msg.empty(), msg.c_str());
+    /**
+     * @brief Wait for the results of a job, releasing the session lock between
+     * two checks of its state so that other jobs can be submitted and collected,
+     * and the local simulations can run.
+     */
+    [[nodiscard]] static auto wait(const std::shared_ptr<Job> &job) -> BatchResults
+    {
+        while (true) {
+            {
+                SessionLock lock;
+                if (!job->task.has_value() && !job->error) {
+                    flush();
+                }
+                if (job->error) {
+                    std::rethrow_exception(job->error);
+                }
+                if (call("done", *job->task).cast<bool>()) {
+                    return toBatchResults(call("collect", *job->task, job->shots));
+                }
+            }
+            // A thread of the interpreter, e.g. the one embedding it, keeps the
+            // GIL after the session lock and must release it while sleeping.
+            if (PyGILState_Check()) {
+                pybind11::gil_scoped_release release;
+                std::this_thread::sleep_for(poll_interval);
+            }
+            else {
+                std::this_thread::sleep_for(poll_interval);
+            }
+        }
+    }
 
-        py::list results = locals["samples"];
+  public:
+    [[nodiscard]] auto runCircuit(const std::string &circuit, const std::string &device,
+                                  size_t shots, const std::string &kwargs = "") const
+        -> std::string override
+    {
+        SessionLock lock;
+        return call("run_circuit", circuit, device, shots, kwargs).cast<std::string>();
+    }
 
-        std::vector<size_t> samples;
-        samples.reserve(shots * num_qubits);
-        for (py::handle item : results) {
-            samples.push_back(item.cast<size_t>());
-        }
+    [[nodiscard]] auto Probs(const std::string &circuit, const std::string &device, size_t shots,
+                             size_t num_qubits, const std::string &kwargs = "") const
+        -> std::vector<double> override
+    {
+        SessionLock lock;
+        return toVector<double>(call("probs", circuit, device, shots, kwargs, num_qubits));
+    }
 
-        return samples;
+    [[nodiscard]] auto Sample(const std::string &circuit, const std::string &device, size_t shots,
+                              [[maybe_unused]] size_t num_qubits,
+                              const std::string &kwargs = "") const
+        -> std::vector<size_t> override
+    {
+        SessionLock lock;
+        return toVector<size_t>(call("sample", circuit, device, shots, kwargs));
     }
 
     [[nodiscard]] auto Expval(const std::string &circuit, const std::string &device, size_t shots,
                               const std::string &kwargs = "") const -> double override
     {
-        std::lock_guard<std::mutex> lock(runner_mu);
-        namespace py = pybind11;
-        using namespace py::literals;
-
-        RT_FAIL_IF(!Py_IsInitialized(), "The Python interpreter is not initialized");
+        SessionLock lock;
+        return call("value", circuit, device, shots, kwargs).cast<double>();
+    }
 
-        auto locals = py::dict("circuit"_a = circuit, "braket_device"_a = device,
-                               "kwargs"_a = kwargs, "shots"_a = shots, "msg"_a = "");
+    [[nodiscard]] auto Var(const std::string &circuit, const std::string &device, size_t shots,
+                           const std::string &kwargs = "") const -> double override
+    {
+        SessionLock lock;
+        return call("value", circuit, device, shots, kwargs).cast<double>();
+    }
 
-        py::exec(
-            R"(
-            from braket.aws import AwsDevice
-            from braket.devices import LocalSimulator
-            from braket.ir.openqasm import Program as OpenQasmProgram
+    [[nodiscard]] auto Results(const std::string &circuit, const std::string &device,
+                               size_t shots, const std::string &kwargs = "",
+                               const std::unordered_map<std::string, double> &inputs = {}) const
+        -> BatchResults override
+    {
+        SessionLock lock;
+        return toBatchResults(call("results", circuit, device, shots, kwargs, toDict(inputs)));
+    }
 
-            try:
-                if braket_device in ["default", "braket_sv", "braket_dm"]:
-                    device = LocalSimulator(braket_device)
-                elif "arn:aws:braket" in braket_device:
-                    device = AwsDevice(braket_device)
-                else:
-                    raise ValueError(
-                        "device must be either 'braket.devices.LocalSimulator' or 'braket.aws.AwsDevice'"
-                    )
-                if kwargs != "":
-                    kwargs = kwargs.replace("'", "")
-                    kwargs = kwargs[1:-1].split(", ") if kwargs[0] == "(" else kwargs.split(", ")
-                    if len(kwargs) != 2:
-                        raise ValueError(
-                            "s3_destination_folder must be of size 2 with a 'bucket' and 'key' respectively."
-                        )
-                    result = device.run(
-                        OpenQasmProgram(source=circuit),
-                        shots=int(shots),
-                        s3_destination_folder=tuple(kwargs),
-                    ).result()
-                else:
-                    result = device.run(OpenQasmProgram(source=circuit), shots=int(shots)).result()
-                expval = result.values
-            except Exception as e:
-                print(f"circuit: {circuit}")
-                msg = str(e)
-              )",
-            py::globals(), locals);
+    [[nodiscard]] auto Submit(const std::string &circuit, const std::string &device, size_t shots,
+                              const std::string &kwargs = "",
+                              const std::unordered_map<std::string, double> &inputs = {}) const
+        -> std::future<BatchResults> override
+    {
+        auto job = std::make_shared<Job>(Job{circuit, device, shots, kwargs, inputs});
+        {
+            auto &&lock = lockRunner();
+            queue.push_back(job);
+        }
+        return std::async(std::launch::deferred, [job]() { return wait(job); });
+    }
+};
 
-        auto &&msg = locals["msg"].cast<std::string>();
-        RT_FAIL_IF(!msg.empty(), msg.c_str());
+/**
+ * The OpenQasm circuit runner to execute an OpenQasm circuit natively on the
+ * in-process state-vector of `QasmExecutor`, without the Python interpreter.
+ */
+struct NativeRunner : public OpenQasmRunner {
+  private:
+    [[nodiscard]] static auto run(const std::string &circuit, size_t shots,
+                                  const std::unordered_map<std::string, double> &inputs = {})
+        -> QasmExecutionResults
+    {
+        QasmExecutor executor{inputs};
+        return executor.run(circuit, shots);
+    }
 
-        py::list results = locals["expval"];
+    [[nodiscard]] static auto getValue(QasmExecutionResults &&results) -> double
+    {
+        RT_FAIL_IF(results.values.size() != 1 || results.values[0].size() != 1,
+                   "Invalid number of result values");
+        return results.values[0][0];
+    }
 
-        return results[0].cast<double>();
+  public:
+    [[nodiscard]] auto runCircuit(const std::string &circuit,
+                                  [[maybe_unused]] const std::string &device, size_t shots,
+                                  [[maybe_unused]] const std::string &kwargs = "") const
+        -> std::string override
+    {
+        auto &&results = run(circuit, shots);
+
+        std::ostringstream oss;
+        oss << "values: [";
+        for (size_t idx = 0; idx < results.values.size(); idx++) {
+            oss << (idx ? ", [" : "[");
+            for (size_t k = 0; k < results.values[idx].size(); k++) {
+                oss << (k ? ", " : "") << results.values[idx][k];
+            }
+            oss << "]";
+        }
+        oss << "], qubits: " << results.state.getNumQubits() << ", shots: " << shots;
+        return oss.str();
     }
 
-    [[nodiscard]] auto Var(const std::string &circuit, const std::string &device, size_t shots,
-                           const std::string &kwargs = "") const -> double override
+    [[nodiscard]] auto Probs(const std::string &circuit, [[maybe_unused]] const std::string &device,
+                             size_t shots, size_t num_qubits,
+                             [[maybe_unused]] const std::string &kwargs = "") const
+        -> std::vector<double> override
     {
-        std::lock_guard<std::mutex> lock(runner_mu);
-        namespace py = pybind11;
-        using namespace py::literals;
+        auto &&results = run(circuit, shots);
+        RT_FAIL_IF(results.state.getNumQubits() != num_qubits, "Invalid number of qubits");
 
-        RT_FAIL_IF(!Py_IsInitialized(), "The Python interpreter is not initialized");
+        if (shots == 0) {
+            std::vector<size_t> wires(num_qubits);
+            std::iota(wires.begin(), wires.end(), 0);
+            return results.state.probs(wires);
+        }
 
-        auto locals = py::dict("circuit"_a = circuit, "braket_device"_a = device,
-                               "kwargs"_a = kwargs, "shots"_a = shots, "msg"_a = "");
+        // Estimate the probabilities from the samples, as with Braket devices
+        std::vector<size_t> counts(1UL << num_qubits, 0);
+        for (size_t shot = 0; shot < shots; shot++) {
+            size_t idx = 0;
+            for (size_t wire = 0; wire < num_qubits; wire++) {
+                idx = (idx << 1) | results.samples[shot * num_qubits + wire];
+            }
+            counts[idx]++;
+        }
 
-        py::exec(
-            R"(
-            from braket.aws import AwsDevice
-            from braket.devices import LocalSimulator
-            from braket.ir.openqasm import Program as OpenQasmProgram
+        std::vector<double> probs(counts.size());
+        std::transform(counts.begin(), counts.end(), probs.begin(), [shots](size_t count) {
+            return static_cast<double>(count) / static_cast<double>(shots);
+        });
+        return probs;
+    }
 
-            try:
-                if braket_device in ["default", "braket_sv", "braket_dm"]:
-                    device = LocalSimulator(braket_device)
-                elif "arn:aws:braket" in braket_device:
-                    device = AwsDevice(braket_device)
-                else:
-                    raise ValueError(
-                        "device must be either 'braket.devices.LocalSimulator' or 'braket.aws.AwsDevice'"
-                    )
-                if kwargs != "":
-                    kwargs = kwargs.replace("'", "")
-                    kwargs = kwargs[1:-1].split(", ") if kwargs[0] == "(" else kwargs.split(", ")
-                    if len(kwargs) != 2:
-                        raise ValueError(
-                            "s3_destination_folder must be of size 2 with a 'bucket' and 'key' respectively."
-                        )
-                    result = device.run(
-                        OpenQasmProgram(source=circuit),
-                        shots=int(shots),
-                        s3_destination_folder=tuple(kwargs),
-                    ).result()
-                else:
-                    result = device.run(OpenQasmProgram(source=circuit), shots=int(shots)).result()
-                var = result.values
-            except Exception as e:
-                print(f"circuit: {circuit}")
-                msg = str(e)
-              )",
-            py::globals(), locals);
+    [[nodiscard]] auto Sample(const std::string &circuit,
+                              [[maybe_unused]] const std::string &device, size_t shots,
+                              [[maybe_unused]] size_t num_qubits,
+                              [[maybe_unused]] const std::string &kwargs = "") const
+        -> std::vector<size_t> override
+    {
+        return run(circuit, shots).samples;
+    }
+
+    [[nodiscard]] auto Expval(const std::string &circuit,
+                              [[maybe_unused]] const std::string &device, size_t shots,
+                              [[maybe_unused]] const std::string &kwargs = "") const
+        -> double override
+    {
+        return getValue(run(circuit, shots));
+    }
+
+    [[nodiscard]] auto Var(const std::string &circuit, [[maybe_unused]] const std::string &device,
+                           size_t shots, [[maybe_unused]] const std::string &kwargs = "") const
+        -> double override
+    {
+        return getValue(run(circuit, shots));
+    }
 
-        auto &&msg = locals["msg"].cast<std::string>();
-        RT_FAIL_IF(!msg.empty(), msg.c_str());
+    [[nodiscard]] auto State(const std::string &circuit,
+                             [[maybe_unused]] const std::string &device, size_t shots,
+                             size_t num_qubits,
+                             [[maybe_unused]] const std::string &kwargs = "") const
+        -> std::vector<std::complex<double>> override
+    {
+        auto &&results = run(circuit, shots);
+        RT_FAIL_IF(results.state.getNumQubits() != num_qubits, "Invalid number of qubits");
+        return results.state.getData();
+    }
 
-        py::list results = locals["var"];
+    [[nodiscard]] auto Results(const std::string &circuit,
+                               [[maybe_unused]] const std::string &device, size_t shots,
+                               [[maybe_unused]] const std::string &kwargs = "",
+                               const std::unordered_map<std::string, double> &inputs = {}) const
+        -> BatchResults override
+    {
+        auto &&results = run(circuit, shots, inputs);
+        return BatchResults{std::move(results.values), std::move(results.samples)};
+    }
 
-        return results[0].cast<double>();
+    [[nodiscard]] auto Submit(const std::string &circuit,
+                              [[maybe_unused]] const std::string &device, size_t shots,
+                              [[maybe_unused]] const std::string &kwargs = "",
+                              const std::unordered_map<std::string, double> &inputs = {}) const
+        -> std::future<BatchResults> override
+    {
+        // Executions of concurrent devices run on their own threads
+        return std::async(std::launch::async, [circuit, shots, inputs]() {
+            auto &&results = run(circuit, shots, inputs);
+            return BatchResults{std::move(results.values), std::move(results.samples)};
+        });
     }
 };
 
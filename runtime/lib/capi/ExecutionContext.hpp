@@ -15,6 +15,7 @@
 #include <dlfcn.h>
 
 #include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -22,6 +23,7 @@
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #if __has_include("pybind11/embed.h")
 #include <pybind11/embed.h>
@@ -169,6 +171,11 @@ class SharedLibraryManager final {
         dlclose(_handler);
     }
 
+    [[nodiscard]] auto hasSymbol(const std::string &symbol) -> bool
+    {
+        return dlsym(_handler, symbol.c_str()) != nullptr;
+    }
+
     void *getSymbol(const std::string &symbol)
     {
         void *sym = dlsym(_handler, symbol.c_str());
@@ -233,12 +240,33 @@ class RTDevice {
                 (rtd_lib == "lightning.qubit") ? "LightningSimulator" : "LightningKokkosSimulator";
             _complete_dylib_os_extension(rtd_lib, "lightning");
         }
-        else if (rtd_lib == "braket.aws.qubit" || rtd_lib == "braket.local.qubit") {
+        else if (rtd_lib == "lightning.trajectory") {
+            rtd_name = "LightningTrajectorySimulator";
+            _complete_dylib_os_extension(rtd_lib, "lightning");
+        }
+        else if (rtd_lib == "braket.aws.qubit" || rtd_lib == "braket.local.qubit" ||
+                 rtd_lib == "openqasm.local.qubit") {
             rtd_name = "OpenQasmDevice";
             _complete_dylib_os_extension(rtd_lib, "openqasm");
         }
     }
 
+    // The device name may list alternatives separated by '|', in order of preference, e.g. when
+    // the compiler selected a backend that might not be built into the library. The first device
+    // provided by the library is then used.
+    [[nodiscard]] auto _select_device_name() const -> std::string
+    {
+        std::string_view names{rtd_name};
+        for (size_t pos = names.find('|'); pos != std::string_view::npos; pos = names.find('|')) {
+            std::string name{names.substr(0, pos)};
+            if (rtd_dylib->hasSymbol(name + "Factory")) {
+                return name;
+            }
+            names.remove_prefix(pos + 1);
+        }
+        return std::string{names};
+    }
+
   public:
     explicit RTDevice(std::string _rtd_lib, std::string _rtd_name = {},
                       std::string _rtd_kwargs = {})
@@ -270,7 +298,7 @@ class RTDevice {
         }
 
         rtd_dylib = std::make_unique<SharedLibraryManager>(rtd_lib);
-        std::string factory_name{rtd_name + "Factory"};
+        std::string factory_name{_select_device_name() + "Factory"};
         void *f_ptr = rtd_dylib->getSymbol(factory_name);
         rtd_qdevice = std::unique_ptr<QuantumDevice>(
             f_ptr ? reinterpret_cast<decltype(GenericDeviceFactory) *>(f_ptr)(rtd_kwargs.c_str())
@@ -304,6 +332,10 @@ class ExecutionContext final {
     std::vector<std::shared_ptr<RTDevice>> device_pool;
     std::mutex pool_mu; // To protect device_pool
 
+    // Devices being prepared in the background
+    std::vector<std::future<void>> prefetches;
+    std::mutex prefetch_mu; // To protect prefetches
+
     bool initial_tape_recorder_status;
 
     // ExecutionContext pointers
@@ -316,7 +348,7 @@ class ExecutionContext final {
         memory_man_ptr = std::make_unique<MemoryManager>();
     }
 
-    ~ExecutionContext() = default;
+    ~ExecutionContext() { waitForPrefetches(); }
 
     void setDeviceRecorderStatus(bool status) noexcept { initial_tape_recorder_status = status; }
 
@@ -330,10 +362,59 @@ class ExecutionContext final {
         return memory_man_ptr;
     }
 
+    /**
+     * @brief Prepare a device in the background, ahead of its initialization.
+     *
+     * The device library is opened and the device constructed on a worker thread, and the device
+     * is added to the pool as an inactive device, which the first request of a device with the
+     * same specifications then reuses. Failures are left to be reported by that request.
+     *
+     * @note The Python interpreter of the OpenQasmDevice is started on the calling thread, which
+     * then holds the GIL as when the interpreter is started by the device initialization.
+     */
+    void prefetchDevice(std::string_view rtd_lib, std::string_view rtd_name,
+                        std::string_view rtd_kwargs)
+    {
+        auto device = std::make_shared<RTDevice>(rtd_lib, rtd_name, rtd_kwargs);
+
+#ifdef __build_with_pybind11
+        {
+            std::lock_guard<std::mutex> lock(pool_mu);
+            if (!py_guard && device->getDeviceName() == "OpenQasmDevice" && !Py_IsInitialized()) {
+                py_guard = std::make_unique<PythonInterpreterGuard>(); // LCOV_EXCL_LINE
+            }
+        }
+#endif
+
+        std::lock_guard<std::mutex> lock(prefetch_mu);
+        prefetches.push_back(std::async(std::launch::async, [this, device]() {
+            if (!device->getQuantumDevicePtr()) {
+                return;
+            }
+            std::lock_guard<std::mutex> pool_lock(pool_mu);
+            device_pool.push_back(device);
+        }));
+    }
+
+    /**
+     * @brief Wait for the devices being prepared in the background.
+     */
+    void waitForPrefetches()
+    {
+        std::lock_guard<std::mutex> lock(prefetch_mu);
+        for (auto &prefetch : prefetches) {
+            // The errors of a prefetch are dropped
+            prefetch.wait();
+        }
+        prefetches.clear();
+    }
+
     [[nodiscard]] auto getOrCreateDevice(std::string_view rtd_lib, std::string_view rtd_name,
                                          std::string_view rtd_kwargs)
         -> const std::shared_ptr<RTDevice> &
     {
+        waitForPrefetches();
+
         std::lock_guard<std::mutex> lock(pool_mu);
 
         auto device = std::make_shared<RTDevice>(rtd_lib, rtd_name, rtd_kwargs);
@@ -190,6 +190,16 @@ void __quantum__rt__device_init(int8_t *rtd_lib, int8_t *rtd_name, int8_t *rtd_k
     }
 }
 
+void __quantum__rt__device_prefetch(int8_t *rtd_lib, int8_t *rtd_name, int8_t *rtd_kwargs)
+{
+    RT_FAIL_IF(!rtd_lib, "Invalid device library");
+    RT_FAIL_IF(!Catalyst::Runtime::CTX, "Invalid use of the global driver before initialization");
+
+    Catalyst::Runtime::CTX->prefetchDevice(
+        reinterpret_cast<char *>(rtd_lib), (rtd_name ? reinterpret_cast<char *>(rtd_name) : ""),
+        (rtd_kwargs ? reinterpret_cast<char *>(rtd_kwargs) : ""));
+}
+
 void __quantum__rt__device_release()
 {
     RT_FAIL_IF(!Catalyst::Runtime::CTX,
@@ -215,6 +225,28 @@ void __quantum__rt__toggle_recorder(bool status)
     }
 }
 
+void __quantum__rt__toggle_template(int64_t id, bool status)
+{
+    if (status) {
+        Catalyst::Runtime::getQuantumDevicePtr()->StartTemplateRecording(id);
+    }
+    else {
+        Catalyst::Runtime::getQuantumDevicePtr()->StopTemplateRecording();
+    }
+}
+
+bool __quantum__rt__replay(int64_t id, MemRefT_double_1d *params)
+{
+    std::vector<double> values;
+    if (params != nullptr) {
+        DataView<double, 1> view(params->data_aligned, params->offset, params->sizes,
+                                 params->strides);
+        values.assign(view.begin(), view.end());
+    }
+
+    return Catalyst::Runtime::getQuantumDevicePtr()->Replay(id, values);
+}
+
 QUBIT *__quantum__rt__qubit_allocate()
 {
     RT_ASSERT(Catalyst::Runtime::getQuantumDevicePtr() != nullptr);
@@ -583,6 +615,36 @@ void __quantum__qis__MultiRZ(double theta, bool adjoint, int64_t numQubits, ...)
                                                              /* inverse = */ adjoint);
 }
 
+void __quantum__qis__QFT(bool adjoint, int64_t numQubits, ...)
+{
+    RT_ASSERT(numQubits >= 0);
+
+    va_list args;
+    va_start(args, numQubits);
+    std::vector<QubitIdType> wires(numQubits);
+    for (int64_t i = 0; i < numQubits; i++) {
+        wires[i] = va_arg(args, QubitIdType);
+    }
+    va_end(args);
+
+    Catalyst::Runtime::getQuantumDevicePtr()->QFT(wires, /* inverse = */ adjoint);
+}
+
+void __quantum__qis__ReflectUniform(bool adjoint, int64_t numQubits, ...)
+{
+    RT_ASSERT(numQubits >= 0);
+
+    va_list args;
+    va_start(args, numQubits);
+    std::vector<QubitIdType> wires(numQubits);
+    for (int64_t i = 0; i < numQubits; i++) {
+        wires[i] = va_arg(args, QubitIdType);
+    }
+    va_end(args);
+
+    Catalyst::Runtime::getQuantumDevicePtr()->ReflectUniform(wires, /* inverse = */ adjoint);
+}
+
 static void _qubitUnitary_impl(MemRefT_CplxT_double_2d *matrix, int64_t numQubits,
                                std::vector<std::complex<double>> &coeffs,
                                std::vector<QubitIdType> &wires, va_list *args)
@@ -270,3 +270,74 @@ TEST_CASE("Test __quantum__qis__ circuit with observables using deactiveCacheMan
     }
     __quantum__rt__finalize();
 }
+
+TEST_CASE("Test __quantum__rt__replay of a recorded template", "[CacheManager]")
+{
+    constexpr int64_t template_id = 7;
+    const std::vector<std::vector<double>> all_params{{0.2, 0.4}, {0.7, -0.3}, {1.3, 2.1}};
+
+    __quantum__rt__initialize();
+    for (const auto &[rtd_lib, rtd_name, rtd_kwargs] : getDevices()) {
+        size_t num_replays = 0;
+        for (auto params : all_params) {
+            __quantum__rt__device_init((int8_t *)rtd_lib.c_str(), (int8_t *)rtd_name.c_str(),
+                                       (int8_t *)rtd_kwargs.c_str());
+
+            QirArray *qs = __quantum__rt__qubit_allocate_array(2);
+            QUBIT **q0 = (QUBIT **)__quantum__rt__array_get_element_ptr_1d(qs, 0);
+            QUBIT **q1 = (QUBIT **)__quantum__rt__array_get_element_ptr_1d(qs, 1);
+
+            MemRefT_double_1d params_memref = {params.data(), params.data(), 0, {params.size()},
+                                               {1}};
+            if (__quantum__rt__replay(template_id, &params_memref)) {
+                num_replays++;
+            }
+            else {
+                __quantum__rt__toggle_template(template_id, true);
+                __quantum__qis__RX(params[0], *q0, false);
+                __quantum__qis__CNOT(*q0, *q1, false);
+                __quantum__qis__RY(params[1], *q1, false);
+                __quantum__rt__toggle_template(template_id, false);
+            }
+
+            auto obs = __quantum__qis__NamedObs(ObsId::PauliZ, *q1);
+            CHECK(__quantum__qis__Expval(obs) ==
+                  Approx(std::cos(params[0]) * std::cos(params[1])).margin(1e-5));
+
+            __quantum__rt__qubit_release_array(qs);
+            __quantum__rt__device_release();
+        }
+
+        if (rtd_name == "lightning.qubit") {
+            CHECK(num_replays == all_params.size() - 1);
+        }
+    }
+    __quantum__rt__finalize();
+}
+
+TEST_CASE("Test templates with mid-circuit measurements are not replayed", "[CacheManager]")
+{
+    constexpr int64_t template_id = 8;
+    std::vector<double> params{0.5};
+    MemRefT_double_1d params_memref = {params.data(), params.data(), 0, {params.size()}, {1}};
+
+    __quantum__rt__initialize();
+    for (const auto &[rtd_lib, rtd_name, rtd_kwargs] : getDevices()) {
+        __quantum__rt__device_init((int8_t *)rtd_lib.c_str(), (int8_t *)rtd_name.c_str(),
+                                   (int8_t *)rtd_kwargs.c_str());
+
+        QUBIT *q = __quantum__rt__qubit_allocate();
+
+        REQUIRE_FALSE(__quantum__rt__replay(template_id, &params_memref));
+        __quantum__rt__toggle_template(template_id, true);
+        __quantum__qis__RX(params[0], q, false);
+        __quantum__qis__Measure(q);
+        __quantum__rt__toggle_template(template_id, false);
+
+        CHECK_FALSE(__quantum__rt__replay(template_id, &params_memref));
+
+        __quantum__rt__qubit_release(q);
+        __quantum__rt__device_release();
+    }
+    __quantum__rt__finalize();
+}
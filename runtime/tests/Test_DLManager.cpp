@@ -63,6 +63,48 @@ TEST_CASE("Test success of loading dummy device", "[Third Party]")
     CHECK(loadDevice("DummyDevice", "libdummy_device" + get_dylib_ext()));
 }
 
+TEST_CASE("Test loading the first available device of a list of alternatives", "[Third Party]")
+{
+    const std::string file{"libdummy_device" + get_dylib_ext()};
+
+    RTDevice device(file, "MissingDevice|DummyDevice");
+    CHECK(device.getQuantumDevicePtr());
+
+#ifdef __linux__
+    RTDevice missing(file, "MissingDevice|OtherMissingDevice");
+    REQUIRE_THROWS_WITH(missing.getQuantumDevicePtr(),
+                        Catch::Contains("undefined symbol: OtherMissingDeviceFactory"));
+#endif
+}
+
+TEST_CASE("Test reusing the devices prefetched in the background", "[CoreQIS]")
+{
+    std::unique_ptr<ExecutionContext> driver = std::make_unique<ExecutionContext>();
+
+    const std::string lib{"lightning.qubit"};
+    const std::string kwargs{"{shots: 0}"};
+    driver->prefetchDevice(lib, "", kwargs);
+    auto &&device = driver->getOrCreateDevice(lib, "", kwargs);
+    CHECK(device == driver->getDevice(0));
+    CHECK(device->getDeviceStatus() == RTDeviceStatus::Active);
+
+    // A failed prefetch is reported by the initialization of the device
+    const std::string other_lib{"backend.other"};
+    driver->prefetchDevice(other_lib, "", "");
+    REQUIRE_THROWS_WITH(driver->getOrCreateDevice(other_lib),
+                        Catch::Contains("cannot open shared object file"));
+
+    __quantum__rt__initialize();
+    char dev[16] = "lightning.qubit";
+    __quantum__rt__device_prefetch((int8_t *)dev, nullptr, nullptr);
+    __quantum__rt__device_init((int8_t *)dev, nullptr, nullptr);
+    __quantum__rt__device_release();
+    __quantum__rt__finalize();
+
+    REQUIRE_THROWS_WITH(__quantum__rt__device_prefetch((int8_t *)dev, nullptr, nullptr),
+                        Catch::Contains("Invalid use of the global driver before initialization"));
+}
+
 TEST_CASE("Test __quantum__rt__device_init registering a custom device with shots=500 and "
           "device=lightning.qubit",
           "[CoreQIS]")
@@ -18,6 +18,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "DataView.hpp"
@@ -1932,3 +1933,39 @@ TEST_CASE("Test the main porperty of the adjoint quantum operations", "[CoreQIS]
         __quantum__rt__finalize();
     }
 }
+
+TEST_CASE("Test concurrent shot batches on pooled devices", "[CoreQIS]")
+{
+    constexpr size_t num_batches = 4;
+    const std::string rtd_lib = "lightning.qubit";
+    const std::string rtd_kwargs = "{shots: 10, shot_batches: 4}";
+
+    __quantum__rt__initialize();
+
+    // Each batch initializes a device of the same specifications on its own
+    // thread, and so runs on its own instance of the device pool.
+    std::array<bool, num_batches> outcomes{};
+    auto batch = [&](size_t idx) {
+        __quantum__rt__device_init((int8_t *)rtd_lib.c_str(), (int8_t *)rtd_lib.c_str(),
+                                   (int8_t *)rtd_kwargs.c_str());
+        QirArray *reg = __quantum__rt__qubit_allocate_array(2);
+        QUBIT *target =
+            *reinterpret_cast<QUBIT **>(__quantum__rt__array_get_element_ptr_1d(reg, 0));
+        __quantum__qis__PauliX(target, false);
+        outcomes[idx] = __quantum__rt__result_equal(__quantum__qis__Measure(target),
+                                                    __quantum__rt__result_get_one());
+        __quantum__rt__qubit_release_array(reg);
+        __quantum__rt__device_release();
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t idx = 0; idx < num_batches; idx++) {
+        threads.emplace_back(batch, idx);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    __quantum__rt__finalize();
+
+    CHECK(std::all_of(outcomes.begin(), outcomes.end(), [](bool outcome) { return outcome; }));
+}
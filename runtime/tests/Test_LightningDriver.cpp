@@ -13,6 +13,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <filesystem>
 #include <numeric>
 #include <string>
 
@@ -251,3 +252,49 @@ TEMPLATE_TEST_CASE("QuantumDevice object test [lightning.qubit]", "[Driver]", Li
         // 20, 21, ..., 29
     }
 }
+
+TEST_CASE("Autotuned kernel profile [lightning.qubit]", "[Driver]")
+{
+    const std::string profile =
+        std::filesystem::temp_directory_path() / "catalyst_test_lightning_kernels.profile";
+    std::filesystem::remove(profile);
+
+    auto apply_circuit = [](LightningSimulator &sim) {
+        std::vector<QubitIdType> Qs = sim.AllocateQubits(4);
+        sim.NamedOperation("Hadamard", {}, {Qs[0]}, false);
+        sim.NamedOperation("CNOT", {}, {Qs[0], Qs[3]}, false);
+        sim.NamedOperation("RX", {0.3}, {Qs[3]}, false);
+        sim.NamedOperation("CRY", {0.7}, {Qs[3], Qs[1]}, false);
+
+        std::vector<std::complex<double>> state(1U << sim.GetNumQubits());
+        DataView<std::complex<double>, 1> view(state);
+        sim.State(view);
+        return state;
+    };
+
+    LightningSimulator reference{};
+    auto expected = apply_circuit(reference);
+
+    // Autotuning measures every gate on first use, on a scratch state-vector that leaves the
+    // simulated state free of drift, and persists the profile with the device.
+    std::vector<std::complex<double>> result;
+    {
+        LightningSimulator tuned{"{autotune : True, kernel_profile : " + profile + "}"};
+        result = apply_circuit(tuned);
+        CHECK(!std::filesystem::exists(profile));
+    }
+    CHECK(std::filesystem::exists(profile));
+
+    // A later device loads the profile and dispatches with it.
+    LightningSimulator profiled{"{kernel_profile : " + profile + "}"};
+    auto loaded = apply_circuit(profiled);
+
+    for (size_t i = 0; i < expected.size(); i++) {
+        CHECK(result[i].real() == Approx(expected[i].real()).margin(1e-12));
+        CHECK(result[i].imag() == Approx(expected[i].imag()).margin(1e-12));
+        CHECK(loaded[i].real() == Approx(expected[i].real()).margin(1e-7));
+        CHECK(loaded[i].imag() == Approx(expected[i].imag()).margin(1e-7));
+    }
+
+    std::filesystem::remove(profile);
+}
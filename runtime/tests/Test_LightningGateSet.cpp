@@ -767,3 +767,60 @@ TEMPLATE_TEST_CASE("MatrixOperation test with 4-qubit", "[GateSet]", LightningSi
     CHECK(state[14].real() == Approx(0.0756372).epsilon(1e-5));
     CHECK(state[14].imag() == Approx(-0.226334).epsilon(1e-5));
 }
+
+TEMPLATE_LIST_TEST_CASE("QFT and ReflectUniform kernels match their decompositions", "[GateSet]",
+                        SimTypes)
+{
+    constexpr size_t n = 5;
+    std::unique_ptr<TestType> sim = std::make_unique<TestType>();
+    std::unique_ptr<TestType> ref = std::make_unique<TestType>();
+    const auto Qs = sim->AllocateQubits(n);
+    const auto Rs = ref->AllocateQubits(n);
+
+    auto prepare = [](TestType &device, const std::vector<QubitIdType> &wires) {
+        for (size_t i = 0; i < wires.size(); i++) {
+            device.NamedOperation("RX", {0.3 + 0.2 * i}, {wires[i]}, false);
+            device.NamedOperation("RY", {0.7 - 0.1 * i}, {wires[i]}, false);
+        }
+        device.NamedOperation("CNOT", {}, {wires[0], wires[3]}, false);
+    };
+    auto getState = [](TestType &device) {
+        std::vector<std::complex<double>> state(1U << device.GetNumQubits());
+        DataView<std::complex<double>, 1> view(state);
+        device.State(view);
+        return state;
+    };
+    auto checkStates = [&]() {
+        const auto state = getState(*sim);
+        const auto expected = getState(*ref);
+        for (size_t i = 0; i < state.size(); i++) {
+            CHECK(state[i].real() == Approx(expected[i].real()).margin(1e-10));
+            CHECK(state[i].imag() == Approx(expected[i].imag()).margin(1e-10));
+        }
+    };
+
+    prepare(*sim, Qs);
+    prepare(*ref, Rs);
+
+    SECTION("QFT")
+    {
+        sim->QFT({Qs[3], Qs[0], Qs[4], Qs[1]}, false);
+        ref->QuantumDevice::QFT({Rs[3], Rs[0], Rs[4], Rs[1]}, false);
+        checkStates();
+
+        sim->QFT({Qs[2], Qs[1]}, true);
+        ref->QuantumDevice::QFT({Rs[2], Rs[1]}, true);
+        checkStates();
+    }
+
+    SECTION("ReflectUniform")
+    {
+        for (size_t num_wires = 1; num_wires <= n; num_wires++) {
+            std::vector<QubitIdType> sim_wires(Qs.rbegin(), Qs.rbegin() + num_wires);
+            std::vector<QubitIdType> ref_wires(Rs.rbegin(), Rs.rbegin() + num_wires);
+            sim->ReflectUniform(sim_wires, false);
+            ref->QuantumDevice::ReflectUniform(ref_wires, false);
+            checkStates();
+        }
+    }
+}
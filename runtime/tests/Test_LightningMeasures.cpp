@@ -1696,3 +1696,308 @@ TEMPLATE_LIST_TEST_CASE("Counts and PartialCounts tests with numWires=0-4 shots=
     CHECK(sum3 == shots);
     CHECK(sum4 == shots);
 }
+
+TEST_CASE("Sample with parallel MCMC chains and thinning", "[Measures]")
+{
+    for (const std::string kernel : {"Local", "NonZeroRandom"}) {
+        std::unique_ptr<LightningSimulator> sim = std::make_unique<LightningSimulator>(
+            "{mcmc : True, num_burnin : 200, num_chains : 4, thinning : 2, kernel_name : " +
+            kernel + "}");
+
+        std::vector<QubitIdType> Qs = sim->AllocateQubits(2);
+        sim->NamedOperation("RX", {0.5}, {Qs[0]}, false);
+
+        size_t shots = 10001;
+        std::vector<double> samples(shots * 2);
+        MemRefT<double, 2> buffer{samples.data(), samples.data(), 0, {shots, 2}, {1, 1}};
+        DataView<double, 2> view(buffer.data_aligned, buffer.offset, buffer.sizes, buffer.strides);
+        sim->Sample(view, shots);
+
+        size_t ones = 0;
+        for (size_t shot = 0; shot < shots; shot++) {
+            CHECK(samples[shot * 2 + 1] == 0.);
+            ones += static_cast<size_t>(samples[shot * 2]);
+        }
+
+        const double expected = std::pow(std::sin(0.25), 2);
+        CHECK(static_cast<double>(ones) / static_cast<double>(shots) ==
+              Approx(expected).margin(0.03));
+        CHECK(sim->GetAcceptanceRate() > 0.);
+        CHECK(sim->GetAcceptanceRate() <= 1.);
+    }
+}
+
+TEST_CASE("Sample MCMC chains with a bounded number of threads", "[Measures]")
+{
+    // The amplitudes of RX(0.5) on the first of two qubits
+    const std::vector<std::complex<double>> data{
+        {std::cos(0.25), 0}, {0, 0}, {0, -std::sin(0.25)}, {0, 0}};
+    LightningMetropolisSampler<double> sampler(data.data(), 2, {"Local", 100, 5, 1, 1234});
+
+    // Every chain draws from its own stream, whatever the number of threads running them
+    std::vector<size_t> single(2 * 1001);
+    std::vector<size_t> parallel(2 * 1001);
+    const double single_rate = sampler.sample(single, 1);
+    const double parallel_rate = sampler.sample(parallel, 3);
+    CHECK(single == parallel);
+    CHECK(single_rate == parallel_rate);
+}
+
+TEST_CASE("Test MCMC sampling with an invalid number of chains", "[Measures]")
+{
+    std::unique_ptr<LightningSimulator> sim =
+        std::make_unique<LightningSimulator>("{mcmc : True, num_chains : 0}");
+    std::vector<QubitIdType> Qs = sim->AllocateQubits(1);
+
+    std::vector<double> samples(10);
+    MemRefT<double, 2> buffer{samples.data(), samples.data(), 0, {10, 1}, {1, 1}};
+    DataView<double, 2> view(buffer.data_aligned, buffer.offset, buffer.sizes, buffer.strides);
+    REQUIRE_THROWS_WITH(sim->Sample(view, 10), Catch::Contains("Invalid number of MCMC chains"));
+}
+
+TEST_CASE("Test memoized measurements of a state version", "[Measures]")
+{
+    std::unique_ptr<LightningSimulator> sim = std::make_unique<LightningSimulator>();
+
+    std::vector<QubitIdType> Qs = sim->AllocateQubits(3);
+    sim->NamedOperation("RX", {0.5}, {Qs[0]}, false);
+    sim->NamedOperation("Hadamard", {}, {Qs[2]}, false);
+    const size_t version = sim->GetStateVersion();
+
+    std::vector<double> probs(8);
+    DataView<double, 1> view(probs);
+    sim->Probs(view);
+
+    // Partial probabilities are marginalized from the full probabilities, in the given order
+    std::vector<double> partial_probs(4);
+    DataView<double, 1> partial_view(partial_probs);
+    sim->PartialProbs(partial_view, {Qs[2], Qs[0]});
+    CHECK(partial_probs[0] == Approx(0.5 * std::pow(std::cos(0.25), 2)).epsilon(1e-6));
+    CHECK(partial_probs[1] == Approx(0.5 * std::pow(std::sin(0.25), 2)).epsilon(1e-6));
+    CHECK(partial_probs[2] == Approx(0.5 * std::pow(std::cos(0.25), 2)).epsilon(1e-6));
+    CHECK(partial_probs[3] == Approx(0.5 * std::pow(std::sin(0.25), 2)).epsilon(1e-6));
+
+    // Repeated samples of a state version are served from the cache
+    constexpr size_t shots = 100;
+    std::vector<std::vector<double>> all_samples;
+    for (size_t run = 0; run < 2; run++) {
+        std::vector<double> samples(shots * 3);
+        MemRefT<double, 2> buffer{samples.data(), samples.data(), 0, {shots, 3}, {1, 1}};
+        DataView<double, 2> samples_view(buffer.data_aligned, buffer.offset, buffer.sizes,
+                                         buffer.strides);
+        sim->Sample(samples_view, shots);
+        all_samples.push_back(samples);
+    }
+    CHECK(all_samples[0] == all_samples[1]);
+
+    ObsIdType pz = sim->Observable(ObsId::PauliZ, {}, {Qs[0]});
+    CHECK(sim->Expval(pz) == Approx(std::cos(0.5)).epsilon(1e-6));
+    CHECK(sim->GetStateVersion() == version);
+
+    // Any gate invalidates the cached results
+    sim->NamedOperation("PauliX", {}, {Qs[0]}, false);
+    CHECK(sim->GetStateVersion() != version);
+    CHECK(sim->Expval(pz) == Approx(-std::cos(0.5)).epsilon(1e-6));
+
+    sim->Probs(view);
+    CHECK(probs[0] == Approx(0.5 * std::pow(std::sin(0.25), 2)).epsilon(1e-6));
+    CHECK(probs[4] == Approx(0.5 * std::pow(std::cos(0.25), 2)).epsilon(1e-6));
+}
+
+TEST_CASE("Test the marginal probabilities of a product state", "[Measures]")
+{
+    std::unique_ptr<LightningSimulator> sim = std::make_unique<LightningSimulator>();
+
+    const std::vector<double> angles{0.3, 0.7, 1.1};
+    std::vector<QubitIdType> Qs = sim->AllocateQubits(3);
+    for (size_t idx = 0; idx < 3; idx++) {
+        sim->NamedOperation("RY", {angles[idx]}, {Qs[idx]}, false);
+    }
+
+    // The probability of measuring qubit `idx` in the state |bit>
+    auto prob = [&angles](size_t idx, size_t bit) {
+        const double amplitude = bit ? std::sin(angles[idx] / 2) : std::cos(angles[idx] / 2);
+        return amplitude * amplitude;
+    };
+
+    for (const std::vector<size_t> &order :
+         std::vector<std::vector<size_t>>{{0}, {2}, {2, 0}, {1, 2}, {1, 2, 0}}) {
+        std::vector<QubitIdType> wires;
+        for (auto idx : order) {
+            wires.push_back(Qs[idx]);
+        }
+
+        std::vector<double> probs(1U << order.size());
+        DataView<double, 1> view(probs);
+        sim->PartialProbs(view, wires);
+
+        for (size_t bin = 0; bin < probs.size(); bin++) {
+            double expected = 1;
+            for (size_t pos = 0; pos < order.size(); pos++) {
+                expected *= prob(order[pos], (bin >> (order.size() - 1 - pos)) & 1U);
+            }
+            CHECK(probs[bin] == Approx(expected).epsilon(1e-6));
+        }
+    }
+}
+
+TEST_CASE("Test the parallel marginal probability kernel", "[Measures]")
+{
+    // A state large enough to be split between threads
+    constexpr size_t num_qubits = 18;
+    std::vector<std::complex<double>> state(size_t{1} << num_qubits);
+    double norm = 0;
+    for (size_t idx = 0; idx < state.size(); idx++) {
+        state[idx] = {std::cos(0.1 * static_cast<double>(idx)), std::sin(0.3 * static_cast<double>(idx))};
+        norm += std::norm(state[idx]);
+    }
+
+    for (const std::vector<size_t> &wires :
+         std::vector<std::vector<size_t>>{{0}, {17}, {17, 3}, {5, 0, 17}}) {
+        auto &&probs = computeMarginalProbs(state.data(), num_qubits, wires);
+
+        std::vector<double> expected(1U << wires.size(), 0);
+        for (size_t idx = 0; idx < state.size(); idx++) {
+            size_t bin = 0;
+            for (auto wire : wires) {
+                bin = (bin << 1) | ((idx >> (num_qubits - 1 - wire)) & 1U);
+            }
+            expected[bin] += std::norm(state[idx]) / norm;
+        }
+
+        REQUIRE(probs.size() == expected.size());
+        for (size_t bin = 0; bin < probs.size(); bin++) {
+            CHECK(probs[bin] / norm == Approx(expected[bin]).epsilon(1e-9));
+        }
+    }
+}
+
+TEST_CASE("Test size-adaptive multithreading of the state-vector", "[Measures]")
+{
+    std::unique_ptr<LightningSimulator> sim = std::make_unique<LightningSimulator>(
+        "{num_threads : 2, multithreading_threshold : 3}");
+
+    std::vector<QubitIdType> Qs = sim->AllocateQubits(2);
+    CHECK(!sim->IsMultithreaded());
+    sim->NamedOperation("RX", {0.5}, {Qs[0]}, false);
+    sim->NamedOperation("CNOT", {}, {Qs[0], Qs[1]}, false);
+
+    // Crossing the threshold keeps the state
+    QubitIdType q = sim->AllocateQubit();
+    CHECK(sim->IsMultithreaded());
+    sim->NamedOperation("CNOT", {}, {Qs[1], q}, false);
+
+    ObsIdType pz = sim->Observable(ObsId::PauliZ, {}, {q});
+    CHECK(sim->Expval(pz) == Approx(std::cos(0.5)).epsilon(1e-6));
+
+    std::vector<double> probs(2);
+    DataView<double, 1> view(probs);
+    sim->PartialProbs(view, {q});
+    CHECK(probs[0] == Approx(std::pow(std::cos(0.25), 2)).epsilon(1e-6));
+    CHECK(probs[1] == Approx(std::pow(std::sin(0.25), 2)).epsilon(1e-6));
+
+    sim->ReleaseAllQubits();
+    CHECK(!sim->IsMultithreaded());
+}
+
+TEST_CASE("Test the blocked application of queued gates", "[Measures]")
+{
+    // Blocks of 4 amplitudes split a 5-qubit state in 8 blocks between 2 threads
+    std::unique_ptr<LightningSimulator> blocked = std::make_unique<LightningSimulator>(
+        "{num_threads : 2, multithreading_threshold : 3, block_qubits : 2, "
+        "blocking_threshold : 4}");
+    std::unique_ptr<LightningSimulator> sim = std::make_unique<LightningSimulator>();
+
+    constexpr size_t num_qubits = 5;
+    std::vector<QubitIdType> blocked_qs = blocked->AllocateQubits(num_qubits);
+    std::vector<QubitIdType> qs = sim->AllocateQubits(num_qubits);
+
+    // Segments of gates on the last two wires are interleaved with full passes
+    auto circuit = [](LightningSimulator &dev, const std::vector<QubitIdType> &Qs) {
+        for (size_t idx = 0; idx < num_qubits; idx++) {
+            dev.NamedOperation("Hadamard", {}, {Qs[idx]}, false);
+        }
+        dev.NamedOperation("RX", {0.3}, {Qs[3]}, false);
+        dev.NamedOperation("CNOT", {}, {Qs[4], Qs[3]}, false);
+        dev.NamedOperation("CRY", {0.7}, {Qs[0], Qs[4]}, false);
+        dev.NamedOperation("RZ", {1.1}, {Qs[4]}, true);
+        dev.NamedOperation("IsingXY", {0.2}, {Qs[3], Qs[4]}, false);
+        dev.NamedOperation("T", {}, {Qs[3]}, false);
+        dev.NamedOperation("SWAP", {}, {Qs[1], Qs[4]}, false);
+        dev.NamedOperation("RY", {0.9}, {Qs[4]}, false);
+        dev.NamedOperation("CZ", {}, {Qs[3], Qs[4]}, false);
+    };
+    circuit(*blocked, blocked_qs);
+    circuit(*sim, qs);
+
+    std::vector<std::complex<double>> blocked_state(1U << num_qubits);
+    std::vector<std::complex<double>> state(1U << num_qubits);
+    DataView<std::complex<double>, 1> blocked_view(blocked_state);
+    DataView<std::complex<double>, 1> view(state);
+    blocked->State(blocked_view);
+    sim->State(view);
+    for (size_t idx = 0; idx < state.size(); idx++) {
+        CHECK(blocked_state[idx].real() == Approx(state[idx].real()).margin(1e-9));
+        CHECK(blocked_state[idx].imag() == Approx(state[idx].imag()).margin(1e-9));
+    }
+
+    // Measurements apply the pending gates
+    blocked->NamedOperation("PauliX", {}, {blocked_qs[4]}, false);
+    sim->NamedOperation("PauliX", {}, {qs[4]}, false);
+    ObsIdType blocked_pz = blocked->Observable(ObsId::PauliZ, {}, {blocked_qs[4]});
+    ObsIdType pz = sim->Observable(ObsId::PauliZ, {}, {qs[4]});
+    CHECK(blocked->Expval(blocked_pz) == Approx(sim->Expval(pz)).margin(1e-9));
+
+    // Invalid gates fail when queued, rather than when the queue is applied
+    REQUIRE_THROWS_WITH(blocked->NamedOperation("CNOT", {}, {blocked_qs[4]}, false),
+                        Catch::Contains("Invalid number of qubits"));
+    REQUIRE_THROWS_WITH(blocked->NamedOperation("CZ", {}, {blocked_qs[4], blocked_qs[4]}, false),
+                        Catch::Contains("Invalid given wires"));
+    CHECK(blocked->Expval(blocked_pz) == Approx(sim->Expval(pz)).margin(1e-9));
+
+    REQUIRE_THROWS_WITH(LightningSimulator("{block_qubits : 0}"),
+                        Catch::Contains("Invalid number of block qubits"));
+}
+
+TEST_CASE("Test the exact expectation of diagonal observables", "[Measures]")
+{
+    std::unique_ptr<LightningSimulator> sim = std::make_unique<LightningSimulator>();
+
+    const double theta0 = 0.5;
+    const double theta1 = 0.7;
+    std::vector<QubitIdType> Qs = sim->AllocateQubits(3);
+    sim->NamedOperation("RX", {theta0}, {Qs[0]}, false);
+    sim->NamedOperation("RY", {theta1}, {Qs[1]}, false);
+
+    ObsIdType z0 = sim->Observable(ObsId::PauliZ, {}, {Qs[0]});
+    ObsIdType z1 = sim->Observable(ObsId::PauliZ, {}, {Qs[1]});
+    ObsIdType id2 = sim->Observable(ObsId::Identity, {}, {Qs[2]});
+    ObsIdType z0z1 = sim->TensorObservable({z0, z1});
+    CHECK(sim->Expval(z0) == Approx(std::cos(theta0)).epsilon(1e-6));
+    CHECK(sim->Expval(z0z1) == Approx(std::cos(theta0) * std::cos(theta1)).epsilon(1e-6));
+    CHECK(sim->Var(z0) == Approx(std::pow(std::sin(theta0), 2)).epsilon(1e-6));
+
+    // A cost Hamiltonian of Z-strings, as in QAOA
+    ObsIdType cost = sim->HamiltonianObservable({0.3, -0.2, 1.1}, {z0, z0z1, id2});
+    const double expected =
+        0.3 * std::cos(theta0) - 0.2 * std::cos(theta0) * std::cos(theta1) + 1.1;
+    CHECK(sim->Expval(cost) == Approx(expected).epsilon(1e-6));
+
+    // A diagonal Hermitian matrix, and a Hermitian matrix on the generic path
+    std::vector<std::complex<double>> diag{1, 0, 0, 0, 0, 2, 0, 0, 0, 0, 3, 0, 0, 0, 0, 4};
+    ObsIdType herm = sim->Observable(ObsId::Hermitian, diag, {Qs[1], Qs[0]});
+    const std::array<double, 2> p0{std::pow(std::cos(theta0 / 2), 2),
+                                   std::pow(std::sin(theta0 / 2), 2)};
+    const std::array<double, 2> p1{std::pow(std::cos(theta1 / 2), 2),
+                                   std::pow(std::sin(theta1 / 2), 2)};
+    double herm_expected = 0;
+    for (size_t idx = 0; idx < 4; idx++) {
+        herm_expected += static_cast<double>(idx + 1) * p1[idx >> 1] * p0[idx & 1U];
+    }
+    CHECK(sim->Expval(herm) == Approx(herm_expected).epsilon(1e-6));
+
+    std::vector<std::complex<double>> pauli_x{0, 1, 1, 0};
+    ObsIdType x1 = sim->Observable(ObsId::Hermitian, pauli_x, {Qs[1]});
+    ObsIdType mixed = sim->HamiltonianObservable({1.0, 2.0}, {z0, x1});
+    CHECK(sim->Expval(mixed) == Approx(std::cos(theta0) + 2 * std::sin(theta1)).epsilon(1e-6));
+}
@@ -0,0 +1,206 @@
+// Copyright 2023 Xanadu Quantum Technologies Inc.
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cmath"
+#include "numeric"
+
+#include "MemRefUtils.hpp"
+#include "QuantumDevice.hpp"
+
+#include "LightningTrajectorySimulator.hpp"
+
+#include "TestUtils.hpp"
+
+using namespace Catalyst::Runtime;
+using namespace Catalyst::Runtime::Simulator;
+
+TEST_CASE("Test invalid kwargs of the trajectory simulator", "[Trajectory]")
+{
+    REQUIRE_THROWS_WITH(LightningTrajectorySimulator("{num_trajectories : 0}"),
+                        Catch::Contains("Invalid number of trajectories"));
+    REQUIRE_THROWS_WITH(LightningTrajectorySimulator("{depolarizing : 1.5}"),
+                        Catch::Contains("Invalid probability of a noise channel"));
+    REQUIRE_THROWS_WITH(LightningTrajectorySimulator("{readout_error : -0.1}"),
+                        Catch::Contains("Invalid probability of a noise channel"));
+}
+
+TEST_CASE("Test a noiseless circuit on the trajectory simulator", "[Trajectory]")
+{
+    std::unique_ptr<LightningTrajectorySimulator> sim =
+        std::make_unique<LightningTrajectorySimulator>("{num_trajectories : 8}");
+
+    std::vector<QubitIdType> Qs = sim->AllocateQubits(2);
+    sim->NamedOperation("RX", {0.5}, {Qs[0]}, false);
+    sim->NamedOperation("CNOT", {}, {Qs[0], Qs[1]}, false);
+
+    ObsIdType pz = sim->Observable(ObsId::PauliZ, {}, {Qs[1]});
+    CHECK(sim->Expval(pz) == Approx(std::cos(0.5)).epsilon(1e-6));
+    CHECK(sim->Var(pz) == Approx(1 - std::pow(std::cos(0.5), 2)).epsilon(1e-6));
+
+    std::vector<double> probs(4);
+    DataView<double, 1> view(probs);
+    sim->Probs(view);
+    CHECK(probs[0] == Approx(std::pow(std::cos(0.25), 2)).epsilon(1e-6));
+    CHECK(probs[1] == Approx(0.).margin(1e-6));
+    CHECK(probs[2] == Approx(0.).margin(1e-6));
+    CHECK(probs[3] == Approx(std::pow(std::sin(0.25), 2)).epsilon(1e-6));
+
+    std::vector<std::complex<double>> state(4);
+    DataView<std::complex<double>, 1> state_view(state);
+    REQUIRE_THROWS_WITH(sim->State(state_view), Catch::Contains("Unsupported functionality"));
+}
+
+TEST_CASE("Test the depolarizing channel of the trajectory simulator", "[Trajectory]")
+{
+    constexpr double p = 0.3;
+    std::unique_ptr<LightningTrajectorySimulator> sim =
+        std::make_unique<LightningTrajectorySimulator>(
+            "{num_trajectories : 4000, depolarizing : 0.3}");
+
+    std::vector<QubitIdType> Qs = sim->AllocateQubits(1);
+    sim->NamedOperation("PauliX", {}, {Qs[0]}, false);
+
+    // PauliX and PauliY flip the state back to |0>, PauliZ leaves it unchanged
+    ObsIdType pz = sim->Observable(ObsId::PauliZ, {}, {Qs[0]});
+    CHECK(sim->Expval(pz) == Approx(-(1 - 4 * p / 3)).margin(0.05));
+}
+
+TEST_CASE("Test the amplitude damping channel of the trajectory simulator", "[Trajectory]")
+{
+    std::unique_ptr<LightningTrajectorySimulator> sim =
+        std::make_unique<LightningTrajectorySimulator>(
+            "{num_trajectories : 4000, amplitude_damping : 0.4}");
+
+    std::vector<QubitIdType> Qs = sim->AllocateQubits(1);
+    sim->NamedOperation("PauliX", {}, {Qs[0]}, false);
+
+    std::vector<double> probs(2);
+    DataView<double, 1> view(probs);
+    sim->Probs(view);
+    CHECK(probs[0] == Approx(0.4).margin(0.05));
+    CHECK(probs[1] == Approx(0.6).margin(0.05));
+    CHECK(probs[0] + probs[1] == Approx(1.).epsilon(1e-6));
+}
+
+TEST_CASE("Test the readout error of the trajectory simulator", "[Trajectory]")
+{
+    std::unique_ptr<LightningTrajectorySimulator> sim =
+        std::make_unique<LightningTrajectorySimulator>(
+            "{num_trajectories : 4, readout_error : 0.1}");
+
+    std::vector<QubitIdType> Qs = sim->AllocateQubits(2);
+    sim->NamedOperation("PauliX", {}, {Qs[0]}, false);
+
+    std::vector<double> probs(4);
+    DataView<double, 1> view(probs);
+    sim->Probs(view);
+    CHECK(probs[0] == Approx(0.09).epsilon(1e-6));
+    CHECK(probs[1] == Approx(0.01).epsilon(1e-6));
+    CHECK(probs[2] == Approx(0.81).epsilon(1e-6));
+    CHECK(probs[3] == Approx(0.09).epsilon(1e-6));
+
+    // The readout error does not apply to expectation values
+    ObsIdType pz = sim->Observable(ObsId::PauliZ, {}, {Qs[0]});
+    CHECK(sim->Expval(pz) == Approx(-1.).epsilon(1e-6));
+
+    std::vector<double> partial_probs(2);
+    DataView<double, 1> partial_view(partial_probs);
+    sim->PartialProbs(partial_view, {Qs[1]});
+    CHECK(partial_probs[0] == Approx(0.9).epsilon(1e-6));
+    CHECK(partial_probs[1] == Approx(0.1).epsilon(1e-6));
+}
+
+TEST_CASE("Test counts of the trajectory simulator with a fixed seed", "[Trajectory]")
+{
+    constexpr size_t shots = 1000;
+    std::vector<std::vector<int64_t>> all_counts;
+    for (size_t run = 0; run < 2; run++) {
+        std::unique_ptr<LightningTrajectorySimulator> sim =
+            std::make_unique<LightningTrajectorySimulator>(
+                "{num_trajectories : 100, depolarizing : 0.1, seed : 42}");
+
+        std::vector<QubitIdType> Qs = sim->AllocateQubits(2);
+        sim->NamedOperation("Hadamard", {}, {Qs[0]}, false);
+        sim->NamedOperation("CNOT", {}, {Qs[0], Qs[1]}, false);
+
+        std::vector<double> eigvals(4);
+        std::vector<int64_t> counts(4);
+        DataView<double, 1> eigvals_view(eigvals);
+        DataView<int64_t, 1> counts_view(counts);
+        sim->Counts(eigvals_view, counts_view, shots);
+
+        const int64_t total = std::accumulate(counts.begin(), counts.end(), int64_t{0});
+        CHECK(total == static_cast<int64_t>(shots));
+        all_counts.push_back(counts);
+    }
+    CHECK(all_counts[0] == all_counts[1]);
+}
+
+TEST_CASE("Test mid-circuit measurements on the trajectory simulator", "[Trajectory]")
+{
+    std::unique_ptr<LightningTrajectorySimulator> sim =
+        std::make_unique<LightningTrajectorySimulator>("{num_trajectories : 16}");
+
+    std::vector<QubitIdType> Qs = sim->AllocateQubits(2);
+    sim->NamedOperation("Hadamard", {}, {Qs[0]}, false);
+    sim->NamedOperation("CNOT", {}, {Qs[0], Qs[1]}, false);
+
+    Result mres = sim->Measure(Qs[0]);
+    const double expected = *mres ? -1. : 1.;
+
+    // Both qubits collapse onto the measured outcome
+    ObsIdType pz0 = sim->Observable(ObsId::PauliZ, {}, {Qs[0]});
+    ObsIdType pz1 = sim->Observable(ObsId::PauliZ, {}, {Qs[1]});
+    CHECK(sim->Expval(pz0) == Approx(expected).epsilon(1e-6));
+    CHECK(sim->Expval(pz1) == Approx(expected).epsilon(1e-6));
+}
+
+TEST_CASE("Test kept and simulated-again trajectories give the same results", "[Trajectory]")
+{
+    // Without memory for the states of all trajectories, every measurement process simulates
+    // them again from the same random streams
+    std::vector<std::vector<double>> all_results;
+    for (const std::string kwargs :
+         {"{num_trajectories : 50, depolarizing : 0.2, seed : 7}",
+          "{num_trajectories : 50, depolarizing : 0.2, seed : 7, num_threads : 3}",
+          "{num_trajectories : 50, depolarizing : 0.2, seed : 7, trajectory_memory : 0}"}) {
+        std::unique_ptr<LightningTrajectorySimulator> sim =
+            std::make_unique<LightningTrajectorySimulator>(kwargs);
+
+        std::vector<QubitIdType> Qs = sim->AllocateQubits(2);
+        sim->NamedOperation("Hadamard", {}, {Qs[0]}, false);
+        sim->NamedOperation("CNOT", {}, {Qs[0], Qs[1]}, false);
+        ObsIdType pz0 = sim->Observable(ObsId::PauliZ, {}, {Qs[0]});
+        ObsIdType pz1 = sim->Observable(ObsId::PauliZ, {}, {Qs[1]});
+
+        std::vector<double> results{sim->Expval(pz0), sim->Var(pz1)};
+        Result mres = sim->Measure(Qs[0]);
+        results.push_back(*mres ? 1. : 0.);
+        sim->NamedOperation("RY", {0.3}, {Qs[1]}, false);
+        results.push_back(sim->Expval(pz1));
+
+        std::vector<double> probs(4);
+        DataView<double, 1> view(probs);
+        sim->Probs(view);
+        results.insert(results.end(), probs.begin(), probs.end());
+        all_results.push_back(results);
+    }
+
+    for (size_t run = 1; run < all_results.size(); run++) {
+        REQUIRE(all_results[run].size() == all_results[0].size());
+        for (size_t idx = 0; idx < all_results[0].size(); idx++) {
+            CHECK(all_results[run][idx] == Approx(all_results[0][idx]).margin(1e-12));
+        }
+    }
+}
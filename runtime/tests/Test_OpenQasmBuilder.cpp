@@ -537,3 +537,45 @@ TEMPLATE_TEST_CASE("Test OpenQasmBuilder with custom instructions", "[openqasm]"
               toqasm + state_pragma_str);
     }
 }
+
+TEMPLATE_TEST_CASE("Test OpenQasmBuilder with parametric gates", "[openqasm]", OpenQasmBuilder,
+                   BraketBuilder)
+{
+    auto build = [](double theta, double phi) {
+        auto builder = TestType();
+        builder.setParametric(true);
+        builder.Register(RegisterType::Qubit, "q", 2);
+        builder.Gate("RX", {theta}, {}, {0}, false);
+        builder.Gate("Hadamard", {}, {}, {1}, false);
+        builder.Gate("RZ", {phi}, {}, {1}, false);
+        return builder;
+    };
+
+    auto builder = build(0.12, 0.34);
+    CHECK(builder.isParametric());
+    CHECK(builder.getInputs().at("param_0") == 0.12);
+    CHECK(builder.getInputs().at("param_1") == 0.34);
+
+    std::string toqasm = "OPENQASM 3.0;\n"
+                         "input float param_0;\n"
+                         "input float param_1;\n"
+                         "qubit[2] q;\n";
+    std::string gates = "rx(param_0) q[0];\n"
+                        "h q[1];\n"
+                        "rz(param_1) q[1];\n";
+
+    if (TYPE_INFO(TestType) == TYPE_INFO(OpenQasmBuilder)) {
+        CHECK(builder.toOpenQasm() == toqasm + gates + "reset q;\n");
+    }
+    else if (TYPE_INFO(TestType) == TYPE_INFO(BraketBuilder)) {
+        CHECK(builder.toOpenQasmWithCustomInstructions("") == toqasm + gates);
+
+        // The program does not depend on the parameter values
+        CHECK(build(0.56, 0.78).toOpenQasmWithCustomInstructions("") == toqasm + gates);
+
+        // Gates added after a serialization are appended to the cached program
+        builder.Gate("CNOT", {}, {}, {0, 1}, false);
+        CHECK(builder.toOpenQasmWithCustomInstructions("") ==
+              toqasm + gates + "cnot q[0], q[1];\n");
+    }
+}
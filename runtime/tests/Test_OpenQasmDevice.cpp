@@ -58,6 +58,121 @@ TEST_CASE("Test OpenQasmRunner base class", "[openqasm]")
     REQUIRE_THROWS_WITH(runner.Gradient("", "", 0, 0),
                         Catch::Contains("[Function:Gradient] Error in Catalyst Runtime: "
                                         "Not implemented method"));
+
+    REQUIRE_THROWS_WITH(runner.Results("", "", 0),
+                        Catch::Contains("[Function:Results] Error in Catalyst Runtime: "
+                                        "Not implemented method"));
+}
+
+TEST_CASE("Test MeasurementBatch plans", "[openqasm]")
+{
+    using Batch = OpenQasm::MeasurementBatch;
+    constexpr size_t num_qubits{7};
+    const std::string expval{"expectation z(qubits[5])"};
+    const std::string var{"variance x(qubits[6])"};
+    const std::string samples{Batch::samples_request};
+    const std::string circuit_a{"rx(0.1) qubits[5];\ncnot qubits[5], qubits[6];\n"};
+    const std::string circuit_b{"rx(0.2) qubits[5];\ncnot qubits[5], qubits[6];\n"};
+
+    Batch batch{};
+
+    // The first execution learns the plan, running the measurements one at a time
+    auto &&pending = batch.request(circuit_a, expval, num_qubits, 100);
+    CHECK(pending == std::vector<std::string>{expval});
+    batch.store(pending, {{{0.5}}, {0, 1}});
+
+    CHECK(batch.request(circuit_a, samples, num_qubits, 100).empty());
+    CHECK(batch.getSamples() == std::vector<size_t>{0, 1});
+
+    pending = batch.request(circuit_a, var, num_qubits, 100);
+    CHECK(pending == std::vector<std::string>{var});
+    CHECK(Batch::toPragmas(pending) == "#pragma braket result " + var + "\n");
+    batch.store(pending, {{{0.25}}, {1, 1}});
+
+    // Later executions run all the measurements of the plan at once
+    pending = batch.request(circuit_b, expval, num_qubits, 100);
+    CHECK(pending == std::vector<std::string>{expval, samples, var});
+    batch.store(pending, {{{0.1}, {0.2}}, {1, 0}});
+
+    CHECK(batch.request(circuit_b, samples, num_qubits, 100).empty());
+    CHECK(batch.request(circuit_b, var, num_qubits, 100).empty());
+    CHECK(batch.getValues(expval)[0] == 0.1);
+    CHECK(batch.getValues(var)[0] == 0.2);
+    CHECK(batch.getSamples() == std::vector<size_t>{1, 0});
+
+    // Changing the number of shots starts a new execution
+    pending = batch.request(circuit_b, expval, num_qubits, 0);
+    CHECK(pending == std::vector<std::string>{expval});
+
+    // Plans are not shared between circuits of different structures
+    pending = batch.request("ry(0.2) qubits[5];\n", expval, num_qubits, 100);
+    CHECK(pending == std::vector<std::string>{expval});
+    CHECK(Batch::hashStructure(circuit_a) == Batch::hashStructure(circuit_b));
+}
+
+TEST_CASE("Test MeasurementBatch submissions", "[openqasm]")
+{
+    using Batch = OpenQasm::MeasurementBatch;
+    constexpr size_t num_qubits{9};
+    const std::string expval{"expectation z(qubits[7])"};
+    const std::string var{"variance z(qubits[8])"};
+    const std::string circuit_a{"rz(0.1) qubits[7];\n"};
+    const std::string circuit_b{"rz(0.2) qubits[7];\n"};
+    const std::string circuit_c{"rz(0.3) qubits[7];\n"};
+
+    Batch batch{};
+    std::vector<std::vector<std::string>> runs{};
+    auto submitter = [&runs](const std::vector<std::string> &requests) {
+        return std::async(std::launch::deferred, [&runs, requests]() {
+            runs.push_back(requests);
+            RT_FAIL_IF(requests.size() > 1, "Unsupported combination of result types");
+            return OpenQasm::BatchResults{{{0.5}}, {}};
+        });
+    };
+
+    // Learn the plan of an execution
+    batch.submit(batch.request(circuit_a, expval, num_qubits, 0), submitter);
+    CHECK(batch.getValues(expval)[0] == 0.5);
+    batch.submit(batch.request(circuit_a, var, num_qubits, 0), submitter);
+    CHECK(batch.getValues(var)[0] == 0.5);
+    CHECK(runs.size() == 2);
+
+    // The submitted run is only waited for when its results are consumed
+    auto &&pending = batch.request(circuit_b, expval, num_qubits, 0);
+    CHECK(pending == std::vector<std::string>{expval, var});
+    batch.submit(pending, submitter);
+    CHECK(runs.size() == 2);
+    CHECK(batch.isCached(var));
+
+    // The rejected batch falls back to running the consumed request alone
+    CHECK(batch.getValues(expval)[0] == 0.5);
+    CHECK(runs.size() == 4);
+    CHECK(runs.back() == std::vector<std::string>{expval});
+    CHECK(!batch.isCached(var));
+
+    // and the plan is no longer batched
+    batch.reset();
+    CHECK(batch.request(circuit_c, expval, num_qubits, 0) == std::vector<std::string>{expval});
+}
+
+TEST_CASE("Test NativeRunner::Submit()", "[openqasm]")
+{
+    OpenQasm::NativeRunner runner{};
+
+    std::vector<std::future<OpenQasm::BatchResults>> futures;
+    for (size_t idx = 0; idx < 8; idx++) {
+        OpenQasm::BraketBuilder builder{};
+        builder.Register(OpenQasm::RegisterType::Qubit, "q", 1);
+        builder.Gate("RX", {0.1 * static_cast<double>(idx)}, {}, {0}, false);
+        futures.push_back(runner.Submit(
+            builder.toOpenQasmWithCustomInstructions("#pragma braket result expectation z(q[0])\n"),
+            "", 0));
+    }
+
+    for (size_t idx = 0; idx < 8; idx++) {
+        auto &&results = futures[idx].get();
+        CHECK(results.values[0][0] == Approx(std::cos(0.1 * static_cast<double>(idx))));
+    }
 }
 
 TEST_CASE("Test BraketRunner::runCircuit()", "[openqasm]")
@@ -74,6 +189,147 @@ TEST_CASE("Test BraketRunner::runCircuit()", "[openqasm]")
     OpenQasm::BraketRunner runner{};
     auto &&results = runner.runCircuit(circuit, "default", 100);
     CHECK(results.find("GateModelQuantumTaskResult") != std::string::npos);
+
+    // The local simulator is created once and reused by later runs
+    namespace py = pybind11;
+    py::dict modules = py::module_::import("sys").attr("modules");
+    REQUIRE(modules.contains("_catalyst_braket_session"));
+    py::dict devices = modules["_catalyst_braket_session"].attr("devices");
+    REQUIRE(devices.contains("default"));
+    py::object device = devices["default"];
+
+    auto &&samples = runner.Sample(circuit, "default", 100, 2);
+    CHECK(samples.size() == 200);
+    CHECK(devices["default"].is(device));
+
+    REQUIRE_THROWS_WITH(runner.runCircuit(circuit, "unknown", 100),
+                        Catch::Contains("device must be either"));
+
+    // Jobs submitted before any of them is consumed are sent together
+    auto &&pragma = "#pragma braket result expectation z(q[0]) @ z(q[1])\n";
+    auto &&first = runner.Submit(builder.toOpenQasmWithCustomInstructions(pragma), "default", 0);
+    auto &&second = runner.Submit(builder.toOpenQasmWithCustomInstructions(pragma), "default", 0);
+    CHECK(second.get().values[0][0] == Approx(1.0).margin(1e-5));
+
+    // The local simulations run in the background, behind pending task handles
+    py::dict tasks = modules["_catalyst_braket_session"].attr("tasks");
+    REQUIRE(tasks.size() == 1);
+    for (auto &&item : tasks) {
+        CHECK(item.second.attr("__class__").attr("__name__").cast<std::string>() == "LocalTask");
+    }
+    CHECK(first.get().values[0][0] == Approx(1.0).margin(1e-5));
+    CHECK(py::dict(modules["_catalyst_braket_session"].attr("tasks")).empty());
+
+    auto &&invalid = runner.Submit(circuit, "unknown", 100);
+    REQUIRE_THROWS_WITH(invalid.get(), Catch::Contains("device must be either"));
+}
+
+TEST_CASE("Test BraketRunner::Submit() from concurrent threads", "[openqasm]")
+{
+    OpenQasm::BraketBuilder builder{};
+    builder.Register(OpenQasm::RegisterType::Qubit, "q", 2);
+    builder.Gate("Hadamard", {}, {}, {0}, false);
+    builder.Gate("CNOT", {}, {}, {0, 1}, false);
+    auto &&circuit = builder.toOpenQasmWithCustomInstructions(
+        "#pragma braket result expectation z(q[0]) @ z(q[1])\n");
+
+    OpenQasm::BraketRunner runner{};
+    std::vector<double> values(4);
+    std::vector<std::thread> threads;
+    for (size_t idx = 0; idx < values.size(); idx++) {
+        threads.emplace_back([&, idx]() {
+            values[idx] = runner.Submit(circuit, "default", 0).get().values[0][0];
+        });
+    }
+    {
+        // The consumers wait for the GIL held by the thread embedding the interpreter
+        pybind11::gil_scoped_release release;
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+
+    for (double value : values) {
+        CHECK(value == Approx(1.0).margin(1e-5));
+    }
+}
+
+TEST_CASE("Test NativeRunner", "[openqasm]")
+{
+    OpenQasm::BraketBuilder builder{};
+
+    builder.Register(OpenQasm::RegisterType::Qubit, "q", 3);
+
+    builder.Gate("Hadamard", {}, {}, {0}, false);
+    builder.Gate("CNOT", {}, {}, {0, 1}, false);
+    builder.Gate("RY", {}, {"theta"}, {2}, false);
+
+    const std::unordered_map<std::string, double> inputs{{"theta", 0.4}};
+    OpenQasm::NativeRunner runner{};
+
+    SECTION("Results")
+    {
+        auto &&circuit = builder.toOpenQasmWithCustomInstructions(
+            "#pragma braket result expectation z(q[0]) @ z(q[1])\n"
+            "#pragma braket result variance x(q[2])\n"
+            "#pragma braket result probability q[1], q[2]\n"
+            "#pragma braket result expectation hermitian([[1+0im, 0], [0, 1+0im]]) q[0]\n");
+        auto &&results = runner.Results(circuit, "", 100, "", inputs);
+
+        REQUIRE(results.values.size() == 4);
+        CHECK(results.values[0][0] == Approx(1.0).margin(1e-8));
+        CHECK(results.values[1][0] == Approx(1 - std::pow(std::sin(0.4), 2)).margin(1e-8));
+        REQUIRE(results.values[2].size() == 4);
+        CHECK(results.values[2][0] == Approx(0.5 * std::pow(std::cos(0.2), 2)).margin(1e-8));
+        CHECK(results.values[2][3] == Approx(0.5 * std::pow(std::sin(0.2), 2)).margin(1e-8));
+        CHECK(results.values[3][0] == Approx(1.0).margin(1e-8));
+
+        REQUIRE(results.samples.size() == 300);
+        for (size_t shot = 0; shot < 100; shot++) {
+            CHECK(results.samples[shot * 3] == results.samples[shot * 3 + 1]);
+        }
+    }
+
+    SECTION("Probs and State")
+    {
+        builder.Gate(std::vector<std::complex<double>>{{0, 0}, {1, 0}, {1, 0}, {0, 0}}, {2},
+                     false);
+        auto &&circuit = builder.toOpenQasmWithCustomInstructions("");
+
+        REQUIRE_THROWS_WITH(runner.Probs(circuit, "", 0, 3),
+                            Catch::Contains("Missing value of the OpenQasm input variable"));
+
+        OpenQasm::BraketBuilder fixed{};
+        fixed.Register(OpenQasm::RegisterType::Qubit, "q", 2);
+        fixed.Gate("PauliX", {}, {}, {1}, false);
+        fixed.Gate("SWAP", {}, {}, {0, 1}, false);
+        fixed.Gate(std::vector<std::complex<double>>{{0, 0}, {0, -1}, {0, 1}, {0, 0}}, {1}, false);
+        auto &&fixed_circuit = fixed.toOpenQasmWithCustomInstructions("");
+
+        auto &&probs = runner.Probs(fixed_circuit, "", 0, 2);
+        CHECK(probs == std::vector<double>{0, 0, 0, 1});
+        CHECK(runner.Probs(fixed_circuit, "", 100, 2) == std::vector<double>{0, 0, 0, 1});
+
+        auto &&state = runner.State(fixed_circuit, "", 0, 2);
+        CHECK(state[3].real() == Approx(0).margin(1e-8));
+        CHECK(state[3].imag() == Approx(1).margin(1e-8));
+
+        CHECK(runner.Sample(fixed_circuit, "", 10, 2) == std::vector<size_t>(20, 1));
+        CHECK(runner.runCircuit(fixed_circuit, "", 10).find("shots: 10") != std::string::npos);
+    }
+
+    SECTION("Invalid programs")
+    {
+        REQUIRE_THROWS_WITH(runner.Expval("OPENQASM 3.0;\nqubit[1] q;\nfoo q[0];\n", "", 0),
+                            Catch::Contains("Unsupported gate"));
+        REQUIRE_THROWS_WITH(
+            runner.Expval("OPENQASM 3.0;\nqubit[1] q;\nmeasure q[0];\nx q[0];\n", "", 0),
+            Catch::Contains("Gate after measure or reset"));
+        REQUIRE_THROWS_WITH(runner.Expval("OPENQASM 3.0;\nqubit[1] q;\nx p[0];\n", "", 0),
+                            Catch::Contains("Unknown quantum register"));
+        REQUIRE_THROWS_WITH(runner.Expval("OPENQASM 3.0;\nqubit[1] q;\nx q[1];\n", "", 0),
+                            Catch::Contains("Qubit out of range"));
+    }
 }
 
 TEST_CASE("Test the OpenQasmDevice constructor", "[openqasm]")
@@ -98,6 +354,16 @@ TEST_CASE("Test the OpenQasmDevice constructor", "[openqasm]")
                             Catch::Contains("[Function:toOpenQasm] Error in Catalyst Runtime: "
                                             "Invalid number of quantum register"));
     }
+
+    SECTION("Native")
+    {
+        auto device = OpenQasmDevice("{shots: 100, device_type : openqasm.local.qubit}");
+        CHECK(device.GetNumQubits() == 0);
+
+        REQUIRE_THROWS_WITH(device.Circuit(),
+                            Catch::Contains("[Function:toOpenQasm] Error in Catalyst Runtime: "
+                                            "Invalid number of quantum register"));
+    }
 }
 
 TEST_CASE("Test qubits allocation OpenQasmDevice", "[openqasm]")
@@ -272,6 +538,30 @@ TEST_CASE("Test measurement processes, the bell pair circuit with BuilderType::B
         auto expval = device->Var(obs);
         CHECK(expval == Approx(0.5).margin(1e-5));
     }
+
+    SECTION("Batched measurements of repeated executions")
+    {
+        device->SetDeviceShots(0); // to get deterministic results
+        for (size_t execution = 0; execution < 2; execution++) {
+            if (execution) {
+                device->ReleaseAllQubits();
+                wires = device->AllocateQubits(n);
+                device->NamedOperation("Hadamard", {}, {wires[0]}, false);
+                device->NamedOperation("CNOT", {}, {wires[0], wires[1]}, false);
+            }
+
+            auto obs_z = device->Observable(ObsId::PauliZ, {}, std::vector<QubitIdType>{0});
+            auto obs_h = device->Observable(ObsId::Hadamard, {}, std::vector<QubitIdType>{1});
+            CHECK(device->Expval(obs_z) == Approx(0.0).margin(1e-5));
+            CHECK(device->Var(obs_h) == Approx(1.0).margin(1e-5));
+
+            std::vector<double> probs(size);
+            DataView<double, 1> view(probs);
+            device->Probs(view);
+            CHECK(probs[0] == Approx(0.5).margin(1e-5));
+            CHECK(probs[3] == Approx(0.5).margin(1e-5));
+        }
+    }
 }
 
 TEST_CASE("Test measurement processes, a simple circuit with BuilderType::Braket", "[openqasm]")
@@ -452,6 +742,33 @@ TEST_CASE("Test measurement processes, a simple circuit with BuilderType::Braket
     }
 }
 
+TEST_CASE("Test parametric programs with BuilderType::Braket", "[openqasm]")
+{
+    std::unique_ptr<OpenQasmDevice> device = std::make_unique<OpenQasmDevice>(
+        "{device_type : braket.local.qubit, backend : default, shots : 0, parametric : True}");
+
+    std::string circuit{};
+    for (double theta : {0.3, 1.2}) {
+        auto wires = device->AllocateQubits(2);
+        device->NamedOperation("RX", {theta}, {wires[0]}, false);
+        device->NamedOperation("CNOT", {}, {wires[0], wires[1]}, false);
+
+        std::string toqasm = "OPENQASM 3.0;\n"
+                             "input float param_0;\n"
+                             "qubit[2] qubits;\n"
+                             "bit[2] bits;\n"
+                             "rx(param_0) qubits[0];\n"
+                             "cnot qubits[0], qubits[1];\n"
+                             "bits = measure qubits;\n";
+        CHECK(device->Circuit() == toqasm);
+
+        auto obs = device->Observable(ObsId::PauliZ, {}, std::vector<QubitIdType>{wires[1]});
+        CHECK(device->Expval(obs) == Approx(std::cos(theta)).margin(1e-5));
+
+        device->ReleaseAllQubits();
+    }
+}
+
 TEST_CASE("Test MatrixOperation with BuilderType::Braket", "[openqasm]")
 {
     std::unique_ptr<OpenQasmDevice> device = std::make_unique<OpenQasmDevice>(
@@ -498,6 +815,83 @@ TEST_CASE("Test MatrixOperation with BuilderType::Braket", "[openqasm]")
     }
 }
 
+TEST_CASE("Test measurement processes with BuilderType::Native", "[openqasm]")
+{
+    constexpr size_t shots{1000};
+    std::unique_ptr<OpenQasmDevice> device =
+        std::make_unique<OpenQasmDevice>("{device_type : openqasm.local.qubit, shots : 1000}");
+
+    constexpr size_t n{3};
+    constexpr size_t size{1UL << n};
+    auto wires = device->AllocateQubits(n);
+
+    device->NamedOperation("Hadamard", {}, {wires[0]}, false);
+    device->NamedOperation("CNOT", {}, {wires[0], wires[1]}, false);
+    device->NamedOperation("RX", {0.6}, {wires[2]}, false);
+    device->MatrixOperation({{0, 0}, {1, 0}, {1, 0}, {0, 0}}, {wires[1]}, false);
+
+    SECTION("Probs")
+    {
+        std::vector<double> probs(size);
+        DataView<double, 1> view(probs);
+        device->Probs(view);
+
+        CHECK(probs[2] == Approx(0.5 * std::pow(std::cos(0.3), 2)).margin(1e-8));
+        CHECK(probs[4] == Approx(0.5 * std::pow(std::cos(0.3), 2)).margin(1e-8));
+        CHECK(probs[3] == Approx(0.5 * std::pow(std::sin(0.3), 2)).margin(1e-8));
+        CHECK(probs[0] + probs[1] + probs[6] + probs[7] == Approx(0).margin(1e-8));
+    }
+
+    SECTION("Expval and Var")
+    {
+        auto z0 = device->Observable(ObsId::PauliZ, {}, std::vector<QubitIdType>{wires[0]});
+        auto z1 = device->Observable(ObsId::PauliZ, {}, std::vector<QubitIdType>{wires[1]});
+        auto z2 = device->Observable(ObsId::PauliZ, {}, std::vector<QubitIdType>{wires[2]});
+        auto tp = device->TensorObservable({z0, z1});
+
+        CHECK(device->Expval(tp) == Approx(-1).margin(1e-8));
+        CHECK(device->Expval(z2) == Approx(std::cos(0.6)).margin(1e-8));
+        CHECK(device->Var(z2) == Approx(1 - std::pow(std::cos(0.6), 2)).margin(1e-8));
+    }
+
+    SECTION("State")
+    {
+        std::vector<std::complex<double>> state(size);
+        DataView<std::complex<double>, 1> view(state);
+        device->State(view);
+
+        CHECK(std::abs(state[2]) == Approx(std::cos(0.3) / std::sqrt(2)).margin(1e-8));
+        CHECK(std::abs(state[5]) == Approx(std::sin(0.3) / std::sqrt(2)).margin(1e-8));
+    }
+
+    SECTION("Counts")
+    {
+        std::vector<double> eigvals(size);
+        std::vector<int64_t> counts(size);
+        DataView<double, 1> eview(eigvals);
+        DataView<int64_t, 1> cview(counts);
+        device->Counts(eview, cview, shots);
+
+        size_t sum = 0;
+        for (size_t i = 0; i < size; i++) {
+            sum += counts[i];
+        }
+        CHECK(sum == shots);
+    }
+
+    SECTION("PartialSamples")
+    {
+        std::vector<double> samples(shots * 2);
+        MemRefT<double, 2> buffer{samples.data(), samples.data(), 0, {shots, 2}, {1, 1}};
+        DataView<double, 2> view(buffer.data_aligned, buffer.offset, buffer.sizes, buffer.strides);
+        device->PartialSample(view, std::vector<QubitIdType>{wires[0], wires[1]}, shots);
+
+        for (size_t shot = 0; shot < shots; shot++) {
+            CHECK(samples[shot * 2] != samples[shot * 2 + 1]);
+        }
+    }
+}
+
 TEST_CASE("Test MatrixOperation with OpenQasmDevice and BuilderType::Common", "[openqasm]")
 {
     auto device = OpenQasmDevice("{shots : 100}");